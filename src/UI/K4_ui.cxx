@@ -41,6 +41,8 @@
 
 #include "rigs.h"
 #include "K4_ui.h"
+#include "ui_refresh.h"
+#include "band_sweep.h"
 
 extern std::queue<XCVR_STATE> queA;
 extern std::queue<XCVR_STATE> queB;
@@ -48,16 +50,18 @@ extern std::queue<XCVR_STATE> queB;
 void read_K4_vfo()
 {
 	unsigned long long freq;
+	if (sweep_running())	// the vfo holds a sweep point, not the operating frequency
+		return;
 	freq = selrig->get_vfoA();
 	if (freq != vfoA.freq) {
 		vfoA.freq = freq;
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 		vfo = &vfoA;
 	}
 	freq = selrig->get_vfoB();
 	if (freq != vfoB.freq) {
 		vfoB.freq = freq;
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 	}
 }
 
@@ -40,6 +40,8 @@
 #include "fskioUI.h"
 
 #include "fileselect.h"
+#include "cat_stats.h"
+#include "meter_history.h"
 
 Fl_Light_Button *btnPOWER = (Fl_Light_Button *)0;
 
@@ -558,6 +560,14 @@ static void cb_Events(Fl_Menu_*, void*) {
 	cbEventLog();
 }
 
+static void cb_Stats(Fl_Menu_*, void*) {
+	open_stats_window();
+}
+
+static void cb_Meters(Fl_Menu_*, void*) {
+	open_meter_window();
+}
+
 static void cb_Polling(Fl_Menu_*, void*) {
 	open_poll_tab();
 }
@@ -26,6 +26,7 @@ Fl_Button *btnDelFreq=(Fl_Button *)0;
 Fl_Button *btnClearList=(Fl_Button *)0;
 Fl_Browser2 *FreqSelect=(Fl_Browser2 *)0;
 Fl_Input *inAlphaTag=(Fl_Input *)0;
+Fl_Input *inMemFilter=(Fl_Input *)0;
 
 static void cb_btnAddFreq(Fl_Button*, void*) {
 	addFreq();
@@ -56,6 +57,10 @@ static void cb_inAlphaTag(Fl_Input*, void*) {
 	editAlphaTag();
 }
 
+static void cb_inMemFilter(Fl_Input*, void*) {
+	memory_filter();
+}
+
 static Font_Browser  *fntSelectbrowser = 0;
 static Fl_Browser *header = 0;
 static int freq_sel_widths[] = {140, 15, 70, 15, 80, 15, 0};
@@ -226,7 +231,7 @@ Right click:    select"));
 
 	Fl_Group* mm_grp2 = new Fl_Group(0, 155, 600, 26);
 
-		inAlphaTag = new Fl_Input(66, 156, 532, 24, _("Tag:"));
+		inAlphaTag = new Fl_Input(66, 156, 352, 24, _("Tag:"));
 		inAlphaTag->tooltip(
 _("Left click => in Tag field to edit\n[Enter] => when done to update"));
 		inAlphaTag->callback((Fl_Callback*)cb_inAlphaTag);
@@ -234,6 +239,17 @@ _("Left click => in Tag field to edit\n[Enter] => when done to update"));
 		inAlphaTag->textfont(4);
 		inAlphaTag->textsize(14);
 
+		inMemFilter = new Fl_Input(458, 156, 140, 24, _("Find:"));
+		inMemFilter->tooltip(
+_("Show only memories\n\
+  20m, 70cm => in an amateur band\n\
+  7000-7050 => between two frequencies in kHz\n\
+  text      => with text in the tag"));
+		inMemFilter->callback((Fl_Callback*)cb_inMemFilter);
+		inMemFilter->when(FL_WHEN_CHANGED);
+		inMemFilter->textfont(4);
+		inMemFilter->textsize(14);
+
 	mm_grp2->end();
 	mm_grp2->resizable(inAlphaTag);
 
@@ -70,6 +70,8 @@ Fl_Menu_Item menu_small_menu[] = {
  {_("On Line Help"), 0,  (Fl_Callback*)cb_mnuOnLineHelp, 0, 0, FL_NORMAL_LABEL, 0, 14, 0},
  {_("&About"), 0,  (Fl_Callback*)cb_mnuAbout, 0, 128, FL_NORMAL_LABEL, 0, 14, 0},
  {_("&Events"), 0,  (Fl_Callback*)cb_Events, 0, 0, FL_NORMAL_LABEL, 0, 14, 0},
+ {_("&Statistics"), 0,  (Fl_Callback*)cb_Stats, 0, 0, FL_NORMAL_LABEL, 0, 14, 0},
+ {_("&Meter history"), 0,  (Fl_Callback*)cb_Meters, 0, 0, FL_NORMAL_LABEL, 0, 14, 0},
  {_("&xml-help"), 0,  (Fl_Callback*)cb_xml_help, 0, 0, FL_NORMAL_LABEL, 0, 14, 0},
  {0,0,0,0,0,0,0,0,0},
  {0,0,0,0,0,0,0,0,0}
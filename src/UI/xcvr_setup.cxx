@@ -30,6 +30,7 @@
 
 #include "xmlrpc_rig.h"
 #include "XmlRpc.h"
+#include "cat_capture.h"
 
 Fl_Group *tabXCVR = (Fl_Group *)0;
 	Fl_ComboBox *selectRig = (Fl_ComboBox *)0;
@@ -137,6 +138,8 @@ Fl_Group *tabPOLLING = (Fl_Group *)0;
 	Fl_Check_Button *poll_meters = (Fl_Check_Button *)0;
 	Fl_Check_Button *poll_ops = (Fl_Check_Button *)0;
 	Fl_Check_Button *poll_all = (Fl_Check_Button *)0;
+	Fl_Check_Button *poll_backoff = (Fl_Check_Button *)0;
+	Fl_Check_Button *poll_push = (Fl_Check_Button *)0;
 
 	Fl_Check_Button *disable_polling = (Fl_Check_Button *)0;
 	Fl_Check_Button *disable_xmlrpc = (Fl_Check_Button *)0;
@@ -167,6 +170,7 @@ Fl_Group *tabTRACE = (Fl_Group *)0;
 	Fl_Check_Button *btn_rpctrace = (Fl_Check_Button *)0;
 	Fl_Check_Button *btn_serialtrace = (Fl_Check_Button *)0;
 	Fl_Check_Button *btn_start_stop_trace = (Fl_Check_Button *)0;
+	Fl_Check_Button *btn_cat_capture = (Fl_Check_Button *)0;
 	Fl_ComboBox *selectlevel = (Fl_ComboBox *)0;
 	Fl_Button *btn_viewtrace = (Fl_Button *)0;
 
@@ -368,6 +372,17 @@ static void cb_btn_start_stop_trace(Fl_Check_Button *, void *) {
 	progStatus.start_stop_trace = btn_start_stop_trace->value();
 }
 
+static void cb_btn_cat_capture(Fl_Check_Button *, void *) {
+	progStatus.cat_capture = btn_cat_capture->value();
+	if (progStatus.cat_capture) {
+		if (!cat_capture_start()) {
+			progStatus.cat_capture = false;
+			btn_cat_capture->value(0);
+		}
+	} else
+		cat_capture_stop();
+}
+
 static void cb_selectlevel(Fl_ComboBox *, void *) {
 	progStatus.rpc_level = selectlevel->index();
 	XmlRpc::setVerbosity(progStatus.rpc_level);
@@ -787,6 +802,14 @@ static void cb_poll_all(Fl_Check_Button* o, void*) {
 	progStatus.poll_all = o->value();
 }
 
+static void cb_poll_backoff(Fl_Check_Button* o, void*) {
+	progStatus.poll_backoff = o->value();
+}
+
+static void cb_poll_push(Fl_Check_Button* o, void*) {
+	progStatus.poll_push = o->value();
+}
+
 static void cb_btnSetAdd(Fl_Button*, void*) {
 	poll_volume->value(progStatus.poll_all);
 	poll_micgain->value(progStatus.poll_all);
@@ -1428,6 +1451,11 @@ Fl_Group *createTRACE(int X, int Y, int W, int H, const char *label)
 	btn_start_stop_trace->callback((Fl_Callback*)cb_btn_start_stop_trace);
 	btn_start_stop_trace->tooltip(_("Enable trace of start/stop operations"));
 
+	btn_cat_capture = new Fl_Check_Button(X + 10, Y + 170, 80, 20, _("Capture CAT traffic"));
+	btn_cat_capture->value(progStatus.cat_capture);
+	btn_cat_capture->callback((Fl_Callback*)cb_btn_cat_capture);
+	btn_cat_capture->tooltip(_("Record transceiver i/o to cat_capture.bin\nDecode or replay with flrig-capture"));
+
 	selectlevel = new Fl_ComboBox(X + 240, Y + 140, 80, 20, _("XmlRpc trace level"));
 	selectlevel->add("0|1|2|3|4");
 	selectlevel->align(FL_ALIGN_RIGHT);
@@ -1877,6 +1905,12 @@ Fl_Group *createPOLLING(int X, int Y, int W, int H, const char *label)
 		poll_bandwidth->align(Fl_Align(FL_ALIGN_RIGHT));
 		poll_bandwidth->value(progStatus.poll_bandwidth);
 
+		poll_push = new Fl_Check_Button(X + 280, Y + 70, 30, 20, _("Auto info"));
+		poll_push->tooltip(_("Use xcvr auto information / CI-V transceive reports\nFreq and Mode are then polled at a slow rate"));
+		poll_push->callback((Fl_Callback*)cb_poll_push);
+		poll_push->align(Fl_Align(FL_ALIGN_RIGHT));
+		poll_push->value(progStatus.poll_push);
+
 		btnSetOps = new Fl_Button(X + 370, Y + 70, 60, 20, _("Set all"));
 		btnSetOps->tooltip("Poll all operating values");
 		btnSetOps->callback((Fl_Callback*)cb_btnSetOps);
@@ -1948,6 +1982,12 @@ Fl_Group *createPOLLING(int X, int Y, int W, int H, const char *label)
 		poll_tuner->align(Fl_Align(FL_ALIGN_RIGHT));
 		poll_tuner->value(progStatus.poll_tuner);
 
+		poll_backoff = new Fl_Check_Button(X + 370, Y + 140, 30, 20, _("Backoff"));
+		poll_backoff->tooltip(_("Poll controls that have not changed progressively less often"));
+		poll_backoff->callback((Fl_Callback*)cb_poll_backoff);
+		poll_backoff->align(Fl_Align(FL_ALIGN_RIGHT));
+		poll_backoff->value(progStatus.poll_backoff);
+
 		poll_pre_att = new Fl_Check_Button(X + 10, Y + 165, 30, 20, _("Pre/Att"));
 		poll_pre_att->tooltip(_("Preamp / Attenuator"));
 		poll_pre_att->callback((Fl_Callback*)cb_poll_pre_att);
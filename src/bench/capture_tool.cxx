@@ -0,0 +1,368 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// flrig-capture, decode and replay CAT captures
+//
+//   flrig-capture dump FILE [-port NAME]
+//   flrig-capture replay FILE DEVICE [-radio] [-port NAME] [-speed X] [-baud N]
+//
+// dump lists every record with its time relative to the first one.
+//
+// replay plays one port of a capture (cat by default) to a serial
+// device or pty.  By default it takes the part of flrig and writes the
+// recorded commands with their original spacing, printing whatever
+// comes back.  With -radio it takes the part of the transceiver: each
+// recorded reply is sent once the commands preceding it have been
+// received, after the recorded turnaround delay.  -speed scales time,
+// 2 replays twice as fast.
+//----------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <sys/time.h>
+#ifndef __WIN32__
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <poll.h>
+#  include <termios.h>
+#endif
+
+#include "cat_capture.h"
+
+static const char *port_names[] = { "cat", "aux", "sep", "remote", "tci", "other" };
+static const int nports = sizeof(port_names) / sizeof(*port_names);
+
+static const char *port_name(int port)
+{
+	return (port >= 0 && port < nports) ? port_names[port] : "?";
+}
+
+static int port_number(const char *name)
+{
+	for (int n = 0; n < nports; n++)
+		if (strcmp(name, port_names[n]) == 0) return n;
+	fprintf(stderr, "unknown port %s\n", name);
+	exit(1);
+}
+
+struct RECORD {
+	uint64_t usec;
+	int dir;
+	int port;
+	std::string data;
+};
+
+static bool load(const char *fname, std::vector<RECORD> &records, uint64_t &start)
+{
+	FILE *f = fopen(fname, "rb");
+	if (!f) {
+		fprintf(stderr, "%s: %s\n", fname, strerror(errno));
+		return false;
+	}
+	std::vector<char> file;
+	char buf[65536];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+		file.insert(file.end(), buf, buf + n);
+	fclose(f);
+
+	CAP_FILE_HEADER h;
+	if (file.size() < sizeof(h)) {
+		fprintf(stderr, "%s: not a capture file\n", fname);
+		return false;
+	}
+	memcpy(&h, &file[0], sizeof(h));
+	if (memcmp(h.magic, CAP_MAGIC, sizeof(h.magic)) != 0 ||
+		h.version != CAP_VERSION ||
+		h.data_size == 0 ||
+		file.size() < h.header_size + h.data_size) {
+		fprintf(stderr, "%s: not a capture file, or truncated\n", fname);
+		return false;
+	}
+	const char *data = &file[h.header_size];
+	start = h.start_usec;
+
+	uint64_t pos = h.tail;
+	while (pos < h.head) {
+		uint64_t off = cap_offset(pos, h.data_size);
+		if (pos >= h.head) break;
+		CAP_RECORD r;
+		memcpy(&r, data + off, sizeof(r));
+		if (r.size < sizeof(r) || r.size > h.data_size - off ||
+			r.nbytes > r.size - sizeof(r)) {
+			fprintf(stderr, "%s: bad record at %llu\n", fname, (unsigned long long)pos);
+			break;
+		}
+		if (r.dir != CAP_PAD) {
+			RECORD rec;
+			rec.usec = r.usec;
+			rec.dir = r.dir;
+			rec.port = r.port;
+			rec.data.assign(data + off + sizeof(r), r.nbytes);
+			records.push_back(rec);
+		}
+		pos += r.size;
+	}
+	return true;
+}
+
+static std::string printable(const std::string &s)
+{
+	bool hex = false;
+	for (size_t n = 0; n < s.length(); n++)
+		if (!isprint(s[n] & 0xFF) && s[n] != '\r' && s[n] != '\n') hex = true;
+
+	std::string out;
+	char sz[8];
+	for (size_t n = 0; n < s.length(); n++) {
+		if (hex) {
+			snprintf(sz, sizeof(sz), "%s%02X", n ? " " : "", s[n] & 0xFF);
+			out.append(sz);
+		} else if (s[n] == '\r')
+			out.append("<cr>");
+		else if (s[n] == '\n')
+			out.append("<lf>");
+		else
+			out += s[n];
+	}
+	return out;
+}
+
+static int dump(const char *fname, int port)
+{
+	std::vector<RECORD> records;
+	uint64_t start;
+	if (!load(fname, records, start)) return 1;
+
+	time_t t = start / 1000000;
+	printf("capture started %s", ctime(&t));
+	printf("%lu records\n", (unsigned long)records.size());
+	if (records.empty()) return 0;
+
+// times are relative to the first record shown, and to the previous one
+	bool shown = false;
+	uint64_t first = 0;
+	uint64_t last = 0;
+	for (size_t n = 0; n < records.size(); n++) {
+		RECORD &r = records[n];
+		if (port >= 0 && r.port != port) continue;
+		if (!shown) {
+			first = last = r.usec;
+			shown = true;
+		}
+		printf("%12.3f %+9.3f  %-6s %s (%3lu) %s\n",
+			(r.usec - first) / 1000.0,
+			((double)r.usec - (double)last) / 1000.0,
+			port_name(r.port),
+			r.dir == CAP_TX ? "TX" : "RX",
+			(unsigned long)r.data.length(),
+			printable(r.data).c_str());
+		last = r.usec;
+	}
+	return 0;
+}
+
+#ifndef __WIN32__
+
+static uint64_t usec_now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static speed_t baud_constant(int baud)
+{
+	switch (baud) {
+		case 1200: return B1200;
+		case 2400: return B2400;
+		case 4800: return B4800;
+		case 9600: return B9600;
+		case 19200: return B19200;
+		case 38400: return B38400;
+		case 57600: return B57600;
+		case 115200: return B115200;
+	}
+	fprintf(stderr, "unsupported baud rate %d\n", baud);
+	exit(1);
+}
+
+static int open_device(const char *device, int baud)
+{
+	int fd = open(device, O_RDWR | O_NOCTTY);
+	if (fd < 0) {
+		fprintf(stderr, "%s: %s\n", device, strerror(errno));
+		return -1;
+	}
+	struct termios tio;
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		if (baud) {
+			cfsetispeed(&tio, baud_constant(baud));
+			cfsetospeed(&tio, baud_constant(baud));
+		}
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	return fd;
+}
+
+// read and print whatever arrives until 'deadline', or until 'want'
+// bytes have arrived if that is not zero; returns bytes read
+static size_t receive(int fd, uint64_t deadline, size_t want = 0)
+{
+	size_t total = 0;
+	std::string got;
+	char buf[1024];
+	for (;;) {
+		uint64_t now = usec_now();
+		int wait = now < deadline ? (int)((deadline - now + 999) / 1000) : 0;
+		struct pollfd pfd = { fd, POLLIN, 0 };
+		if (poll(&pfd, 1, wait) <= 0) break;
+		ssize_t n = read(fd, buf, sizeof(buf));
+		if (n <= 0) break;
+		got.append(buf, n);
+		total += n;
+		if (want && total >= want) break;
+	}
+	if (total)
+		printf("   recv (%3lu) %s\n", (unsigned long)got.length(), printable(got).c_str());
+	return total;
+}
+
+static int replay(const char *fname, const char *device, int port, bool radio, double speed, int baud)
+{
+	std::vector<RECORD> records;
+	uint64_t start;
+	if (!load(fname, records, start)) return 1;
+
+	int fd = open_device(device, baud);
+	if (fd < 0) return 1;
+
+	int send_dir = radio ? CAP_RX : CAP_TX;
+	uint64_t t0 = usec_now();
+	uint64_t first = 0;
+	uint64_t last_peer = 0;		// time of the last record from the other side
+	size_t expected = 0;		// bytes the other side sent so far
+	size_t received = 0;
+	bool started = false;
+
+	for (size_t n = 0; n < records.size(); n++) {
+		RECORD &r = records[n];
+		if (r.port != port) continue;
+		if (!started) {
+			first = r.usec;
+			last_peer = r.usec;
+			started = true;
+		}
+		if (r.dir != send_dir) {
+			expected += r.data.length();
+			last_peer = r.usec;
+			continue;
+		}
+		if (radio) {
+// wait for the commands this reply answers, then the turnaround
+			if (received < expected)
+				received += receive(fd, usec_now() + 2000000, expected - received);
+			if (received < expected) {
+				printf("   timeout, %lu bytes short\n", (unsigned long)(expected - received));
+				received = expected;
+			}
+			uint64_t delay = (uint64_t)((r.usec - last_peer) / speed);
+			received += receive(fd, usec_now() + delay);
+		} else
+			receive(fd, t0 + (uint64_t)((r.usec - first) / speed));
+
+		printf("%12.3f  send (%3lu) %s\n",
+			(usec_now() - t0) / 1000.0,
+			(unsigned long)r.data.length(),
+			printable(r.data).c_str());
+		if (write(fd, r.data.data(), r.data.length()) < 0) {
+			fprintf(stderr, "%s: %s\n", device, strerror(errno));
+			break;
+		}
+	}
+	if (!radio) receive(fd, usec_now() + 1000000);
+	close(fd);
+	return 0;
+}
+
+#endif
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: flrig-capture dump FILE [-port NAME]\n"
+		"       flrig-capture replay FILE DEVICE [-radio] [-port NAME] [-speed X] [-baud N]\n"
+		"ports: cat aux sep remote tci other\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3) usage();
+
+	std::string cmd = argv[1];
+	const char *fname = argv[2];
+	const char *device = 0;
+	int port = -1;
+	bool radio = false;
+	double speed = 1.0;
+	int baud = 0;
+
+	int arg = 3;
+	if (cmd == "replay") {
+		if (argc < 4) usage();
+		device = argv[arg++];
+	}
+	for (; arg < argc; arg++) {
+		std::string opt = argv[arg];
+		if (opt == "-radio")
+			radio = true;
+		else if (opt == "-port" && arg + 1 < argc)
+			port = port_number(argv[++arg]);
+		else if (opt == "-speed" && arg + 1 < argc)
+			speed = atof(argv[++arg]);
+		else if (opt == "-baud" && arg + 1 < argc)
+			baud = atoi(argv[++arg]);
+		else
+			usage();
+	}
+	if (speed <= 0) speed = 1.0;
+
+	if (cmd == "dump")
+		return dump(fname, port);
+	if (cmd == "replay") {
+#ifndef __WIN32__
+		return replay(fname, device, port < 0 ? CAP_CAT : port, radio, speed, baud);
+#else
+		fprintf(stderr, "replay is not available on this platform\n");
+		return 1;
+#endif
+	}
+	usage();
+	return 1;
+}
@@ -0,0 +1,482 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// flrig-bench, CAT throughput and latency of the rig drivers
+//
+//   make flrig-bench
+//   ./flrig-bench [--bench-rig NAME ...] [--bench-all] [--bench-count N]
+//                 [--bench-time SEC] [--bench-baud N] [--bench-turnaround MSEC]
+//                 [--bench-jitter MSEC] [--bench-loop MSEC]
+//                 [--bench-write-delay MSEC] [--bench-post-delay MSEC]
+//
+// flrig-bench is flrig built with FLRIG_BENCH.  main() loads the settings
+// and hands over to flrig_bench() before any window is built, so no
+// display is needed.  Each selected transceiver is connected to a
+// RADIO_SIM on a pty and its driver initialized; then every entry of
+// RX_poll_pairs and TX_poll_pairs is timed in isolation, followed by the
+// RX and TX schedulers running whole poll cycles for --bench-time seconds.
+//
+// The loop, write delay and post write delay default to the values in
+// the rig class, so the numbers show what the shipped timing costs.
+// UI updates are the display items the read functions mark with
+// ui_mark(); the benchmark counts and discards them.  The callbacks
+// queued with Fl::awake() are never run, FLTK's queue simply fills.
+// The few controls the drivers configure in initialize(), or the read
+// functions look at, are created as detached stand-ins.
+//----------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Group.H>
+#include <FL/Fl_Box.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Light_Button.H>
+
+#include "support.h"
+#include "status.h"
+#include "rigbase.h"
+#include "rigs.h"
+#include "rig_io.h"
+#include "ptt.h"
+#include "serial.h"
+#include "threads.h"
+#include "tod_clock.h"
+#include "poll_scheduler.h"
+#include "ui_refresh.h"
+#include "combo.h"
+#include "pl_tones.h"
+#include "radio_sim.h"
+
+extern int BaudRate(int n);
+extern POLL_PAIR RX_poll_pairs[];
+extern POLL_PAIR TX_poll_pairs[];
+extern poll_scheduler RX_scheduler;
+extern poll_scheduler TX_scheduler;
+
+static std::vector<std::string> bench_rigs;
+static bool bench_all = false;
+static int  bench_count = 50;
+static int  bench_time = 10;
+static int  bench_baud = -1;		// index into szBaudRates, -1 rig default
+static int  bench_turnaround = 10;
+static int  bench_jitter = 0;
+static int  bench_loop = -1;		// -1, rig default
+static int  bench_write_delay = -1;
+static int  bench_post_delay = -1;
+
+// called from parse_args for each --bench-* option
+int bench_arg(int argc, char **argv, int &idx)
+{
+	std::string opt = argv[idx];
+	bool more = idx + 1 < argc;
+
+	if (opt == "--bench-all") {
+		bench_all = true;
+		idx++;
+		return 1;
+	}
+	if (!more) return 0;
+
+	std::string val = argv[idx + 1];
+	if (opt == "--bench-rig") bench_rigs.push_back(val);
+	else if (opt == "--bench-count") bench_count = atoi(val.c_str());
+	else if (opt == "--bench-time") bench_time = atoi(val.c_str());
+	else if (opt == "--bench-turnaround") bench_turnaround = atoi(val.c_str());
+	else if (opt == "--bench-jitter") bench_jitter = atoi(val.c_str());
+	else if (opt == "--bench-loop") bench_loop = atoi(val.c_str());
+	else if (opt == "--bench-write-delay") bench_write_delay = atoi(val.c_str());
+	else if (opt == "--bench-post-delay") bench_post_delay = atoi(val.c_str());
+	else if (opt == "--bench-baud") {
+		bench_baud = -1;
+		for (int i = 0; szBaudRates[i] != NULL; i++)
+			if (val == szBaudRates[i]) bench_baud = i;
+		if (bench_baud < 0) {
+			fprintf(stderr, "unsupported baud rate %s\n", val.c_str());
+			exit(1);
+		}
+	} else
+		return 0;
+
+	if (bench_count < 1) bench_count = 1;
+	if (bench_time < 1) bench_time = 1;
+	idx += 2;
+	return 1;
+}
+
+//----------------------------------------------------------------------
+// simulated transceiver, served from its own thread
+//----------------------------------------------------------------------
+struct SIM_THREAD {
+	RADIO_SIM *radio;
+	int fd;
+	volatile bool run;
+	pthread_t thread;
+};
+
+static void *sim_loop(void *d)
+{
+	SIM_THREAD *sim = (SIM_THREAD *)d;
+	sim->radio->serve(sim->fd, sim->run);
+	return NULL;
+}
+
+static int dialect(rigbase *rig)
+{
+	if (rig->ICOMrig) return SIM_ICOM;
+	if (strncasecmp(rig->name_.c_str(), "FT", 2) == 0) return SIM_YAESU;
+	return SIM_KENWOOD;
+}
+
+static bool start_sim(SIM_THREAD &sim, rigbase *rig, std::string &slave)
+{
+	sim.radio = new RADIO_SIM(dialect(rig));
+	sim.radio->baud = BaudRate(progStatus.serial_baudrate);
+	sim.radio->turnaround = bench_turnaround;
+	sim.radio->jitter = bench_jitter;
+	if (rig->ICOMrig)
+		sim.radio->civ_addr = rig->defaultCIV;
+
+	sim.fd = RADIO_SIM::open_pty(slave);
+	if (sim.fd < 0) {
+		perror("pty");
+		delete sim.radio;
+		return false;
+	}
+	sim.run = true;
+	if (pthread_create(&sim.thread, NULL, sim_loop, &sim)) {
+		perror("pthread_create");
+		close(sim.fd);
+		delete sim.radio;
+		return false;
+	}
+	return true;
+}
+
+static void stop_sim(SIM_THREAD &sim)
+{
+	sim.run = false;
+	pthread_join(sim.thread, NULL);
+	close(sim.fd);
+	delete sim.radio;
+}
+
+//----------------------------------------------------------------------
+// measurements
+//----------------------------------------------------------------------
+
+// discard the display items marked so far, returns their number; they
+// are in windows which are never built
+static int drain_marks()
+{
+	unsigned long what = ui_take();
+	int n = 0;
+	for (; what; what &= what - 1)
+		n++;
+	return n;
+}
+
+static double percentile(std::vector<double> &v, double p)
+{
+	if (v.empty()) return 0;
+	std::sort(v.begin(), v.end());
+	size_t n = (size_t)(p * (v.size() - 1) + 0.5);
+	return v[n];
+}
+
+static const char *period_name(int period, char *buf, size_t len)
+{
+	if (period == POLL_FILL) snprintf(buf, len, "fill");
+	else if (period == POLL_FAST) snprintf(buf, len, "fast");
+	else if (period == POLL_MEDIUM) snprintf(buf, len, "medium");
+	else snprintf(buf, len, "every %d", period);
+	return buf;
+}
+
+// time each poll function on its own
+static void bench_pairs(const char *title, POLL_PAIR *pairs, SIM_THREAD &sim)
+{
+	printf("\n  %s poll entries, %d calls each\n", title, bench_count);
+	printf("  %-18s %-8s %8s %8s %8s %8s %7s %7s %8s\n",
+		"entry", "period", "cmds", "cmds/s", "p50 ms", "p99 ms",
+		"tx B", "rx B", "UI/s");
+
+	char period[20];
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+		std::vector<double> times;
+		SIM_STATS before = sim.radio->stats;
+		int updates = 0;
+		double total = 0;
+
+		for (int n = 0; n < bench_count; n++) {
+			ullint start = zusec();
+			{
+				guard_lock lk(&mutex_serial, pp->name);
+				(pp->pollfunc)();
+			}
+			double elapsed = (zusec() - start) / 1000.0;
+			times.push_back(elapsed);
+			total += elapsed;
+			updates += drain_marks();
+		}
+
+		SIM_STATS after = sim.radio->stats;
+		unsigned long cmds = after.commands - before.commands;
+		if (!cmds) continue;	// not supported by this transceiver
+
+		double secs = total / 1000.0;
+		printf("  %-18s %-8s %8.1f %8.1f %8.1f %8.1f %7.1f %7.1f %8.1f\n",
+			pp->name.c_str(),
+			period_name(pp->period, period, sizeof(period)),
+			(double)cmds / bench_count,
+			secs > 0 ? cmds / secs : 0,
+			percentile(times, 0.50),
+			percentile(times, 0.99),
+			(double)(after.bytes_in - before.bytes_in) / bench_count,
+			(double)(after.bytes_out - before.bytes_out) / bench_count,
+			secs > 0 ? updates / secs : 0);
+	}
+}
+
+// whole poll cycles as the serial thread runs them
+static void bench_cycles(const char *title, poll_scheduler &sched, SIM_THREAD &sim)
+{
+	std::vector<double> times;
+	SIM_STATS before = sim.radio->stats;
+	int updates = 0;
+	unsigned long cycles = 0, serviced = 0;
+
+	sched.reset();
+	ullint start = zmsec();
+	ullint end = start + bench_time * 1000;
+	while (zmsec() < end) {
+		ullint t0 = zusec();
+		serviced += sched.run_cycle();
+		times.push_back((zusec() - t0) / 1000.0);
+		updates += drain_marks();
+		cycles++;
+		MilliSleep(progStatus.serloop_timing);
+	}
+	double secs = (zmsec() - start) / 1000.0;
+
+	SIM_STATS after = sim.radio->stats;
+	unsigned long cmds = after.commands - before.commands;
+	printf("  %s cycle: %6.1f cycles/s %7.1f cmds/s, %4.1f entries/cycle, "
+		"p50 %6.1f ms, p99 %6.1f ms, %6.1f B/cycle, %6.1f UI/s\n",
+		title,
+		cycles / secs,
+		cmds / secs,
+		cycles ? (double)serviced / cycles : 0,
+		percentile(times, 0.50),
+		percentile(times, 0.99),
+		cycles ? (double)(after.bytes_in - before.bytes_in +
+				after.bytes_out - before.bytes_out) / cycles : 0,
+		updates / secs);
+}
+
+// detached controls in place of those in the main window which the
+// drivers' initialize() and the read functions use
+static void create_standins()
+{
+	Fl_Group::current(0);
+
+	btn_icom_select_10 = new Fl_Button(0, 0, 0, 0);
+	btn_icom_select_11 = new Fl_Button(0, 0, 0, 0);
+	btn_icom_select_12 = new Fl_Button(0, 0, 0, 0);
+	btn_icom_select_13 = new Fl_Button(0, 0, 0, 0);
+	choice_rTONE = new Fl_PL_tone(0, 0, 0, 0, "");
+	Fl_Group::current(0);
+	choice_tTONE = new Fl_PL_tone(0, 0, 0, 0, "");
+	Fl_Group::current(0);
+	op_yaesu_select60 = new Fl_ComboBox(0, 0, 0, 0, "");
+	Fl_Group::current(0);
+	mtr_VOLTS = new Fl_Box(0, 0, 0, 0);
+	mtr_IDD = new Fl_Box(0, 0, 0, 0);
+	btn_tune_on_off = new Fl_Light_Button(0, 0, 0, 0);
+	btnVol = new Fl_Light_Button(0, 0, 0, 0);
+}
+
+// the transceiver side of initRig()
+static void init_driver()
+{
+	selrig->initialize();
+
+	guard_lock lk(&mutex_serial, "bench init");
+	if (progStatus.CIV > 0)
+		selrig->adjustCIV(progStatus.CIV);
+	selrig->inuse = onA;
+	if (selrig->has_getvfoAorB)
+		selrig->get_vfoAorB();
+	vfo = (selrig->inuse == onB) ? &vfoB : &vfoA;
+
+	vfoA.freq = selrig->get_vfoA();
+	vfoA.imode = selrig->get_modeA();
+	vfoA.iBW = selrig->get_bwA();
+	if (selrig->twovfos()) {
+		vfoB.freq = selrig->get_vfoB();
+		vfoB.imode = selrig->get_modeB();
+		vfoB.iBW = selrig->get_bwB();
+	}
+
+	selrig->post_initialize();
+}
+
+static void enable_polls(POLL_PAIR *pairs)
+{
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++)
+		*(pp->poll) = 1;
+}
+
+static bool bench_rig(rigbase *rig)
+{
+	selrig = rig;
+	xcvr_name = rig->name_;
+
+	progStatus.serial_baudrate = bench_baud < 0 ? rig->serial_baudrate : bench_baud;
+	progStatus.stopbits = rig->stopbits;
+	progStatus.serial_retries = rig->serial_retries;
+	progStatus.serial_timeout = rig->serial_timeout;
+	progStatus.serial_rtscts = false;
+	progStatus.serial_rtsplus = progStatus.serial_dtrplus = false;
+	progStatus.serial_catptt = PTT_BOTH;
+	progStatus.serial_rtsptt = progStatus.serial_dtrptt = PTT_NONE;
+	progStatus.serloop_timing = bench_loop < 0 ? rig->serloop_timing : bench_loop;
+	progStatus.serial_write_delay = bench_write_delay < 0 ?
+		rig->serial_write_delay : bench_write_delay;
+	progStatus.serial_post_write_delay = bench_post_delay < 0 ?
+		rig->serial_post_write_delay : bench_post_delay;
+	progStatus.CIV = rig->defaultCIV;
+	progStatus.use_tcpip = false;
+	progStatus.poll_push = false;
+
+	SIM_THREAD sim;
+	std::string slave;
+	if (!start_sim(sim, rig, slave))
+		return false;
+	progStatus.xcvr_serial_port = slave;
+
+	printf("\n%s on %s, %s baud, turnaround %d ms, jitter %d ms\n"
+		"  loop %d ms, write delay %d ms, post write delay %d ms\n",
+		rig->name_.c_str(), slave.c_str(),
+		szBaudRates[progStatus.serial_baudrate],
+		bench_turnaround, bench_jitter,
+		progStatus.serloop_timing,
+		progStatus.serial_write_delay,
+		progStatus.serial_post_write_delay);
+
+	bool ok = startXcvrSerial();
+	if (ok) {
+		bool alive;
+		{
+			guard_lock lk(&mutex_serial, "bench check");
+			alive = selrig->check();
+		}
+		if (!alive) {
+			printf("  not responding to the %s simulation, skipped\n",
+				dialect(rig) == SIM_ICOM ? "CI-V" :
+				dialect(rig) == SIM_YAESU ? "Yaesu" : "Kenwood");
+			ok = false;
+		}
+	} else
+		printf("  cannot open %s\n", slave.c_str());
+
+	if (ok) {
+		init_driver();
+		bypass_serial_thread_loop = true;
+		drain_marks();
+
+		enable_polls(RX_poll_pairs);
+		enable_polls(TX_poll_pairs);
+
+		bench_pairs("RX", RX_poll_pairs, sim);
+
+		{
+			guard_lock lk(&mutex_serial, "bench ptt");
+			selrig->set_PTT_control(1);
+		}
+		bench_pairs("TX", TX_poll_pairs, sim);
+		bench_cycles("TX", TX_scheduler, sim);
+		{
+			guard_lock lk(&mutex_serial, "bench ptt");
+			selrig->set_PTT_control(0);
+		}
+		bench_cycles("RX", RX_scheduler, sim);
+		drain_marks();
+	}
+
+	RigSerial->ClosePort();
+	stop_sim(sim);
+	return ok;
+}
+
+int flrig_bench()
+{
+// the trace window is not built either
+	progStatus.trace = progStatus.rigtrace = false;
+	progStatus.settrace = progStatus.gettrace = false;
+	progStatus.debugtrace = progStatus.xmltrace = false;
+	progStatus.rpctrace = progStatus.serialtrace = false;
+	progStatus.tcitrace = false;
+
+	create_standins();
+
+	std::vector<rigbase *> selected;
+	if (bench_all) {
+		for (int i = 1; rigs[i] != NULL; i++)
+			if (rigs[i]->io_class == SERIAL)
+				selected.push_back(rigs[i]);
+	} else {
+		if (bench_rigs.empty()) {
+			bench_rigs.push_back("TS-890S");
+			bench_rigs.push_back("FTDX101D");
+			bench_rigs.push_back("IC-7300");
+		}
+		for (size_t n = 0; n < bench_rigs.size(); n++) {
+			int i;
+			for (i = 0; rigs[i] != NULL; i++)
+				if (strcasecmp(rigs[i]->name_.c_str(), bench_rigs[n].c_str()) == 0)
+					break;
+			if (rigs[i] == NULL) {
+				fprintf(stderr, "unknown transceiver %s\n", bench_rigs[n].c_str());
+				return 1;
+			}
+			selected.push_back(rigs[i]);
+		}
+	}
+
+	int failed = 0;
+	for (size_t n = 0; n < selected.size(); n++) {
+		if (!bench_rig(selected[n])) failed++;
+		fflush(stdout);
+	}
+	if (failed)
+		printf("\n%d of %d transceivers not measured\n", failed, (int)selected.size());
+
+	return failed ? 1 : 0;
+}
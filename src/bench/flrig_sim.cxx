@@ -0,0 +1,125 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// flrig-sim, a simulated transceiver on a pty
+//
+//   flrig-sim [-kenwood | -yaesu | -icom] [-baud N] [-turnaround MSEC]
+//             [-jitter MSEC] [-echo] [-civ HEX] [-id ID] [-link PATH]
+//             [-seed N]
+//
+// Prints the pty device, or makes PATH a link to it; select that device
+// as the transceiver port in flrig.  Stop with ^C, which prints the
+// command and byte counts.
+//----------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <string>
+
+#include "radio_sim.h"
+
+static volatile bool run = true;
+
+static void stop(int)
+{
+	run = false;
+}
+
+static void usage()
+{
+	fprintf(stderr,
+		"usage: flrig-sim [-kenwood | -yaesu | -icom] [-baud N] [-turnaround MSEC]\n"
+		"                 [-jitter MSEC] [-echo] [-civ HEX] [-id ID] [-link PATH] [-seed N]\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	int dialect = SIM_KENWOOD;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-yaesu") == 0) dialect = SIM_YAESU;
+		else if (strcmp(argv[i], "-icom") == 0) dialect = SIM_ICOM;
+	}
+
+	RADIO_SIM radio(dialect);
+	std::string link;
+
+	for (int i = 1; i < argc; i++) {
+		std::string opt = argv[i];
+		bool more = i + 1 < argc;
+		if (opt == "-kenwood" || opt == "-yaesu" || opt == "-icom")
+			continue;
+		else if (opt == "-echo")
+			radio.echo = true;
+		else if (opt == "-baud" && more)
+			radio.baud = atoi(argv[++i]);
+		else if (opt == "-turnaround" && more)
+			radio.turnaround = atoi(argv[++i]);
+		else if (opt == "-jitter" && more)
+			radio.jitter = atoi(argv[++i]);
+		else if (opt == "-civ" && more)
+			radio.civ_addr = strtol(argv[++i], NULL, 16) & 0xFF;
+		else if (opt == "-id" && more)
+			radio.id = argv[++i];
+		else if (opt == "-link" && more)
+			link = argv[++i];
+		else if (opt == "-seed" && more)
+			radio.seed(atoi(argv[++i]));
+		else
+			usage();
+	}
+
+	std::string slave;
+	int fd = RADIO_SIM::open_pty(slave);
+	if (fd < 0) {
+		perror("pty");
+		return 1;
+	}
+	if (!link.empty()) {
+		unlink(link.c_str());
+		if (symlink(slave.c_str(), link.c_str()) < 0) {
+			perror(link.c_str());
+			return 1;
+		}
+	}
+
+	static const char *names[] = { "Kenwood", "Yaesu", "Icom CI-V" };
+	printf("%s radio on %s%s%s, %d baud, turnaround %d msec, jitter %d msec\n",
+		names[dialect], slave.c_str(),
+		link.empty() ? "" : " linked as ", link.c_str(),
+		radio.baud, radio.turnaround, radio.jitter);
+	fflush(stdout);
+
+	signal(SIGINT, stop);
+	signal(SIGTERM, stop);
+	radio.serve(fd, run);
+
+	close(fd);
+	if (!link.empty()) unlink(link.c_str());
+
+	printf("\n%lu commands, %lu replies, %lu bytes in, %lu bytes out\n",
+		radio.stats.commands, radio.stats.replies,
+		radio.stats.bytes_in, radio.stats.bytes_out);
+	return 0;
+}
@@ -0,0 +1,468 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+
+#include "radio_sim.h"
+
+//----------------------------------------------------------------------
+// ASCII dialects
+//
+// 'sub' characters after the two letter command select the item, so
+// SM0 and SM1 are separate values; a read that omits them reads item
+// 0.  A command longer than name + sub sets the value.  'meter' items
+// answer a random reading 0 .. meter on every read.
+//----------------------------------------------------------------------
+
+struct SIM_ITEM {
+	const char *name;
+	int sub;
+	int width;
+	const char *value;
+	int meter;
+};
+
+static const SIM_ITEM kenwood_items[] = {
+	{ "FA", 0, 11, "00014070000", 0 },
+	{ "FB", 0, 11, "00007030000", 0 },
+	{ "MD", 0, 1,  "2", 0 },
+	{ "FR", 0, 1,  "0", 0 },
+	{ "FT", 0, 1,  "0", 0 },
+	{ "AI", 0, 1,  "0", 0 },
+	{ "PS", 0, 1,  "1", 0 },
+	{ "AG", 1, 3,  "100", 0 },
+	{ "RG", 0, 3,  "255", 0 },
+	{ "SQ", 1, 3,  "000", 0 },
+	{ "PC", 0, 3,  "100", 0 },
+	{ "MG", 0, 3,  "050", 0 },
+	{ "SH", 0, 2,  "10", 0 },
+	{ "SL", 0, 2,  "00", 0 },
+	{ "NB", 0, 1,  "0", 0 },
+	{ "NT", 0, 1,  "0", 0 },
+	{ "PA", 0, 2,  "00", 0 },
+	{ "RA", 0, 2,  "00", 0 },
+	{ "SM", 1, 4,  "0000", 30 },
+	{ "RM", 1, 4,  "0000", 30 },
+	{ 0, 0, 0, 0, 0 }
+};
+
+static const SIM_ITEM yaesu_items[] = {
+	{ "FA", 0, 9,  "014070000", 0 },
+	{ "FB", 0, 9,  "007030000", 0 },
+	{ "MD", 1, 1,  "2", 0 },
+	{ "VS", 0, 1,  "0", 0 },
+	{ "FT", 0, 1,  "0", 0 },
+	{ "ST", 0, 1,  "0", 0 },
+	{ "AI", 0, 1,  "0", 0 },
+	{ "PS", 0, 1,  "1", 0 },
+	{ "AG", 1, 3,  "100", 0 },
+	{ "RG", 1, 3,  "255", 0 },
+	{ "SQ", 1, 3,  "000", 0 },
+	{ "PC", 0, 3,  "100", 0 },
+	{ "MG", 0, 3,  "050", 0 },
+	{ "SH", 1, 3,  "000", 0 },
+	{ "NA", 1, 1,  "0", 0 },
+	{ "NB", 1, 1,  "0", 0 },
+	{ "SM", 1, 3,  "000", 255 },
+	{ "RM", 1, 3,  "000", 255 },
+	{ 0, 0, 0, 0, 0 }
+};
+
+//----------------------------------------------------------------------
+// CI-V commands with sub command bytes, and the data a read of a
+// never set value answers; reads of other unknown values answer NG
+//----------------------------------------------------------------------
+
+struct CIV_ITEM {
+	unsigned char cmd;
+	int nsub;
+	int ndata;		// default data bytes, 0 for NG
+};
+
+static const CIV_ITEM civ_items[] = {
+	{ 0x11, 0, 1 },
+	{ 0x14, 1, 2 },
+	{ 0x16, 1, 1 },
+	{ 0x1A, 2, 0 },
+	{ 0x1B, 1, 0 },
+	{ 0x21, 1, 0 },
+	{ 0x27, 1, 0 },
+	{ 0, 0, 0 }
+};
+
+static std::string to_bcd(unsigned long val, int bytes)
+{
+	std::string bcd;
+	for (int i = 0; i < bytes; i++) {
+		int lo = val % 10; val /= 10;
+		int hi = val % 10; val /= 10;
+		bcd += (char)((hi << 4) | lo);
+	}
+	return bcd;
+}
+
+RADIO_SIM::RADIO_SIM(int d)
+{
+	dialect = d;
+	baud = 38400;
+	turnaround = 10;
+	jitter = 0;
+	echo = false;
+	civ_addr = 0x94;
+	ctrl_addr = 0xE0;
+	ptt = false;
+	rnd = 1;
+	memset(&stats, 0, sizeof(stats));
+
+	switch (dialect) {
+		case SIM_YAESU: id = "0681"; break;	// FTdx101D
+		case SIM_ICOM:  id = "";     break;	// civ_addr
+		default:        id = "024";  break;	// TS-890S
+	}
+// CI-V vfo A / B frequency and mode, data mode and filter
+	values["fA"] = to_bcd(14070000, 5);
+	values["fB"] = to_bcd(7030000, 5);
+	values["mA"] = std::string("\x01\x00\x01", 3);
+	values["mB"] = std::string("\x03\x00\x01", 3);
+	values["vfo"] = "A";
+	values["split"] = std::string(1, '\0');
+}
+
+unsigned int RADIO_SIM::random(unsigned int range)
+{
+	rnd = rnd * 1103515245 + 12345;
+	return range ? (rnd >> 16) % range : 0;
+}
+
+std::string RADIO_SIM::get(const std::string &key)
+{
+	std::map<std::string, std::string>::iterator it = values.find(key);
+	if (it != values.end()) return it->second;
+	const SIM_ITEM *items = (dialect == SIM_YAESU) ? yaesu_items : kenwood_items;
+	for (int i = 0; items[i].name; i++)
+		if (key.compare(0, 2, items[i].name) == 0) return items[i].value;
+	return "";
+}
+
+//----------------------------------------------------------------------
+// Kenwood and Yaesu ASCII
+//----------------------------------------------------------------------
+
+// composite status read
+std::string RADIO_SIM::ascii_info()
+{
+	std::string info = "IF";
+	if (dialect == SIM_YAESU) {
+		info.append("001").append(get("FA")).append("+0000");
+		info.append("00").append(get("MD0")).append("0000").append("0;");
+	} else {
+		info.append(get("FA")).append("     ").append("+0000");
+		info.append("00000").append(ptt ? "1" : "0").append(get("MD"));
+		info.append(get("FR")).append("0");
+		info.append(get("FR") != get("FT") ? "1" : "0");
+		info.append("0000;");
+	}
+	return info;
+}
+
+std::string RADIO_SIM::ascii_reply(const std::string &body)
+{
+	if (body.length() < 2) return "?;";
+	std::string name = body.substr(0, 2);
+
+	if (name == "ID" && body.length() == 2)
+		return "ID" + id + ";";
+	if (name == "IF" && body.length() == 2)
+		return ascii_info();
+	if (dialect == SIM_KENWOOD) {
+		if (name == "TX") { ptt = true; return ""; }
+		if (name == "RX") { ptt = false; return ""; }
+	} else if (name == "TX") {
+		if (body.length() == 2) return ptt ? "TX1;" : "TX0;";
+		ptt = (body[2] != '0');
+		return "";
+	}
+
+	const SIM_ITEM *items = (dialect == SIM_YAESU) ? yaesu_items : kenwood_items;
+	const SIM_ITEM *item = 0;
+	for (int i = 0; items[i].name; i++)
+		if (name == items[i].name) { item = &items[i]; break; }
+
+	if (!item) {
+		if (body.length() > 2) {
+			values[name] = body.substr(2);
+			return "";
+		}
+		std::map<std::string, std::string>::iterator it = values.find(name);
+		if (it == values.end()) return "?;";
+		return name + it->second + ";";
+	}
+
+	std::string key = name + body.substr(2, item->sub);
+	key.resize(2 + item->sub, '0');
+	if (body.length() > key.length()) {
+		values[key] = body.substr(key.length());
+		return "";
+	}
+	std::string value;
+	if (item->meter) {
+		char sz[20];
+		snprintf(sz, sizeof(sz), "%0*u", item->width, random(item->meter + 1));
+		value = sz;
+	} else {
+		std::map<std::string, std::string>::iterator it = values.find(key);
+		value = (it != values.end()) ? it->second : item->value;
+	}
+	return key + value + ";";
+}
+
+//----------------------------------------------------------------------
+// Icom CI-V
+//----------------------------------------------------------------------
+
+std::string RADIO_SIM::civ_frame(const std::string &data)
+{
+	std::string frame = "\xFE\xFE";
+	frame += (char)ctrl_addr;
+	frame += (char)civ_addr;
+	frame.append(data);
+	frame += '\xFD';
+	return frame;
+}
+
+std::string RADIO_SIM::civ_reply(const std::string &frame)
+{
+	static const std::string OK = "\xFB";
+	static const std::string NG = "\xFA";
+
+	if (frame.length() < 6) return "";
+	int to = frame[2] & 0xFF;
+	if (to != civ_addr && to != 0) return "";
+	ctrl_addr = frame[3] & 0xFF;
+
+	unsigned char cmd = frame[4];
+	std::string c(1, (char)cmd);
+	std::string data = frame.substr(5, frame.length() - 6);
+	std::string sel = values["vfo"];
+	std::string unsel = (sel == "A") ? "B" : "A";
+
+	switch (cmd) {
+	case 0x00:			// transceive frequency, no reply
+	case 0x05:
+		if (data.length() < 5) return civ_frame(NG);
+		values["f" + sel] = data.substr(0, 5);
+		return cmd == 0x05 ? civ_frame(OK) : "";
+	case 0x01:			// transceive mode, no reply
+	case 0x06:
+		if (data.empty()) return civ_frame(NG);
+		values["m" + sel][0] = data[0];
+		if (data.length() > 1) values["m" + sel][2] = data[1];
+		return cmd == 0x06 ? civ_frame(OK) : "";
+	case 0x03:
+		return civ_frame(c + values["f" + sel]);
+	case 0x04: {
+		std::string m = values["m" + sel];
+		return civ_frame(c + m[0] + m[2]);
+	}
+	case 0x07:			// vfo select
+		if (data.empty()) return civ_frame(NG);
+		switch (data[0] & 0xFF) {
+			case 0x00: case 0xD0: values["vfo"] = "A"; break;
+			case 0x01: case 0xD1: values["vfo"] = "B"; break;
+			case 0xA0: values["f" + unsel] = values["f" + sel];
+					   values["m" + unsel] = values["m" + sel]; break;
+			case 0xB0: values["fA"].swap(values["fB"]);
+					   values["mA"].swap(values["mB"]); break;
+		}
+		return civ_frame(OK);
+	case 0x0F:			// split
+		if (data.empty()) return civ_frame(c + values["split"]);
+		values["split"] = data.substr(0, 1);
+		return civ_frame(OK);
+	case 0x15: {		// meters
+		if (data.empty()) return civ_frame(NG);
+		unsigned int range = (data[0] == 0x02) ? 242 : 256;
+		std::string level = to_bcd(random(range), 2);	// most significant byte first
+		return civ_frame(c + data[0] + level[1] + level[0]);
+	}
+	case 0x19:			// transceiver id
+		return civ_frame(c + '\x00' + (char)civ_addr);
+	case 0x1C:			// PTT
+		if (data.empty() || data[0] != 0x00) break;
+		if (data.length() == 1)
+			return civ_frame(c + '\x00' + (char)(ptt ? 1 : 0));
+		ptt = data[1] != 0;
+		return civ_frame(OK);
+	case 0x25:			// selected / unselected vfo frequency
+	case 0x26: {		// selected / unselected vfo mode
+		if (data.empty()) return civ_frame(NG);
+		std::string key = (cmd == 0x25 ? "f" : "m") + (data[0] ? unsel : sel);
+		if (data.length() == 1)
+			return civ_frame(c + data[0] + values[key]);
+		values[key] = data.substr(1);
+		if (cmd == 0x26) values[key].resize(3, '\x01');
+		return civ_frame(OK);
+	}
+	default:
+		break;
+	}
+
+	const CIV_ITEM *item = 0;
+	for (int i = 0; civ_items[i].cmd; i++)
+		if (civ_items[i].cmd == cmd) { item = &civ_items[i]; break; }
+	int nsub = item ? item->nsub : 0;
+
+	std::string key = c + data.substr(0, nsub);
+	if ((int)data.length() > nsub) {
+		values[key] = data.substr(nsub);
+		return civ_frame(OK);
+	}
+	std::map<std::string, std::string>::iterator it = values.find(key);
+	if (it != values.end())
+		return civ_frame(key + it->second);
+	if (item && item->ndata)
+		return civ_frame(key + std::string(item->ndata, '\0'));
+	return civ_frame(NG);
+}
+
+//----------------------------------------------------------------------
+
+bool RADIO_SIM::extract(std::string &in, std::string &cmd)
+{
+	if (dialect == SIM_ICOM) {
+		size_t start = in.find("\xFE\xFE");
+		if (start == std::string::npos) {
+			if (!in.empty() && in[in.length() - 1] == '\xFE')
+				in.erase(0, in.length() - 1);
+			else
+				in.clear();
+			return false;
+		}
+		size_t end = in.find('\xFD', start);
+		if (end == std::string::npos) {
+			in.erase(0, start);
+			return false;
+		}
+		cmd = in.substr(start, end - start + 1);
+		in.erase(0, end + 1);
+		return true;
+	}
+	size_t end = in.find(';');
+	if (end == std::string::npos) return false;
+	cmd = in.substr(0, end + 1);
+	in.erase(0, end + 1);
+// leading line ends or noise are not part of a command
+	size_t p = cmd.find_first_not_of("\r\n ");
+	if (p != std::string::npos && p) cmd.erase(0, p);
+	return true;
+}
+
+std::string RADIO_SIM::respond(const std::string &cmd)
+{
+	if (dialect == SIM_ICOM)
+		return civ_reply(cmd);
+	if (cmd.empty()) return "";
+	return ascii_reply(cmd.substr(0, cmd.length() - 1));
+}
+
+//----------------------------------------------------------------------
+
+void RADIO_SIM::wait_msec(double msec)
+{
+	if (msec <= 0) return;
+	struct timespec ts;
+	ts.tv_sec = (time_t)(msec / 1000);
+	ts.tv_nsec = (long)((msec - ts.tv_sec * 1000.0) * 1e6);
+	while (nanosleep(&ts, &ts) == -1 && errno == EINTR)
+		;
+}
+
+// at 'baud' with 10 bits per character, in about 1 msec pieces
+void RADIO_SIM::send_paced(int fd, const std::string &reply)
+{
+	size_t chunk = baud > 10000 ? baud / 10000 : 1;
+	for (size_t n = 0; n < reply.length(); n += chunk) {
+		size_t len = reply.length() - n < chunk ? reply.length() - n : chunk;
+		if (write(fd, reply.data() + n, len) < 0) return;
+		stats.bytes_out += len;
+		if (baud) wait_msec(len * 10000.0 / baud);
+	}
+}
+
+int RADIO_SIM::open_pty(std::string &slave)
+{
+	int fd = posix_openpt(O_RDWR | O_NOCTTY);
+	if (fd < 0) return -1;
+	if (grantpt(fd) < 0 || unlockpt(fd) < 0) {
+		close(fd);
+		return -1;
+	}
+	slave = ptsname(fd);
+
+	struct termios tio;
+	if (tcgetattr(fd, &tio) == 0) {
+		cfmakeraw(&tio);
+		tcsetattr(fd, TCSANOW, &tio);
+	}
+	return fd;
+}
+
+void RADIO_SIM::serve(int fd, volatile bool &run)
+{
+	std::string in, cmd, reply;
+	char buf[1024];
+
+	while (run) {
+		struct pollfd pfd = { fd, POLLIN, 0 };
+		int ret = poll(&pfd, 1, 100);
+		if (ret <= 0) continue;
+		ssize_t n = read(fd, buf, sizeof(buf));
+		if (n <= 0) {
+// EIO until the slave side is opened, or after it is closed
+			wait_msec(100);
+			continue;
+		}
+		in.append(buf, n);
+
+		while (extract(in, cmd)) {
+			stats.commands++;
+			stats.bytes_in += cmd.length();
+// the command is on the wire for as long as the reply would be
+			double wire = baud ? cmd.length() * 10000.0 / baud : 0;
+			if (echo && dialect == SIM_ICOM) {
+				wait_msec(wire);
+				wire = 0;
+				send_paced(fd, cmd);
+			}
+			reply = respond(cmd);
+			if (reply.empty()) continue;
+			wait_msec(wire + turnaround + random(jitter + 1));
+			send_paced(fd, reply);
+			stats.replies++;
+		}
+	}
+}
@@ -0,0 +1,160 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// XmlRpc request / response micro-benchmark
+//
+//   make xmlrpc-bench && ./xmlrpc-bench [iterations]
+//
+// Runs rig.get_vfo and rig.set_vfo requests through the server's own
+// XmlRpcServer::executeRequest, with trivial methods registered in
+// place of the rig methods, and counts the heap allocations made per
+// call.  The "string" rows use the executeRequest overload returning
+// the response, the "buffer" rows the overload writing into a response
+// string reused from call to call, as XmlRpcServerConnection does.
+//
+// Only the "string" rows exist in trees predating the buffered
+// overload; build this file against both trees to compare them.
+//----------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string>
+#include <new>
+#include <sys/time.h>
+
+#include "XmlRpcServer.h"
+#include "XmlRpcServerMethod.h"
+#include "XmlRpcValue.h"
+#include "status.h"
+
+using namespace XmlRpc;
+
+// the xmlrpcpp sources log through the flrig trace functions
+status progStatus;
+void rpc_trace(int n, ...) {}
+
+//----------------------------------------------------------------------
+// allocation counter
+//----------------------------------------------------------------------
+static unsigned long allocations = 0;
+
+void *operator new(size_t size)
+{
+	allocations++;
+	void *p = malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) throw()
+{
+	free(p);
+}
+
+static double now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+//----------------------------------------------------------------------
+// stand in rig methods, the cost measured is the server's
+//----------------------------------------------------------------------
+static double bench_freq = 14070000;
+
+class bench_get_vfo : public XmlRpcServerMethod {
+public:
+	bench_get_vfo(XmlRpcServer* s) : XmlRpcServerMethod("rig.get_vfo", s) {}
+	void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		char szfreq[20];
+		snprintf(szfreq, sizeof(szfreq), "%d", (int)bench_freq);
+		result = szfreq;
+	}
+};
+
+class bench_set_vfo : public XmlRpcServerMethod {
+public:
+	bench_set_vfo(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfo", s) {}
+	void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		bench_freq = double(params[0]);
+		result = 1;
+	}
+};
+
+static const char get_vfo[] =
+	"<?xml version=\"1.0\"?>\r\n"
+	"<methodCall><methodName>rig.get_vfo</methodName>\r\n"
+	"<params>\r\n</params></methodCall>\r\n";
+
+static const char set_vfo[] =
+	"<?xml version=\"1.0\"?>\r\n"
+	"<methodCall><methodName>rig.set_vfo</methodName>\r\n"
+	"<params>\r\n"
+	"<param><value><double>14070000</double></value></param>\r\n"
+	"</params></methodCall>\r\n";
+
+static void run(XmlRpcServer &server, const char *label, const char *xml,
+				bool buffered, long iterations)
+{
+	std::string request = xml;
+	std::string response;
+	size_t bytes = 0;
+
+	allocations = 0;
+	double start = now();
+	for (long n = 0; n < iterations; n++) {
+		if (buffered)
+			server.executeRequest(request, response);
+		else
+			response = server.executeRequest(request);
+		bytes += response.size();
+	}
+	double elapsed = now() - start;
+
+	printf("%-12s %-7s %10.0f calls/s %6.1f allocs/call %8.2f us/call\n",
+		label, buffered ? "buffer" : "string",
+		iterations / elapsed,
+		(double)allocations / iterations,
+		elapsed * 1e6 / iterations);
+	if (response.find("<fault>") != std::string::npos)
+		printf("%s failed:\n%s\n", label, response.c_str());
+	if (!bytes) printf("no response\n");
+}
+
+int main(int argc, char *argv[])
+{
+	long iterations = 200000;
+	if (argc > 1) iterations = atol(argv[1]);
+	if (iterations <= 0) iterations = 1;
+
+	XmlRpcServer server;
+	bench_get_vfo m_get_vfo(&server);
+	bench_set_vfo m_set_vfo(&server);
+
+	run(server, "rig.get_vfo", get_vfo, false, iterations);
+	run(server, "rig.get_vfo", get_vfo, true, iterations);
+	run(server, "rig.set_vfo", set_vfo, false, iterations);
+	run(server, "rig.set_vfo", set_vfo, true, iterations);
+
+	return 0;
+}
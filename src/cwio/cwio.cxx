@@ -30,10 +30,14 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <vector>
 
 #include <errno.h>
 #include <time.h>
 #include <sys/time.h>
+#ifdef __linux__
+#  include <sys/prctl.h>
+#endif
 
 #include <FL/Fl.H>
 
@@ -46,6 +50,7 @@
 #include "cwioUI.h"
 #include "support.h"
 #include "status.h"
+#include "cat_stats.h"
 
 #ifdef __WIN32__
 #include "mingw.h"
@@ -104,23 +109,137 @@ int cw_sleep (double sleep_time)
 		nano_sleep(&tv2, NULL);
 #endif
 
+	return 0;
+}
+
+//======================================================================
+// CW keying engine
+//
+// Each character is compiled into a schedule of key line transitions at
+// absolute times on the monotonic clock.  The time line runs on from one
+// character to the next while text is waiting, so the element timing
+// does not drift with the time spent fetching text or switching the key
+// line.  The cwio thread sleeps to each deadline with clock_nanosleep
+// (TIMER_ABSTIME), with 1 usec timer slack and, with --priority,
+// SCHED_FIFO where the system allows, so it wakes on time without
+// spinning.  Systems without clock_nanosleep use cw_sleep for the
+// remaining time.
+//
+// The lateness of every transition is kept in the "cw keying" timing
+// statistics and summarized in the event log after each message.
+//======================================================================
+
+struct CW_ELEMENT {
+	double at;		// monotonic seconds
+	bool   down;	// key down
+};
+
+static double cw_epoch = 0;			// end of the last character scheduled
+
+static unsigned long jitter_count = 0;
+static double jitter_sum = 0;
+static double jitter_max = 0;
+
+static void jitter_reset()
+{
+	jitter_count = 0;
+	jitter_sum = jitter_max = 0;
+}
+
+static void jitter_report(const char *what)
+{
+	if (!jitter_count) return;
+	LOG_INFO("%s: %lu key events, lateness mean %.3f msec, max %.3f msec",
+		what, jitter_count,
+		1e3 * jitter_sum / jitter_count, 1e3 * jitter_max);
+}
+
+// sleep until 'deadline', returns the lateness in seconds
+static double cw_sleep_until(double deadline)
+{
+#if defined(TIMER_ABSTIME) && !defined(__APPLE__) && !defined(__WIN32__)
+	struct timespec ts;
+	ts.tv_sec = (time_t)deadline;
+	ts.tv_nsec = (long)((deadline - ts.tv_sec) * 1e+9);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+#else
+	double remaining = deadline - monotonic_seconds();
+	if (remaining > 0)
+		cw_sleep(remaining);
+#endif
+	double late = monotonic_seconds() - deadline;
+	if (late < 0) late = 0;
+
+	static STATS_ENTRY *timing = stats_entry(STATS_TIMING, "cw keying");
+	stats_record(timing, (ullint)(late * 1e6));
+	jitter_count++;
+	jitter_sum += late;
+	if (late > jitter_max) jitter_max = late;
+
 #ifdef CWIO_DEBUG
 	if (fcwio)
-		fprintf(fcwio, "%f, %f\n", sleep_time, (end_at - lasterr - start_at));
+		fprintf(fcwio, "%f, %f\n", deadline, late);
 #endif
-	return 0;
+	return late;
 }
 
-void cwio_key(bool state)
+static Cserial *cwio_port()
 {
-	Cserial *port = cwio_serial;
-
 	switch (progStatus.cwioSHARED) {
-		case 1: port = RigSerial; break;
-		case 2: port = AuxSerial; break;
-		case 3: port = SepSerial; break;
-		default: port = cwio_serial;
+		case 1: return RigSerial;
+		case 2: return AuxSerial;
+		case 3: return SepSerial;
+		default: return cwio_serial;
+	}
+}
+
+static void cw_keyline(Cserial *port, bool down)
+{
+	bool level = progStatus.cwioINVERTED ? !down : down;
+	if (progStatus.cwioKEYLINE == 2)
+		port->setDTR(level);
+	else if (progStatus.cwioKEYLINE == 1)
+		port->setRTS(level);
+}
+
+// append the transitions of 'c' to 'sched', starting at 't'; returns
+// the time at which the following character starts
+static double cw_compile(int c, double t, std::vector<CW_ELEMENT> &sched)
+{
+	double tc = 1.2 / progStatus.cwioWPM;
+	double comp = progStatus.cwio_comp * 1e-3;
+
+	if (comp < tc) tc -= comp;
+	double tch = 3 * tc;
+	double twd = 4 * tc;
+
+	double xcvr_corr = progStatus.cwio_keycorr * 1e-3;
+	if (xcvr_corr < -tc / 2) xcvr_corr = - tc / 2;
+	else if (xcvr_corr > tc / 2) xcvr_corr = tc / 2;
+
+	if (c == ' ' || c == 0x0a)
+		return t + twd;
+
+	std::string code = morse->tx_lookup(c);
+	CW_ELEMENT e;
+	for (size_t n = 0; n < code.length(); n++) {
+		e.at = t;
+		e.down = true;
+		sched.push_back(e);
+		t += (code[n] == '.') ? tc + xcvr_corr : tch;
+
+		e.at = t;
+		e.down = false;
+		sched.push_back(e);
+		t += (n == code.length() - 1) ? tch : tc - xcvr_corr;
 	}
+	return t;
+}
+
+void cwio_key(bool state)
+{
+	Cserial *port = cwio_port();
 
 	if (!port)
 		return;
@@ -131,117 +250,62 @@ void cwio_key(bool state)
 	if (progStatus.cwioPTT)
 		doPTT(state);
 
-	if (progStatus.cwioKEYLINE == 2) {
-		port->setDTR(progStatus.cwioINVERTED ? !state : state);
-	} else if (progStatus.cwioKEYLINE == 1) {
-		port->setRTS(progStatus.cwioINVERTED ? !state : state);
-	}
+	cw_keyline(port, state);
 
 	return;
 }
 
-double start_at2;
-
 void send_cwkey(char c)
 {
-	start_at2 = monotonic_seconds();
-
-	std::string code = "";
-	double tc = 0;
-	double tch = 0;
-	double twd = 0;
-	double xcvr_corr = 0;
-	double comp = progStatus.cwio_comp * 1e-3;
-	double requested = 0;
-	Cserial *port = cwio_serial;
+	Cserial *port = cwio_port();
 
-	switch (progStatus.cwioSHARED) {
-		case 1: port = RigSerial; break;
-		case 2: port = AuxSerial; break;
-		case 3: port = SepSerial; break;
-		default: port = cwio_serial;
-	}
-
-	if (!port)
-		goto exit_send_cwkey;
-
-	if (!port->IsOpen())
-		goto exit_send_cwkey;
+	if (!port || !port->IsOpen())
+		return;
 
-	tc = 1.2 / progStatus.cwioWPM;
+// continue the time line unless it fell behind by more than a dot,
+// as it does after waiting for text
+	double now = monotonic_seconds();
+	if (now - cw_epoch > 1.2 / progStatus.cwioWPM)
+		cw_epoch = now;
+	double start_at = cw_epoch;
 
-	if (comp < tc) tc -= comp;
-	tch = 3 * tc;
-	twd = 4 * tc;
-
-	xcvr_corr = progStatus.cwio_keycorr * 1e-3;
-	if (xcvr_corr < -tc / 2) xcvr_corr = - tc / 2;
-	else if (xcvr_corr > tc / 2) xcvr_corr = tc / 2;
+	std::vector<CW_ELEMENT> sched;
+	double next = cw_compile(c, cw_epoch, sched);
 
-	if (c == ' ' || c == 0x0a) {
-		requested += twd;
-		cw_sleep(twd);
-		goto exit_send_cwkey;
-	}
-
-	code = morse->tx_lookup(c);
-	for (size_t n = 0; n < code.length(); n++) {
+	for (size_t n = 0; n < sched.size(); n++) {
 		if (cwio_process == END) {
-			goto exit_send_cwkey;
-		}
-		if (progStatus.cwioKEYLINE == 2) {
-			cwio_key(progStatus.cwioINVERTED ? 0 : 1);
-		} else if (progStatus.cwioKEYLINE == 1) {
-			cwio_key(progStatus.cwioINVERTED ? 0 : 1);
-		}
-		if (code[n] == '.') {
-			requested += (tc + xcvr_corr);
-			cw_sleep((tc + xcvr_corr));
-		} else {
-			requested += tch;
-			cw_sleep(tch);
-		}
-
-		if (progStatus.cwioKEYLINE == 2) {
-			cwio_key(progStatus.cwioINVERTED ? 1 : 0);
-		} else if (progStatus.cwioKEYLINE == 1) {
-			cwio_key(progStatus.cwioINVERTED ? 1 : 0);
-		}
-		if (n == code.length() -1) {
-			requested += tch;
-			cw_sleep(tch);
-		} else {
-			requested += (tc - xcvr_corr);
-			cw_sleep((tc - xcvr_corr));
+			cw_keyline(port, false);
+			cw_epoch = 0;
+			return;
 		}
+		cw_sleep_until(sched[n].at);
+		cw_keyline(port, sched[n].down);
 	}
-
-exit_send_cwkey:
+	cw_epoch = next;
 
 #ifdef CWIO_DEBUG
 	if (fcwio2) {
-		double duration = monotonic_seconds() - start_at2;
-		fprintf(fcwio2, "%f, %f, %f\n", duration, requested, duration - requested);
+		double duration = monotonic_seconds() - start_at;
+		fprintf(fcwio2, "%f, %f, %f\n", duration, next - start_at, duration - (next - start_at));
 	}
 #endif
 
 	return;
 }
 
+// wait out the gap following the last character sent
+static void cw_finish()
+{
+	if (cw_epoch > monotonic_seconds())
+		cw_sleep_until(cw_epoch);
+	cw_epoch = 0;
+}
+
 void reset_cwioport()
 {
-	Cserial *port = cwio_serial;
-	switch (progStatus.cwioSHARED) {
-		case 1: port = RigSerial; break;
-		case 2: port = AuxSerial; break;
-		case 3: port = SepSerial; break;
-		default: port = cwio_serial;
-	}
-	if (progStatus.cwioKEYLINE == 2) {
-		port->setDTR(progStatus.cwioINVERTED ? 1 : 0);
-	} else if (progStatus.cwioKEYLINE == 1) {
-		port->setRTS(progStatus.cwioINVERTED ? 1 : 0);
-	}
+	Cserial *port = cwio_port();
+	if (port)
+		cw_keyline(port, false);
 }
 
 int open_cwkey()
@@ -290,6 +354,7 @@ void terminate_sending(void *)
 void sending_text()
 {
 	char c = 0;
+	jitter_reset();
 	if (progStatus.cwioPTT) {
 		doPTT(1);
 		MilliSleep(50);
@@ -314,11 +379,15 @@ void sending_text()
 		if (c == ']') {
 			cwio_process = END;
 			Fl::awake(terminate_sending);
+			cw_finish();
+			jitter_report("CW keying");
 			return;
 		}
 		if (c) send_cwkey(c);
 		else MilliSleep(50);
 	}
+	cw_finish();
+	jitter_report("CW keying");
 	if (progStatus.cwioPTT) {
 		doPTT(0);
 		MilliSleep(50);
@@ -347,12 +416,15 @@ void do_calibration()
 
 	txt_to_send->value();
 
+	jitter_reset();
 	start_time = monotonic_seconds();
 	for (size_t n = 0; n < teststr.length(); n++) {
 		send_cwkey(teststr[n]);
 	}
+	cw_finish();
 
 	end_time = monotonic_seconds();
+	jitter_report("CW calibration");
 	double corr = 1000.0 * (end_time - start_time - 60.0) / (50.0 * progStatus.cwioWPM);
 
 	progStatus.cwio_comp = corr;
@@ -366,80 +438,33 @@ void do_calibration()
 
 extern bool PRIORITY;
 
-void *cwio_loop(void *)
+// The keying thread's timer slack is reduced to 1 usec.  With --priority
+// it also runs SCHED_FIFO at the highest priority, so that it wakes on
+// time when the system is busy; that needs CAP_SYS_NICE or an rtprio
+// limit, otherwise it stays at normal priority.
+static void cwio_realtime()
 {
-	cwio_thread_running = true;
-	cwio_process = NONE;
-
-#if 1
-if (PRIORITY) {
-	char estr[200];
-	std::string erfname = RigHomeDir;
-	erfname.append("priority.txt");
-	FILE *erfile = fopen(erfname.c_str(),"w");
-#if 0
-//#ifndef __WIN32__
-	int erc = nice(-10);
-	if (erc == -1)
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-	else
-		snprintf(estr, sizeof(estr), "%d: set thread priority to %d", __LINE__, erc);
-	fprintf(erfile, "%s\n", estr);
-
-#else
-
-	// bump up the cwio thread priority
-	pthread_attr_t tattr;
-	if (pthread_attr_init(&tattr)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_init)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
+#ifdef __linux__
+	prctl(PR_SET_TIMERSLACK, 1000UL, 0, 0, 0);
+#endif
+#if !defined(__WIN32__) && !defined(__APPLE__)
+	if (!PRIORITY) return;
 	sched_param param;
-	int sched;
-	if (pthread_attr_getinheritsched(&tattr, &sched)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_getinheritsched)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
-	sched = PTHREAD_EXPLICIT_SCHED;
-	if (pthread_attr_setinheritsched(&tattr, sched)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_setinheritsched)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
-	if (pthread_attr_getschedparam(&tattr, &param)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_getscheduparam)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
-
-	snprintf(estr, sizeof(estr), "%d: priority old = %d", __LINE__, param.sched_priority);
-	fprintf(erfile, "%s\n", estr);
-
 	param.sched_priority = sched_get_priority_max(SCHED_FIFO);
-	snprintf(estr, sizeof(estr), "%d: priority new = %d", __LINE__, param.sched_priority);
-	fprintf(erfile, "%s\n", estr);
-
-	if (pthread_attr_setschedparam(&tattr, &param)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_setscheduparam)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
-
-	if (pthread_attr_getschedparam(&tattr, &param)) {
-		LOG_ERROR("cwio thread fail (pthread_attr_getscheduparam)");
-		snprintf(estr, sizeof(estr), "%d: errno: %d, %s", __LINE__, errno, strerror(errno));
-		fprintf(erfile, "%s\n", estr);
-	}
-
-	snprintf(estr, sizeof(estr), "%d: priority set to %d", __LINE__, param.sched_priority);
-	fprintf(erfile, "%s\n", estr);
+	int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+	if (err)
+		LOG_INFO("cwio thread: SCHED_FIFO not permitted (%s), normal priority", strerror(err));
+	else
+		LOG_INFO("cwio thread: SCHED_FIFO priority %d", param.sched_priority);
 #endif
-	fclose(erfile);
-} // PRIORITY
+}
 
-#endif
+void *cwio_loop(void *)
+{
+	cwio_thread_running = true;
+	cwio_process = NONE;
+
+	cwio_realtime();
 
 	while (1) {
 		pthread_mutex_lock(&cwio_mutex);
@@ -22,16 +22,23 @@
 
 #include "config.h"
 
+#ifdef __linux__
+#  include <sys/prctl.h>
+#endif
+
 #include "fsk.h"
 #include "fskioUI.h"
 #include "serial.h"
 #include "support.h"
 #include "status.h"
 #include "util.h"
+#include "cat_stats.h"
 
 
 extern int errno;
 
+extern double monotonic_seconds();
+
 char FSK::letters[32] = {
 	'\0',	'E',	'\n',	'A',	' ',	'S',	'I',	'U',
 	'\r',	'D',	'R',	'J',	'N',	'F',	'C',	'K',
@@ -94,6 +101,9 @@ FSK *fsk_instance = (FSK *)0;
 
 static std::string FSK_new_text;
 
+static void timing_reset();
+static void timing_report(const char *what);
+
 FSK::FSK()
 {
 	str_buff.clear();
@@ -107,7 +117,9 @@ FSK::FSK()
 	_shift_on_space = false;
 	idles = progStatus.fsk_idles;
 
-	BITLEN = 0.022;
+	BITLEN = 1.0 / 45.45;
+	deadline = 0;
+	fsk_measure = false;
 
 	init_fsk_thread();
 
@@ -180,11 +192,14 @@ bool FSK::sending() {
 		Fl::awake(btn_fskioSEND_ON, this);
 		FSK_send_text(true);
 		idles = progStatus.fsk_idles;
+		timing_reset();
 		return true;
 	} else if (str_buff[0] == ']') {
 		str_buff.clear();
 		Fl::awake(update_fsk_txt_to_send, this);
 		Fl::awake(btn_fskioSEND_OFF, this);
+		finish();
+		timing_report("FSK");
 		FSK_send_text(false);
 		return false;
 	}
@@ -234,82 +249,226 @@ int FSK::baudot_enc(int data) {
 	return shift_state | 4;
 }
 
+//======================================================================
+// Baudot keying
+//
+// Every character is sent from a precomputed frame, the key line
+// transitions of the start bit, five data bits and stop bit, at whole bit
+// offsets from the start of the character.  Bits which do not change the
+// line are not written to the port.  The frames are keyed on a time line
+// of absolute deadlines on the monotonic clock which runs on from one
+// character to the next, the LTRS idles included, so that neither the
+// time spent switching the key line nor the wake up latency of the
+// thread accumulates from bit to bit.  The time line restarts when the
+// text runs dry for longer than a bit.
+//
+// The lateness of every transition is kept in the "fsk bits" timing
+// statistics.  The lateness and the drift of the character timing from
+// 45.45 baud are summarized in the event log after each transmission, or
+// on demand by FSK_measure_timing, which keys LTRS idles with the
+// transmitter off.
+//======================================================================
+
+struct FSK_FRAME {
+	int  n;			// number of transitions
+	int  at[7];		// bit offset from the start bit
+	bool level[7];	// FSK_MARK / FSK_SPACE
+};
+
+static FSK_FRAME frames[32];
+
+static void build_frames()
+{
+	for (int ch = 0; ch < 32; ch++) {
+		FSK_FRAME &f = frames[ch];
+		f.n = 0;
+		f.at[f.n] = 0;
+		f.level[f.n++] = FSK_SPACE;
+		bool prev = FSK_SPACE;
+		for (int bit = 0; bit < 5; bit++) {
+			bool level = (ch & (1 << bit)) ? FSK_MARK : FSK_SPACE;
+			if (level == prev) continue;
+			f.at[f.n] = bit + 1;
+			f.level[f.n++] = level;
+			prev = level;
+		}
+		if (prev != FSK_MARK) {
+			f.at[f.n] = 6;
+			f.level[f.n++] = FSK_MARK;
+		}
+	}
+}
+
+static unsigned long timing_count = 0;	// transitions keyed
+static unsigned long timing_restarts = 0;
+static double timing_sum = 0;
+static double timing_max = 0;
+// drift is measured over each unbroken time line, from its start to the
+// last transition keyed, so the idle gaps between restarts do not count
+static double timing_start = 0;			// start of the time line, 0 if none
+static double timing_last_at = 0;		// last transition, scheduled
+static double timing_last_done = 0;		// and when it was keyed
+static double timing_elapsed = 0;		// seconds keyed, ended time lines
+static double timing_nominal = 0;		// seconds scheduled, ended time lines
+
+static void timing_close()
+{
+	if (!timing_start) return;
+	timing_elapsed += timing_last_done - timing_start;
+	timing_nominal += timing_last_at - timing_start;
+	timing_start = 0;
+}
+
+static void timing_reset()
+{
+	timing_count = timing_restarts = 0;
+	timing_sum = timing_max = 0;
+	timing_start = timing_last_at = timing_last_done = 0;
+	timing_elapsed = timing_nominal = 0;
+}
+
+static void timing_report(const char *what)
+{
+	if (!timing_count) return;
+	timing_close();
+	double drift = timing_nominal > 0 ?
+		1e6 * (timing_elapsed - timing_nominal) / timing_nominal : 0;
+	LOG_INFO("%s timing: %lu transitions, late mean %.3f ms, max %.3f ms, drift %.0f ppm, %lu restarts",
+		what, timing_count,
+		1e3 * timing_sum / timing_count, 1e3 * timing_max,
+		drift, timing_restarts);
+}
+
 // return current tick time in seconds
 double FSK::now()
 {
-	static struct timeval t1;
-	gettimeofday(&t1, NULL);
-	return t1.tv_sec + t1.tv_usec / 1e6;
+	return monotonic_seconds();
 }
 
-int FSK::sleep (double sleep_time)
+// sleep until the monotonic time 'at', return the lateness
+double FSK::sleep_until(double at)
 {
-	struct timespec tv;
-	double start_at = now();
-	double end_at = start_at + sleep_time;
-	double delay = sleep_time - 0.005;
-	tv.tv_sec = (time_t) delay;
-	tv.tv_nsec = (long) ((delay - tv.tv_sec) * 1e+9);
-	int rval = 0;
+#if defined(TIMER_ABSTIME) && !defined(__APPLE__) && !defined(__WIN32__)
+	struct timespec ts;
+	ts.tv_sec = (time_t)at;
+	ts.tv_nsec = (long)((at - ts.tv_sec) * 1e+9);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+		;
+#else
+	double remaining = at - now();
+	if (remaining > 0) {
+		struct timespec tv;
+		tv.tv_sec = (time_t) remaining;
+		tv.tv_nsec = (long) ((remaining - tv.tv_sec) * 1e+9);
 #ifdef __WIN32__
-	timeBeginPeriod(1);
-	end_at -= 0.0005;
+		timeBeginPeriod(1);
 #endif
-	while (1) {
-		rval = nano_sleep (&tv, &tv);
-		if (rval == 0)
-			break;
-		else if (errno == EINTR)
-			continue;
-		else
-			return rval;
-	}
-	while (now() < end_at);
+		nano_sleep (&tv, NULL);
 #ifdef __WIN32__
-	timeEndPeriod(1);
+		timeEndPeriod(1);
 #endif
-	return 0;
+	}
+#endif
+	double late = now() - at;
+	if (late < 0) late = 0;
+
+	static STATS_ENTRY *timing = stats_entry(STATS_TIMING, "fsk bits");
+	stats_record(timing, (ullint)(late * 1e6));
+	timing_count++;
+	timing_sum += late;
+	if (late > timing_max) timing_max = late;
+
+	return late;
+}
+
+// wait out the stop bit of the last character sent
+void FSK::finish()
+{
+	if (deadline > now())
+		sleep_until(deadline);
+	deadline = 0;
 }
 
 void FSK::send_baudot(int ch)
 {
-	double t1;
 	if (ch == LTRS) shift_state = FSK_LETTERS;
 	else if (ch == FIGS) shift_state = FSK_FIGURES;
 
-	t1 = now();
-	fsk_out(FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
-
-	t1 = now();
-	fsk_out((ch & 0x01) == 0x01 ? FSK_MARK : FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
-
-	t1 = now();
-	fsk_out((ch & 0x02) == 0x02 ? FSK_MARK : FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
+	double t = now();
+	if (deadline < t - BITLEN) {
+		if (timing_start) {
+			timing_restarts++;
+			timing_close();
+		}
+		deadline = t;
+	}
+	if (!timing_start) timing_start = deadline;
+
+	const FSK_FRAME &f = frames[ch & 0x1F];
+	for (int n = 0; n < f.n; n++) {
+		double at = deadline + f.at[n] * BITLEN;
+		double late = sleep_until(at);
+		fsk_out(f.level[n]);
+		timing_last_at = at;
+		timing_last_done = at + late;
+	}
 
-	t1 = now();
-	fsk_out((ch & 0x04) == 0x04 ? FSK_MARK : FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
+	deadline += BITLEN * (6 + (progStatus.FSK_STOPBITS ? 1.5 : 2.0));
+}
 
-	t1 = now();
-	fsk_out((ch & 0x08) == 0x08 ? FSK_MARK : FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
+void btn_fsk_measure_OFF(void *)
+{
+	btn_fsk_measure->value(0);
+	btn_fsk_measure->redraw();
+}
 
-	t1 = now();
-	fsk_out((ch & 0x10) == 0x10 ? FSK_MARK : FSK_SPACE);
-	sleep(BITLEN - (now() - t1));
+// key LTRS idles for 10 seconds with the transmitter off and report the
+// keying lateness and drift
+bool FSK::measure_timing()
+{
+	{
+		guard_lock tlock (&fsk_mutex);
+		if (!fsk_measure) return false;
+		fsk_measure = false;
+	}
+	if (FSK_process) {
+		LOG_INFO("FSK timing: transmitting, not measured");
+		Fl::awake(btn_fsk_measure_OFF);
+		return false;
+	}
 
-	t1 = now();
-	fsk_out(FSK_MARK);
-	sleep(BITLEN * (progStatus.FSK_STOPBITS ? 1.5 : 2.0) - (now() - t1) );
+	int state = shift_state;
+	timing_reset();
+	double end_at = now() + 10.0;
+	while (now() < end_at) {
+		{
+			guard_lock tlock (&fsk_mutex);
+			if (fsk_loop_terminate) break;
+		}
+		send_baudot(LTRS);
+	}
+	finish();
+	timing_report("FSK measurement");
+	shift_state = state;
 
+	Fl::awake(btn_fsk_measure_OFF);
+	return true;
 }
 
+void FSK_measure_timing()
+{
+	if (!fsk_instance) {
+		btn_fsk_measure->value(0);
+		return;
+	}
+	guard_lock tlock (&fsk_mutex);
+	fsk_instance->fsk_measure = true;
+}
 
 int FSK::callback_method()
 {
+	if (measure_timing())
+		return 0;
 	if (sending()) {
 		if (str_buff.empty() || idles) {
 			send_baudot(LTRS);
@@ -336,6 +495,9 @@ int FSK::callback_method()
 void *fsk_loop(void *data)
 {
 	FSK *fsk = (FSK *)data;
+#ifdef __linux__
+	prctl(PR_SET_TIMERSLACK, 1000UL, 0, 0, 0);
+#endif
 	while (1) {
 		fsk->callback_method();
 		{
@@ -351,6 +513,8 @@ int FSK::init_fsk_thread()
 {
 	fsk_loop_terminate = false;
 
+	build_frames();
+
 	if(pthread_mutex_init(&fsk_mutex, NULL)) {
 		LOG_ERROR("FSK pthread_mutex_init failed");
 		return 0;
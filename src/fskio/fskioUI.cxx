@@ -799,6 +799,12 @@ static void cb_fsk_idles(Fl_Counter* o, void*) {
   progStatus.fsk_idles = o->value();
 }
 
+Fl_Light_Button *btn_fsk_measure=(Fl_Light_Button *)0;
+
+static void cb_btn_fsk_measure(Fl_Light_Button*, void*) {
+  FSK_measure_timing();
+}
+
 Fl_Double_Window* fskio_config_dialog() {
   Fl_Double_Window* w;
   { Fl_Double_Window* o = new Fl_Double_Window(670, 100, _("FSK Configuration"));
@@ -898,6 +904,11 @@ Fl_Double_Window* fskio_config_dialog() {
         fsk_idles->callback((Fl_Callback*)cb_fsk_idles);
         o->value(progStatus.fsk_idles);
       } // Fl_Counter* fsk_idles
+      { btn_fsk_measure = new Fl_Light_Button(400, 41, 80, 24, _("Timing"));
+        btn_fsk_measure->tooltip(_("Key 10 seconds of <LTRS> idles, transmitter off,\nand log the keying jitter and drift"));
+        btn_fsk_measure->selection_color((Fl_Color)6);
+        btn_fsk_measure->callback((Fl_Callback*)cb_btn_fsk_measure);
+      } // Fl_Light_Button* btn_fsk_measure
       o->end();
     } // Fl_Group* o
     o->end();
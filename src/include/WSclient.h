@@ -43,6 +43,7 @@ namespace WSclient {
 
 struct Callback_Imp { virtual void operator()(const std::string& message) = 0; };
 struct BytesCallback_Imp { virtual void operator()(const std::vector<uint8_t>& message) = 0; };
+struct FrameCallback_Imp { virtual void operator()(const char *data, size_t len) = 0; };
 
 class WebSocket {
   public:
@@ -90,9 +91,24 @@ class WebSocket {
         _dispatchBinary(callback);
     }
 
+    template<class Callable>
+    void dispatchFrame(Callable callable)
+        // For callbacks that accept a (const char *, size_t) pair.  The data
+        // points into the receive buffer and is valid only for the call.
+    {
+        struct _Callback : public FrameCallback_Imp {
+            Callable& callable;
+            _Callback(Callable& callable) : callable(callable) { }
+            void operator()(const char *data, size_t len) { callable(data, len); }
+        };
+        _Callback callback(callable);
+        _dispatchFrame(callback);
+    }
+
   protected:
     virtual void _dispatch(Callback_Imp& callable) = 0;
     virtual void _dispatchBinary(BytesCallback_Imp& callable) = 0;
+    virtual void _dispatchFrame(FrameCallback_Imp& callable) = 0;
 };
 
 } // namespace WSclient
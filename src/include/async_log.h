@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <cstdio>
+#include <string>
+
+//----------------------------------------------------------------------
+// Asynchronous log writer
+//
+// trace() and the debug event log hand their formatted lines to
+// async_log(), which copies them into a fixed ring of cells and returns.
+// Producers claim cells with a compare-and-swap and never block; if the
+// ring is full the line is dropped and counted.  A single logger thread
+// drains the ring in batches, writes each batch through one open FILE
+// per destination with one fflush, and passes it to the destination's
+// display function, if any.
+//----------------------------------------------------------------------
+
+enum {
+	ASYNC_TRACE,	// trace.txt and the trace window
+	ASYNC_EVENTS,	// debug_log.txt
+	ASYNC_DESTS
+};
+
+// queue 'len' bytes of 'text' for 'dest'; lines longer than the
+// ring can carry in one piece are truncated
+extern void async_log(int dest, const char *text, size_t len);
+
+// open 'path' for append and write 'dest' there
+extern void async_log_open(int dest, const char *path);
+
+// write 'dest' to an already open file; NULL detaches the current one
+// after everything queued so far has been written
+extern void async_log_file(int dest, FILE *fp);
+
+// called on the logger thread with each batch written to 'dest'
+extern void async_log_display(int dest, void (*display)(const std::string &));
+
+// wait until everything queued so far has been written
+extern void async_log_flush();
+
+// lines dropped because the ring was full
+extern unsigned long async_log_dropped();
+
+#endif
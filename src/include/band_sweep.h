@@ -0,0 +1,66 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef BAND_SWEEP_H
+#define BAND_SWEEP_H
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Band sweep
+//
+// Steps the active vfo from start to stop and reads the S-meter at each
+// frequency, on a thread of its own.  Each step takes mutex_serial to
+// set the frequency and again to read the S-meter, so the poll loop and
+// the CAT executor run between them while the receiver settles.  While
+// it runs, the paths that read the
+// frequency back (read_vfo, the Elecraft readers, rig.get_vfoA/B) leave
+// vfoA/vfoB.freq alone, so they keep the operating frequency, and any
+// tuning done meanwhile, for the restore when the sweep ends.
+//
+// Points are available as they are measured; readers wait on a
+// condition for points past the ones they already have.
+//----------------------------------------------------------------------
+
+#define SWEEP_MAX_POINTS  10000
+#define SWEEP_MAX_SETTLE  1000		// msec
+
+struct SWEEP_POINT {
+	unsigned long long freq;
+	int level;			// S-meter, 0..100 bar scale, -1 if not read
+};
+
+// start a sweep; false, with the reason in 'err', if one is running,
+// the transceiver cannot be swept or the range is not valid
+extern bool sweep_start(unsigned long long start, unsigned long long stop,
+	unsigned long long step, int settle, std::string &err);
+
+// end the sweep in progress and wait for the vfo to be restored
+extern void sweep_stop();
+
+extern bool sweep_running();
+
+// copy points 'from' onward, waiting up to 'msec' for one to be
+// measured; returns the number of points in the sweep
+extern size_t sweep_read(size_t from, std::vector<SWEEP_POINT> &points,
+	bool &running, int msec);
+
+#endif
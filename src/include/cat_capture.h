@@ -0,0 +1,102 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef CAT_CAPTURE_H
+#define CAT_CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//----------------------------------------------------------------------
+// Binary capture of transceiver traffic
+//
+// Every block of bytes written to or read from the transceiver is
+// stored with a microsecond time stamp, direction and port in a file
+// mapped into memory.  The record area is a ring: when it is full the
+// oldest records are overwritten, so the file always holds the most
+// recent traffic.  Decode or replay a capture with flrig-capture.
+//
+// File layout, host byte order:
+//   CAP_FILE_HEADER
+//   record area of data_size bytes
+//
+// 'head' and 'tail' count bytes from the start of the capture; the
+// record area offset is position % data_size.  Records are 8 byte
+// aligned and never wrap: when fewer than sizeof(CAP_RECORD) bytes
+// remain before the end of the area they are skipped, otherwise a
+// CAP_PAD record fills them.
+//----------------------------------------------------------------------
+
+#define CAP_MAGIC    "FLRIGCAP"
+#define CAP_VERSION  1
+
+struct CAP_FILE_HEADER {
+	char     magic[8];
+	uint32_t version;
+	uint32_t header_size;	// sizeof(CAP_FILE_HEADER)
+	uint64_t data_size;		// bytes in the record area
+	uint64_t head;			// end of the newest record
+	uint64_t tail;			// start of the oldest complete record
+	uint64_t start_usec;	// capture start, usec since the epoch
+	uint8_t  reserved[16];
+};
+
+struct CAP_RECORD {
+	uint64_t usec;			// usec since the epoch
+	uint32_t size;			// record size including this header
+	uint32_t nbytes;		// data bytes following the header
+	uint8_t  dir;
+	uint8_t  port;
+	uint8_t  reserved[6];
+};
+
+enum { CAP_TX, CAP_RX, CAP_PAD };
+
+enum { CAP_CAT, CAP_AUX, CAP_SEP, CAP_REMOTE, CAP_TCI, CAP_OTHER };
+
+#define CAP_ALIGN(n) (((n) + 7) & ~(uint64_t)7)
+
+// offset in the record area of the record at 'pos', skipping the
+// unused end of the area when a record header will not fit there
+static inline uint64_t cap_offset(uint64_t &pos, uint64_t data_size)
+{
+	uint64_t off = pos % data_size;
+	if (data_size - off < sizeof(CAP_RECORD)) {
+		pos += data_size - off;
+		off = 0;
+	}
+	return off;
+}
+
+extern volatile bool cat_capturing;
+
+// start or stop capturing to RigHomeDir/cat_capture.bin; a previous
+// capture is kept as cat_capture.bin.1
+extern bool cat_capture_start();
+extern void cat_capture_stop();
+
+extern void cat_capture_write(int port, int dir, const char *data, size_t n);
+
+inline void cat_capture(int port, int dir, const char *data, size_t n)
+{
+	if (cat_capturing && n) cat_capture_write(port, dir, data, n);
+}
+
+#endif
@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef CAT_EXECUTOR_H
+#define CAT_EXECUTOR_H
+
+//----------------------------------------------------------------------
+// CAT command executor
+//
+// The UI callbacks do not talk to the transceiver.  They read their
+// widgets, update progStatus and the vfo state, and post the transceiver
+// part of the work as a function and a value to a single executor
+// thread.  Commands run in the order posted and take mutex_serial
+// themselves, so a slow transceiver or a poll in progress delays the
+// command and not the window.
+//
+// A command posted with CAT_COALESCE replaces the last one queued when
+// that is for the same function: last writer wins, and a tuning knob
+// turned while the executor is busy leaves only the newest frequency to
+// send.  Anything posted in between ends the run, so commands always
+// reach the transceiver in the order posted.  Button presses, and
+// commands that change what later ones mean (the mode selects the
+// bandwidth table), are posted with CAT_QUEUE and every one of them runs.
+//----------------------------------------------------------------------
+
+typedef void (*CAT_FUNC)(long long val);
+
+enum { CAT_QUEUE, CAT_COALESCE };
+
+// run func(val) on the executor thread; at once on the caller's thread
+// when posted by a command, or after the executor has been stopped
+extern void cat_post(CAT_FUNC func, long long val = 0, int how = CAT_COALESCE);
+
+// is a command for func waiting to run or running
+extern bool cat_pending(CAT_FUNC func);
+
+// wait until every command posted so far has run
+extern void cat_flush();
+
+// run the commands still queued and end the executor thread
+extern void cat_executor_stop();
+
+// commands replaced by a newer one before they ran
+extern unsigned long cat_coalesced();
+
+#endif
@@ -0,0 +1,90 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef CAT_STATS_H
+#define CAT_STATS_H
+
+#include <string>
+#include <vector>
+
+#include "tod_clock.h"
+
+//----------------------------------------------------------------------
+// Latency statistics
+//
+// Each CAT command exchange, poll function call, named mutex and keyer
+// keeps a histogram of its times in microseconds.  Buckets are
+// log-linear, HDR style: exact below 16 usec, then 8 sub-buckets for
+// every power of two, so any recorded value is within 1/8 of its bucket
+// value.
+//
+// Recording is lock-free.  Entries are created on first use in a fixed
+// table per kind, found by name hash; counters are updated with atomic
+// adds, so any thread may record while another reads the summary.
+//----------------------------------------------------------------------
+
+enum {
+	STATS_CMD,			// command / reply exchange, by driver label
+	STATS_POLL,			// poll function, by poll table entry name
+	STATS_LOCK_WAIT,	// time waiting to acquire a mutex
+	STATS_LOCK_HOLD,	// time a mutex was held
+	STATS_TIMING,		// lateness of timed keying events, by keyer
+	STATS_KINDS
+};
+
+#define STATS_SLOTS     256		// entries per kind
+#define STATS_NAME_LEN  40
+#define STATS_BUCKETS   240		// to 2^32 usec
+
+struct STATS_ENTRY;
+
+struct STATS_SUMMARY {
+	std::string name;
+	unsigned long count;
+	double total;		// msec
+	double mean;		// msec
+	double p50, p90, p99, max;	// msec
+	unsigned long tx_bytes;
+	unsigned long rx_bytes;
+	unsigned long timeouts;
+};
+
+// find or create the entry for 'name', NULL when the table is full
+extern STATS_ENTRY *stats_entry(int kind, const char *name);
+
+extern void stats_record(STATS_ENTRY *e, ullint usec);
+
+// a command exchange; 'timeout' when the reply was incomplete
+extern void stats_command(const char *name, ullint usec, size_t tx, size_t rx, bool timeout);
+
+// label for a command sent without one, e.g. "FA" or "CI-V 1A 05"
+extern std::string stats_command_name(const std::string &cmd);
+
+extern void stats_reset();
+
+// entries of one kind, busiest (largest total time) first
+extern void stats_summary(int kind, std::vector<STATS_SUMMARY> &list);
+
+// all kinds as a text table
+extern std::string stats_report();
+
+extern void open_stats_window();
+
+#endif
@@ -18,32 +18,32 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // ----------------------------------------------------------------------------
 
-#ifndef FSKLOG_H
-#define FSKLOG_H
+#ifndef CWLOG_H
+#define CWLOG_H
 
-extern bool fsklog_editing;
+extern bool cwlog_editing;
 
-extern void fsklog_sort_by_call();
-extern void fsklog_sort_by_datetime();
-extern void fsklog_sort_by_nbr();
-extern void fsklog_sort_by_freq();
+extern void cwlog_sort_by_call();
+extern void cwlog_sort_by_datetime();
+extern void cwlog_sort_by_nbr();
+extern void cwlog_sort_by_freq();
 
-extern void fsklog_clear_qso();
-extern void fsklog_save_qso();
+extern void cwlog_clear_qso();
+extern void cwlog_save_qso();
 
-extern void fsklog_edit_entry();
-extern void fsklog_delete_entry();
-extern void fsklog_view();
+extern void cwlog_edit_entry();
+extern void cwlog_delete_entry();
+extern void cwlog_view();
 
-extern void fsklog_close();
-extern void fsklog_open();
-extern void fsklog_new();
+extern void cwlog_close();
+extern void cwlog_open();
+extern void cwlog_new();
 
-extern void fsklog_load();
-extern void fsklog_save();
-extern void fsklog_save_as();
+extern void cwlog_load();
+extern void cwlog_save();
+extern void cwlog_save_as();
 
-extern void fsklog_export_adif();
-extern void fsklog_import_adif();
+extern void cwlog_export_adif();
+extern void cwlog_import_adif();
 
 #endif
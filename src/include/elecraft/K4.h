@@ -105,6 +105,9 @@ public:
 	int  get_split();
 	bool twovfos() {return true;}
 
+	std::string pipeline_query(std::string poll_name);
+	void push_mode(bool on);
+
 	void shutdown();
 
 	void set_pbt_values(int val);
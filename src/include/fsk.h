@@ -113,10 +113,13 @@ private:
 	int   chr_out;
 
 	double BITLEN;
+	double deadline;	// end of the last character scheduled
 	double now();
-	int    sleep (double sleep_time);
+	double sleep_until (double at);
+	void   finish();
 
 	void send_baudot(int);
+	bool measure_timing();
 	int baudot_enc(int);
 	void fsk_out (bool);
 
@@ -130,6 +133,7 @@ public:
 	void exit_fsk_thread();
 
 	bool	fsk_loop_terminate;
+	bool	fsk_measure;
 
 	pthread_t fsk_thread;
 
@@ -177,5 +181,6 @@ extern void FSK_done_edit();
 extern void FSK_control_function_keys();
 
 extern void FSK_open_config();
+extern void FSK_measure_timing();
 
 #endif
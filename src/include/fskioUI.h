@@ -44,6 +44,7 @@ extern Fl_ListBox *listbox_fskioKEYLINE;
 extern Fl_Spinner *cntr_fskioPTT;
 #include <FL/Fl_Counter.H>
 extern Fl_Counter *fsk_idles;
+extern Fl_Light_Button *btn_fsk_measure;
 Fl_Double_Window* fskio_config_dialog();
 #include <FL/Fl_Menu_Bar.H>
 extern Fl_Menu_Bar *FSKlog_menubar;
@@ -127,6 +127,8 @@ public:
 	int  get_volume_control();
 	void get_vol_min_max_step(int &min, int &max, int &step);
 
+	std::string pipeline_query(std::string poll_name);
+
 	int  get_smeter();
 	int  get_power_out(void);
 	int  get_swr(void);
@@ -110,6 +110,8 @@ public:
 	void set_split(bool v);
 	int  get_split();
 
+	std::string pipeline_query(std::string poll_name);
+
 	int get_smeter();
 	int get_power_out();
 	int get_swr();
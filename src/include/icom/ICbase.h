@@ -51,6 +51,11 @@ public:
 	bool  waitFOR(size_t n, const char *sz, ullint timeout = 500);
 	void adjustCIV(uchar adr);
 
+// batched CI-V queries, see rigbase::pipeline
+	int  pipeline(std::string queries, int timeout = 100);
+	std::string civ_frame(std::string body);
+	std::string push_match(std::string &frame, std::string queries);
+
 	virtual void swapAB();
 	virtual void A2B();
 
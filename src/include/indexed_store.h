@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef INDEXED_STORE_H
+#define INDEXED_STORE_H
+
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// indexed record store, used by QSO_LOG and MEM_BANK
+//
+// The records are held in a vector in the order they were stored; a
+// record's id is its position.  A sort index of record ids for each
+// column is kept ordered as records are added, changed and deleted, so
+// a sort is a walk down an index and a range is a binary search.
+//
+// REC has a 'deleted' flag and a
+//     static int compare(const REC &a, const REC &b, int column);
+// returning <0, 0 or >0; records comparing equal are ordered by id.
+//----------------------------------------------------------------------
+
+template <class REC>
+class indexed_store {
+protected:
+	indexed_store(int columns) : index(columns) {}
+
+	struct ORDER {
+		const indexed_store *store;
+		int column;
+		ORDER(const indexed_store *s, int c) : store(s), column(c) {}
+		bool operator()(int a, int b) const {
+			int cmp = REC::compare(store->records[a], store->records[b], column);
+			if (cmp) return cmp < 0;
+			return a < b;
+		}
+	};
+
+	std::vector<REC> records;
+	std::vector< std::vector<int> > index;
+
+	int append(const REC &rec) {
+		records.push_back(rec);
+		records.back().deleted = false;
+		return records.size() - 1;
+	}
+
+	void index_add(int id) {
+		for (size_t n = 0; n < index.size(); n++) {
+			std::vector<int> &idx = index[n];
+			idx.insert(std::lower_bound(idx.begin(), idx.end(), id, ORDER(this, n)), id);
+		}
+	}
+
+	void index_remove(int id) {
+		for (size_t n = 0; n < index.size(); n++) {
+			std::vector<int> &idx = index[n];
+			std::vector<int>::iterator it =
+				std::lower_bound(idx.begin(), idx.end(), id, ORDER(this, n));
+			if (it != idx.end() && *it == id)
+				idx.erase(it);
+		}
+	}
+
+	void reindex() {
+		for (size_t n = 0; n < index.size(); n++) {
+			index[n].clear();
+			index[n].reserve(records.size());
+			for (size_t id = 0; id < records.size(); id++)
+				if (!records[id].deleted) index[n].push_back(id);
+			std::sort(index[n].begin(), index[n].end(), ORDER(this, n));
+		}
+	}
+};
+
+#endif
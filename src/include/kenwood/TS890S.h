@@ -45,6 +45,9 @@ enum TS590MODES { LSB, USB, CW, FM, AM, FSK, CWR, FSKR, LSBD, USBD, FMD };
   	int  get_split();
   	bool twovfos() {return true;}
 
+	std::string pipeline_query(std::string poll_name);
+	void push_mode(bool on);
+
 	void set_PTT_control(int val);
 	int  get_PTT();
 
@@ -127,6 +127,9 @@ public:
 	int  get_split();
 	bool twovfos() {return true;}
 
+	std::string pipeline_query(std::string poll_name);
+	void push_mode(bool on);
+
 	int  get_smeter();
 	int  get_swr();
 	int  get_alc();
@@ -0,0 +1,136 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef MEM_BANK_H
+#define MEM_BANK_H
+
+#include <string>
+#include <vector>
+#include <pthread.h>
+
+#include <FL/Fl_Browser.H>
+
+#include "indexed_store.h"
+
+//----------------------------------------------------------------------
+// frequency memory bank
+//
+// The memories are an indexed_store sorted by frequency, bandwidth, mode
+// and tag.  A memory's id is not reused until the bank is cleared.
+//
+// The browser shows the memories passing the filter in the order of
+// the selected index.  Changes made on the thread that attached the
+// browser insert, replace or remove single rows; changes made by other
+// threads (the xmlrpc server) only update the store and ask the main
+// thread to rebuild the browser, once for any number of changes.
+//----------------------------------------------------------------------
+
+struct MEMORY {
+	unsigned long long freq;
+	int  imode;
+	int  iBW;
+	std::string tag;
+	bool deleted;
+
+	MEMORY(unsigned long long f = 0, int m = 0, int bw = 0, std::string t = "") :
+		freq(f), imode(m), iBW(bw), tag(t), deleted(false) {}
+
+	static int compare(const MEMORY &a, const MEMORY &b, int column);
+};
+
+// browser filter
+//   ""             all memories
+//   "20m", "70cm"  memories in an amateur band
+//   "7000-7050"    memories between two frequencies in kHz
+//   anything else  memories whose tag contains the text, ignoring case
+struct MEM_FILTER {
+	unsigned long long lo, hi;			// range in Hz, hi == 0 if none
+	std::string text;
+
+	MEM_FILTER() : lo(0), hi(0) {}
+	void parse(const std::string &spec);
+	bool match(const MEMORY &m) const;
+	bool empty() const { return !hi && text.empty(); }
+};
+
+// browser line of a memory
+typedef std::string (*MEM_FORMAT)(const MEMORY &m);
+
+class MEM_BANK : private indexed_store<MEMORY> {
+public:
+	enum { BY_FREQ, BY_BW, BY_MODE, BY_TAG, NSORTS };
+
+	MEM_BANK();
+	~MEM_BANK();
+
+	void attach(Fl_Browser *b, MEM_FORMAT f);
+
+// store, any thread
+	void clear();
+	int  add(const MEMORY &m);
+	void add(const std::vector<MEMORY> &list);
+	bool remove(unsigned long long freq, int imode);
+	void remove(int id);
+	void retag(int id, const std::string &tag);
+	int  find(unsigned long long freq, int imode);
+	bool get(int id, MEMORY &m);
+	void query(unsigned long long lo, unsigned long long hi, std::vector<MEMORY> &list);
+	void list(std::vector<MEMORY> &list, int by = BY_FREQ);
+	size_t size();
+
+// browser, main thread
+	void sort(int by);
+	void filter(const std::string &spec);
+	int  id(int line);
+	int  line(int id);
+	void refresh();
+
+	static bool band(const std::string &name, unsigned long long &lo, unsigned long long &hi);
+
+private:
+	struct BELOW {
+		const MEM_BANK *bank;
+		BELOW(const MEM_BANK *b) : bank(b) {}
+		bool operator()(int id, unsigned long long freq) const;
+	};
+
+	int sortby;
+	MEM_FILTER shown_filter;
+	std::vector<int> shown;				// memory id of each browser line
+	Fl_Browser *browser;
+	MEM_FORMAT format;
+	pthread_t  ui_thread;
+	bool refresh_pending;
+
+	pthread_mutex_t mutex;
+
+	int  lookup(unsigned long long freq, int imode);
+	void schedule();
+	bool incremental();
+	void show_add(int id);
+	void show_remove(int id);
+	void fill();
+
+	static void refresh_cb(void *);
+};
+
+extern MEM_BANK mem_bank;
+
+#endif
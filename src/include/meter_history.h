@@ -0,0 +1,87 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef METER_HISTORY_H
+#define METER_HISTORY_H
+
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------
+// Meter history
+//
+// Every meter reading made by the poll loop is kept in fixed size
+// rings, one set per meter, at three resolutions:
+//
+//   raw      the readings themselves, the last METER_RAW_SIZE
+//   1 sec    min / avg / max of each second, the last hour
+//   1 min    min / avg / max of each minute, the last day
+//
+// A reading is folded into the open second, and each closed second
+// into the open minute, so recording costs a few compares and adds and
+// the memory in use never grows.  Seconds and minutes with no reading
+// (a transmit meter while receiving) are absent, not zero.
+//
+// Values are in the units of the panel meters: S-meter, SWR and ALC on
+// the 0..100 bar scale, power in watts, IDD in amps, supply in volts.
+//----------------------------------------------------------------------
+
+enum {
+	MTR_SMETER,
+	MTR_POWER,
+	MTR_SWR,
+	MTR_ALC,
+	MTR_IDD,
+	MTR_VOLTS,
+	METERS
+};
+
+enum { MTR_RAW, MTR_SECOND, MTR_MINUTE, MTR_RESOLUTIONS };
+
+#define METER_RAW_SIZE     600
+#define METER_SECOND_SIZE  3600
+#define METER_MINUTE_SIZE  1440
+
+struct METER_POINT {
+	double t;			// seconds since the epoch, start of the interval
+	float min;
+	float avg;
+	float max;
+};
+
+// name of a meter, "smeter", "power", "swr", "alc", "idd", "volts"
+extern const char *meter_name(int meter);
+// meter by name, -1 if not known
+extern int meter_index(const std::string &name);
+// resolution by name, "raw", "sec" or "min", -1 if not known
+extern int meter_resolution(const std::string &name);
+
+extern void meter_record(int meter, double value);
+
+// points later than 'since', oldest first; the second or minute still
+// being filled is the last point
+extern void meter_history(int meter, int resolution, double since,
+	std::vector<METER_POINT> &points);
+
+extern void meter_history_clear();
+
+extern void open_meter_window();
+
+#endif
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef POLL_SCHEDULER_H
+#define POLL_SCHEDULER_H
+
+#include <string>
+#include <vector>
+
+#include "tod_clock.h"
+
+//----------------------------------------------------------------------
+// Poll scheduler used by serial_thread_loop
+//
+// Each POLL_PAIR carries a target refresh period expressed in multiples
+// of the poll interval (progStatus.serloop_timing).  A period of 0 marks
+// a "fill" entry which is only serviced with bus time left over after
+// all periodic entries have met their deadline.
+//
+// The cost of every entry is measured (exponentially weighted average of
+// the wall time spent in the read function) and each cycle is given a
+// bus time budget, so that the total CAT traffic matches the legacy
+// round robin while the fast changing values get the larger share.
+//
+// Fill entries may supply a probe returning the control state held in
+// progStatus.  When the probe reports the same value for POLL_STABLE_READS
+// consecutive reads the entry is backed off exponentially, to at most
+// 2^POLL_MAX_BACKOFF poll intervals.  A change seen by the read, a write
+// from the UI or XmlRpc (detected as a probe change between reads) or a
+// call to poll_wakeup() restores the full rate.
+//
+// For transceivers with rigbase::can_pipeline set, the queries of the
+// periodic entries planned for a cycle are written in a single batch
+// ahead of servicing them (see rigbase::pipeline).
+//
+// When the transceiver pushes its status (auto information, CI-V
+// transceive) the entries it covers drop to a heartbeat of POLL_HEARTBEAT
+// times their period, and each report received makes the entry it answers
+// due at once, its reply already waiting in the pipeline.  The heartbeat
+// rate applies only once a report has been received: CI-V transceive is
+// a menu setting the transceiver may have turned off.
+//----------------------------------------------------------------------
+
+enum { POLL_FAST = 1, POLL_MEDIUM = 4, POLL_FILL = 0 };
+
+#define POLL_STABLE_READS 3
+#define POLL_MAX_BACKOFF  5
+#define POLL_HEARTBEAT    16
+
+struct POLL_PAIR {
+	int *poll;
+	void (*pollfunc)();
+	std::string name;
+	int period;			// target period in poll intervals, 0 == fill
+	long (*probe)();	// current control value, NULL == no backoff
+// run time data, maintained by the scheduler
+	ullint due;			// deadline, msec
+	ullint last;		// time of last poll, msec
+	double cost;		// average time to service, msec
+	unsigned long count;
+	long value;			// probe value after the last read
+	int  stable;		// consecutive reads returning the same value
+	int  backoff;		// current backoff exponent
+	volatile int wake;	// wakeup() request, applied by the poll thread
+};
+
+class RADIO;
+
+class poll_scheduler {
+public:
+// radio: the radio polled, NULL for radio 0
+	poll_scheduler(POLL_PAIR *table, int slots, RADIO *radio = NULL);
+	~poll_scheduler();
+
+	void reset();
+	int  run_cycle();
+	void wakeup(void (*func)());
+	bool polls(RADIO *r) { return radio == r; }
+
+	void set_push(bool on) { pushing = on; heard = false; }
+	int  push(std::vector<std::string> &frames);
+
+private:
+	POLL_PAIR *pairs;
+	int nslots;
+	RADIO *radio;
+	bool pushing;
+	bool heard;			// a pushed report has been received
+	bool backed_off(POLL_PAIR *pp, ullint now);
+	double default_cost();
+	double cycle_budget();
+	void service(POLL_PAIR *pp);
+	void prefetch(ullint now, ullint horizon, double budget);
+};
+
+// restore full poll rate for every entry serviced by func on the
+// schedulers of the calling thread's radio
+extern void poll_wakeup(void (*func)());
+
+#endif
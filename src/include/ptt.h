@@ -29,7 +29,7 @@
 
 enum {PTT_NONE, PTT_BOTH, PTT_SET, PTT_GET};
 
-extern void rigPTT(bool);
+extern bool rigPTT(bool);
 extern bool ptt_state();
 
 #endif
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef QSO_LOG_H
+#define QSO_LOG_H
+
+#include <string>
+#include <vector>
+#include <stdio.h>
+
+#include <FL/Fl_Browser.H>
+
+#include "indexed_store.h"
+
+//----------------------------------------------------------------------
+// CW / FSK logbook store
+//
+// The QSO records are an indexed_store sorted by date/time, frequency,
+// call and serial number.
+//
+// The log file is the tab separated text the logbooks have always
+// written.  Each change is appended to a journal, <log file>.jnl, as it
+// is made and the log file is only rewritten by save(), which empties
+// the journal.  load() replays the journal of a log that was not saved.
+//----------------------------------------------------------------------
+
+struct QSO_RECORD {
+	std::string date;		// YYYYMMDD
+	std::string time;		// HHMM
+	std::string freq;		// as entered
+	std::string call;
+	std::string name;
+	std::string rst_in;
+	std::string rst_out;
+	int         nbr;		// serial number sent
+	std::string xchg;		// exchange / notes
+
+	double      mhz;		// freq as a number, for sorting
+	bool        deleted;
+
+	QSO_RECORD() : nbr(0), mhz(0), deleted(false) {}
+
+	std::string line() const;
+	bool parse(const std::string &line);
+	static int compare(const QSO_RECORD &a, const QSO_RECORD &b, int column);
+};
+
+class QSO_LOG : private indexed_store<QSO_RECORD> {
+public:
+	enum { BY_DATETIME, BY_FREQ, BY_CALL, BY_NBR, NSORTS };
+
+	QSO_LOG(const char *mode);
+	~QSO_LOG();
+
+	void attach(Fl_Browser *b) { browser = b; }
+
+	void clear();
+	void file(const std::string &fname);
+	bool load(const std::string &fname);
+	bool save(const std::string &fname);
+
+	void add(const QSO_RECORD &rec);
+	void replace(int line, const QSO_RECORD &rec);
+	void remove(int line);
+	const QSO_RECORD &entry(int line) const;
+
+	void sort(int column);
+
+	bool export_adif(const std::string &fname);
+	int  import_adif(const std::string &fname);
+
+	size_t size() const { return shown.size(); }
+
+	bool changed;
+
+private:
+	std::string mode;					// ADIF MODE, "CW" or "RTTY"
+	int dir[NSORTS];
+	std::vector<int> shown;				// record id of each browser line
+	Fl_Browser *browser;
+
+	std::string fname;
+	FILE *journal;
+	bool  journal_new;					// start a new journal on the next change
+
+	int  append(const QSO_RECORD &rec);
+	void show();
+	void journal_write(const std::string &entry, bool flush = true);
+	void journal_close();
+	long snapshot_size();
+};
+
+#endif
@@ -0,0 +1,166 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef RADIO_H
+#define RADIO_H
+
+#include <string>
+#include <pthread.h>
+
+class rigbase;
+class Cserial;
+class poll_scheduler;
+struct POLL_PAIR;
+
+//----------------------------------------------------------------------
+// Radios
+//
+// The transceiver selected on the panel is radio 0.  It keeps the
+// globals selrig, RigSerial, vfoA / vfoB, mutex_serial and the serial
+// thread loop.  Further radios are listed in RigHomeDir/radios, one
+// per line, and are started with the panel:
+//
+//     # transceiver     port            baud
+//     "IC-735"          /dev/ttyUSB1    9600
+//
+// Each of them owns a driver instance, its serial port, a
+// serial mutex, a poll scheduler and its state, and polls frequency,
+// mode, S-meter and PTT on a thread of its own, in parallel with
+// radio 0 and with each other.
+//
+// The CAT i/o layer (rig_io, rigbase, ICbase, poll_scheduler) reaches
+// the driver, port, mutexes and reply buffer through the rig_ accessors
+// below.  They return those of the radio the calling thread works for,
+// set for the life of a radio's poll thread or for the scope of a
+// radio_lock, and those of radio 0 otherwise.  Radios other than 0 are
+// connected by serial port only; tcp/ip, XmlRpc and TCI are radio 0's.
+//
+// A radio's driver is built by new_rig (rigs.cxx), which only knows the
+// drivers that keep their state to themselves: FT-736R, FT-747,
+// FT-757GX2, FT-767, FT-847, FT-920, FT-990, FT-990A, IC-728, IC-735,
+// IC-751, IC-R71, TMD710 and OMNI-VI.  The others use the panel's vfo
+// state or widgets and are refused.
+//
+// A radio's driver is built and initialized on the main thread.  The
+// mode, bandwidth and label tables in use are members of the driver
+// instance; the driver's own source tables are filled once and then
+// only read, so two radios of the same model share them safely.
+//
+// PTT is interlocked: a radio is not keyed while another transmits.
+// The check, the keying and radio_ptt_keyed are made holding
+// mutex_ptt_interlock, by rigPTT for radio 0 and radio.set_ptt for the
+// others.  It is taken after the radio's serial mutex and nothing is
+// locked while it is held, so the radios' i/o never waits on each other
+// through it.
+//----------------------------------------------------------------------
+
+#define MAX_RADIOS 8
+
+struct RADIO_STATE {
+	bool online;
+	unsigned long long freq;
+	int imode;
+	int smeter;
+	bool ptt;
+};
+
+class RADIO {
+public:
+	RADIO(int id, std::string model, std::string port, int baud);
+	~RADIO();
+
+	bool start();
+	void stop();
+
+	RADIO_STATE state();
+	void update(const RADIO_STATE &st);
+
+	int id;
+	std::string model;
+	std::string port;
+	int baud;
+
+	rigbase *rig;
+	Cserial *serial;
+	pthread_mutex_t mutex_serial;
+	pthread_mutex_t mutex_replystr;
+	std::string respstr;
+
+	poll_scheduler *scheduler;
+	POLL_PAIR *poll_pairs;
+	int poll_on;
+
+	bool running;
+	pthread_t thread;
+
+private:
+	pthread_mutex_t mutex_state;
+	RADIO_STATE st;
+	bool setup();
+	static void *poll_loop(void *);
+};
+
+// radio i/o scope: the calling thread works for 'radio' and holds its
+// serial mutex; radio 0 is taken as mutex_serial.  A radio not in use
+// is not locked and ok() is false.
+class radio_lock {
+public:
+	radio_lock(int radio, const char *name = "radio");
+	~radio_lock();
+	bool ok() { return mutex != NULL; }
+	RADIO *radio() { return current; }
+private:
+	RADIO *current;
+	RADIO *previous;
+	pthread_mutex_t *mutex;
+};
+
+// read RigHomeDir/radios and start the radios listed
+extern void radios_start();
+// deletes the radios; called once exit_server has stopped the XmlRpc
+// workers that serve the radio.* methods
+extern void radios_stop();
+
+// radios, including radio 0
+extern int radio_count();
+// radio 'id', NULL for radio 0 or an id not in use
+extern RADIO *radio_get(int id);
+
+extern pthread_mutex_t mutex_ptt_interlock;
+
+// is a radio other than 'id' transmitting, keyed by flrig or found
+// keyed by its poll; caller holds mutex_ptt_interlock
+extern bool radio_ptt_locked(int id);
+
+// radio 'id' has been keyed or unkeyed; caller holds mutex_ptt_interlock
+extern void radio_ptt_keyed(int id, bool on);
+
+// for the calling thread's radio, rig_radio is NULL for radio 0
+extern RADIO *rig_radio();
+extern rigbase *rig_driver();
+extern Cserial *rig_port();
+extern pthread_mutex_t *rig_serial_mutex();
+extern pthread_mutex_t *rig_reply_mutex();
+extern std::string &rig_respstr();
+extern bool rig_tcpip();
+extern bool rig_xmlrpc();
+extern bool rig_tci();
+
+#endif
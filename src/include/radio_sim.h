@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef RADIO_SIM_H
+#define RADIO_SIM_H
+
+#include <string>
+#include <map>
+
+//----------------------------------------------------------------------
+// Simulated transceiver for exercising the CAT code without hardware
+//
+// RADIO_SIM answers Kenwood ASCII, Yaesu ASCII or Icom CI-V commands
+// from a small state table.  serve() runs it on the master side of a
+// pty; flrig opens the slave as its transceiver serial port, so the
+// real serial thread and rig classes are exercised.  Replies are paced
+// at the configured baud rate, after a turnaround delay plus a random
+// jitter.
+//
+// Commands not in the state table are remembered when set and echoed
+// back when read, so most rig classes work without special cases;
+// reads of never set values answer "?;" or NG, as a radio would.
+//----------------------------------------------------------------------
+
+enum { SIM_KENWOOD, SIM_YAESU, SIM_ICOM };
+
+struct SIM_STATS {
+	unsigned long commands;
+	unsigned long replies;
+	unsigned long bytes_in;
+	unsigned long bytes_out;
+};
+
+class RADIO_SIM {
+public:
+	RADIO_SIM(int dialect);
+
+	int  baud;			// reply pacing, 0 for none
+	int  turnaround;	// msec from command to reply
+	int  jitter;		// msec, random 0 .. jitter added to turnaround
+	bool echo;			// CI-V bus echo of each command
+	int  civ_addr;		// CI-V address of the simulated radio
+	std::string id;		// answer to ID / 19 00
+
+	SIM_STATS stats;
+
+// create a pty; returns the master fd and the slave device name
+	static int open_pty(std::string &slave);
+
+// answer commands on 'fd' until 'run' is cleared
+	void serve(int fd, volatile bool &run);
+
+// remove one complete command from the front of 'in'
+	bool extract(std::string &in, std::string &cmd);
+
+// the reply to one complete command, empty if none
+	std::string respond(const std::string &cmd);
+
+	void seed(unsigned int s) { rnd = s; }
+
+private:
+	int dialect;
+	bool ptt;
+	int  ctrl_addr;
+	unsigned int rnd;
+	std::map<std::string, std::string> values;
+
+	unsigned int random(unsigned int range);
+	std::string get(const std::string &key);
+
+	std::string ascii_reply(const std::string &cmd);
+	std::string ascii_info();
+	std::string civ_reply(const std::string &cmd);
+	std::string civ_frame(const std::string &data);
+
+	void wait_msec(double msec);
+	void send_paced(int fd, const std::string &reply);
+};
+
+#endif
@@ -28,6 +28,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <vector>
+#include <map>
 #include <iostream>
 
 #include <FL/Fl.H>
@@ -39,7 +40,9 @@
 
 #include "rigpanel.h"
 
-#define VECTOR(a,b) { a.clear(); for (size_t n = 0; n < sizeof(b)/sizeof(*b); n++) {a.push_back(b[n]);} }
+// a driver's source tables are filled once and only read after that, so
+// two instances of a driver, each on its own radio, can share them
+#define VECTOR(a,b) { if (a.empty()) for (size_t n = 0; n < sizeof(b)/sizeof(*b); n++) {a.push_back(b[n]);} }
 
 enum {onNIL, onA, onB};
 enum {UI, XML, SRVR, RIG};
@@ -180,26 +183,29 @@ class rigbase {
 #define WVALS_LIMIT -1
 public:
 	std::string name_;
-	static std::vector<std::string>& modes_;// = vNOMODES;
-	static std::vector<std::string>& bandwidths_;// = vNOBWS;
-	static std::vector<std::string>& dsp_SL;// = vDSPLO;
+// the tables in use, copied from the driver's source tables by the
+// constructor, initialize() and adjust_bandwidth(); each instance has
+// its own, a driver on another radio changes them on its own thread
+	std::vector<std::string> modes_;
+	std::vector<std::string> bandwidths_;
+	std::vector<std::string> dsp_SL;
 
 	const char *  SL_tooltip;
 	const char *  SL_label;
-	static std::vector<std::string>& dsp_SH;// = vDSPHI;
+	std::vector<std::string> dsp_SH;
 	const char *  SH_tooltip;
 	const char *  SH_label;
 	const int  * bw_vals_;
 
 // other labeled control values
-	static std::vector<std::string>& agc_labels_;
-	static std::vector<std::string>& att_labels_;
-	static std::vector<std::string>& pre_labels_;
-	static std::vector<std::string>& nb_labels_;
-	static std::vector<std::string>& nr_labels_;
-	static std::vector<std::string>& bk_labels_;
-	static std::vector<std::string>& m60_labels_;
-	static std::vector<std::string>& an_labels_;
+	std::vector<std::string> agc_labels_;
+	std::vector<std::string> att_labels_;
+	std::vector<std::string> pre_labels_;
+	std::vector<std::string> nb_labels_;
+	std::vector<std::string> nr_labels_;
+	std::vector<std::string> bk_labels_;
+	std::vector<std::string> m60_labels_;
+	std::vector<std::string> an_labels_;
 
 	GUI *widgets;
 
@@ -348,6 +354,14 @@ public:
 
 	bool can_synch_clock;
 
+// ';' terminated ASCII queries may be sent several to a single write
+	bool can_pipeline;
+
+// transceiver can send unsolicited status (auto information / transceive)
+	bool can_push;
+// ... and has been told to, see set_push in support.cxx
+	bool pushing;
+
 	bool has_voltmeter;
 
 // Icom Xcvr 
@@ -376,6 +390,11 @@ protected:
 	std::string cmd; // command string
 	std::string rsp; // expected response string (header etc)
 
+// replies received by pipeline(), keyed by query, consumed by wait_char
+	std::map<std::string, std::string> pipeline_replies;
+	bool pipeline_hit(const char *sz);
+	std::string push_stream;
+
 	std::string to_bcd_be(unsigned long long val, int len);
 	std::string to_bcd(unsigned long long val, int len);
 	unsigned long long fm_bcd (std::string bcd, int len);
@@ -431,18 +450,18 @@ public:
 	virtual int  adjust_bandwidth(int m) {return 0;}
 	virtual int  def_bandwidth(int m) {return 0;}
 
-	virtual std::vector<std::string>&bwtable(int m) {return vNOBWS;}
-	virtual std::vector<std::string>&lotable(int m) {return vDSPLO;}
-	virtual std::vector<std::string>&hitable(int m) {return vDSPHI;}
+	virtual std::vector<std::string>&bwtable(int m) {return bandwidths_;}
+	virtual std::vector<std::string>&lotable(int m) {return dsp_SL;}
+	virtual std::vector<std::string>&hitable(int m) {return dsp_SH;}
 
-	virtual std::vector<std::string>&agctable(int m) {return vAGC_LABELS;}
-	virtual std::vector<std::string>&atttable(int m) {return vATT_LABELS;}
-	virtual std::vector<std::string>&pretable(int m) {return vPRE_LABELS;}
-	virtual std::vector<std::string>&nbtable(int m)  {return vNB_LABELS;}
-	virtual std::vector<std::string>&nrtable(int m)  {return vNR_LABELS;}
-	virtual std::vector<std::string>&bktable(int m)  {return vBK_LABELS;}
-	virtual std::vector<std::string>&m60table(int m) {return v60M_LABELS;}
-	virtual std::vector<std::string>&antable(int m)  {return vAN_LABELS;}
+	virtual std::vector<std::string>&agctable(int m) {return agc_labels_;}
+	virtual std::vector<std::string>&atttable(int m) {return att_labels_;}
+	virtual std::vector<std::string>&pretable(int m) {return pre_labels_;}
+	virtual std::vector<std::string>&nbtable(int m)  {return nb_labels_;}
+	virtual std::vector<std::string>&nrtable(int m)  {return nr_labels_;}
+	virtual std::vector<std::string>&bktable(int m)  {return bk_labels_;}
+	virtual std::vector<std::string>&m60table(int m) {return m60_labels_;}
+	virtual std::vector<std::string>&antable(int m)  {return an_labels_;}
 
 	virtual const char *FILT(int val) { return "1"; }
 	virtual const char *nextFILT() { return "1";}
@@ -660,7 +679,7 @@ int rfg_;
 	virtual const char * get_bwname_(int bw, int md) {
 // read bw based on mode
 		try {
-			static std::vector<std::string>& pbwt = bwtable(md);
+			std::vector<std::string>& pbwt = bwtable(md);
 			return pbwt.at(bw).c_str();
 		} catch (const std::exception& e) {
 			LOG_ERROR("%s", e.what());
@@ -806,6 +825,30 @@ double vfo_;
 	int wait_string(std::string sz, int nr, int timeout = 100, int pr = ASC);
 	int waitfor(int nr, int timeout = 100, int pr = ASC);
 
+// pipelined polling (Kenwood / Yaesu ASCII)
+// pipeline_query returns the queries made by the named poll entry,
+// e.g. "FA;" for "FREQ", or an empty string if not pipelined
+	virtual std::string pipeline_query(std::string poll_name) { return ""; }
+	virtual int  pipeline(std::string queries, int timeout = 100);
+	void pipeline_flush();
+
+// unsolicited status; push_mode turns the transceiver reports on or off,
+// push_read collects the complete frames waiting at the port and
+// push_match returns the push_query entry answered by a frame,
+// translating the frame to the form of that query's reply.
+// push_query lists every query whose report concerns the poll entry,
+// pipeline_query only those it makes in the current state.
+	virtual void push_mode(bool on) {}
+	virtual std::string push_query(std::string poll_name) {
+		return pipeline_query(poll_name);
+	}
+	virtual bool push_covers(std::string poll_name) {
+		return poll_name == "FREQ" || poll_name == "MODE";
+	}
+	virtual std::string push_match(std::string &frame, std::string queries);
+	int  push_read(std::vector<std::string> &frames);
+	void push_reply(std::string query, std::string frame);
+
 // IC-7610
 	virtual void set_digi_sel(bool) {}
 	virtual void set_digi_val(int) {}
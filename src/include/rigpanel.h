@@ -487,6 +487,7 @@ extern Fl_Button *btnClearList;
 extern Fl_Browser2 *FreqSelect;
 
 extern Fl_Input *inAlphaTag;
+extern Fl_Input *inMemFilter;
 
 extern Fl_ComboBox *selectRig;
 
@@ -597,6 +598,8 @@ extern Fl_Check_Button *poll_tuner;
 extern Fl_Check_Button *poll_break_in;
 extern Fl_Button *btnClearAddControls;
 extern Fl_Check_Button *poll_all;
+extern Fl_Check_Button *poll_backoff;
+extern Fl_Check_Button *poll_push;
 extern Fl_Button *btnSetAllAdd;
 extern Fl_Check_Button *disable_polling;
 extern Fl_Check_Button *disable_xmlrpc;
@@ -245,4 +245,7 @@ extern RIG_TRUSDX		rig_trusdx;		// 109
 extern RIG_SmartSDR     rig_smartsdr;   // 110
 extern RIG_IC7760	rig_IC7760; // 111
 
+// a new driver instance for the named transceiver, see radio.h
+extern rigbase *new_rig(std::string name);
+
 #endif
@@ -83,6 +83,7 @@ public:
 	int  Stopbits() { return stopbits;}
 
 	int  ReadBuffer (std::string &buffer, int nbr, std::string find1 = "", std::string find2 = "");
+	bool InputWaiting(int msec);
 	int  WriteBuffer(const char *str, int nbr);
 	bool WriteByte(char bybyte);
 	void FlushBuffer();
@@ -159,6 +160,7 @@ public:
 	DWORD GetBytesWritten();
 
 	int  ReadBuffer (std::string &buffer, int nbr, std::string find1 = "", std::string find2 = "");
+	bool InputWaiting(int msec);
 	int WriteBuffer(const char *str, int nbr);
 
 	bool SetCommunicationTimeouts(DWORD ReadIntervalTimeout,DWORD ReadTotalTimeoutMultiplier,DWORD ReadTotalTimeoutConstant,DWORD WriteTotalTimeoutMultiplier,DWORD WriteTotalTimeoutConstant);
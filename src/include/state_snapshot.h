@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef STATE_SNAPSHOT_H
+#define STATE_SNAPSHOT_H
+
+#include "rigbase.h"
+
+//----------------------------------------------------------------------
+// Transceiver state snapshot read by the XmlRpc server
+//
+// The serial thread publishes a copy of the vfo, split, PTT and meter
+// state after every poll cycle; XmlRpc writes, serviceA / serviceB and
+// the commands run by the CAT executor publish on completion.
+// Readers copy the snapshot under a sequence lock: they never block and
+// never touch the transceiver.  'version' increments whenever anything
+// other than the meter readings changes, and wait_state() lets a reader
+// block until it does.
+//----------------------------------------------------------------------
+
+struct RIG_SNAPSHOT {
+	unsigned long version;
+	int  online;
+	XCVR_STATE A;
+	XCVR_STATE B;
+	int  inuse;
+	int  split;
+	int  ptt;
+	double smeter;
+	double pout;
+	double swr;
+	double alc;
+};
+
+extern void publish_state();
+extern void read_state(RIG_SNAPSHOT &snap);
+extern unsigned long state_version();
+extern bool wait_state(unsigned long since, RIG_SNAPSHOT &snap, int msec);
+
+// publishes the state when it goes out of scope
+class state_publisher {
+public:
+	state_publisher() {}
+	~state_publisher() { publish_state(); }
+};
+
+#endif
@@ -128,6 +128,8 @@ struct status {
 	int		poll_ptt;
 	int		poll_break_in;
 	int		poll_all;
+	int		poll_backoff;
+	int		poll_push;
 
 	int		iBW_A;
 	int		imode_A;
@@ -471,6 +473,8 @@ struct status {
 	bool	tcitrace;
 	bool	start_stop_trace;
 	int		rpc_level;
+	bool	cat_capture;
+	int		cat_capture_size;	// MB
 
 // bands; defaults for FT857 / FT897 / Xiegu-G90
 // frequency, mode, txCTCSS, rxCTCSS, offset, offset_freq;
@@ -554,6 +558,7 @@ struct status {
 	int  fsk_log_nbr;
 
 	int		display_voltmeter;
+	int		ui_refresh_rate;	// meter / display frames per second
 
 //----------------------------------------------------------------------
 // UI scheme items
@@ -86,8 +86,6 @@
 #include <FL/fl_ask.H>
 
 
-#define LISTSIZE 500
-#define ATAGSIZE 128 //21
 
 float interpolate(float raw, const std::vector< std::vector< float > > & table);
 
@@ -164,6 +162,7 @@ extern void addFreq();
 extern void delFreq();
 extern void buildlist();
 extern void clearList();
+extern void memory_filter();
 extern void saveFreqList();
 extern void readList();
 extern void selectFreq();
@@ -121,6 +121,10 @@ bool thread_in_list(int id, const int* list);
 #endif
 
 /// This ensures that a mutex is always unlocked when leaving a function or block.
+/// The wait for and hold time of the named mutexes are kept in the latency
+/// statistics, see cat_stats.h
+
+struct STATS_ENTRY;
 
 class guard_lock
 {
@@ -133,6 +137,8 @@ private:
 	pthread_mutex_t* mutex;
 	std::string how;
 	long int start_time;
+	unsigned long long locked;
+	STATS_ENTRY *hold;
 //	int how;
 };
 
@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#ifndef UI_REFRESH_H
+#define UI_REFRESH_H
+
+//----------------------------------------------------------------------
+// frame paced display refresh
+//
+// The poll, XmlRpc and keying threads store a new meter reading, PTT
+// state or vfo frequency and then mark the matching display item dirty.
+// Marking is a bit set and, for the first mark after a frame, a single
+// Fl::awake.  The UI thread applies every pending item in one frame,
+// at most progStatus.ui_refresh_rate frames per second, so a burst of
+// readings costs one redraw of each widget instead of one callback per
+// reading in the awake queue.
+//----------------------------------------------------------------------
+
+enum {
+	UI_PTT		= 1 << 0,	// update_UI_PTT
+	UI_XMT_ZERO	= 1 << 1,	// zeroXmtMeters
+	UI_SMETER	= 1 << 2,	// updateSmeter
+	UI_PWR		= 1 << 3,	// updateFwdPwr
+	UI_SWR		= 1 << 4,	// updateSWR
+	UI_ALC		= 1 << 5,	// updateALC
+	UI_IDD		= 1 << 6,	// updateIDD
+	UI_VMETER	= 1 << 7,	// updateVmeter
+	UI_FREQ_A	= 1 << 8,	// setFreqDispA
+	UI_FREQ_B	= 1 << 9	// setFreqDispB
+};
+
+// mark display items dirty; callable from any thread
+extern void ui_mark(unsigned long what);
+
+// take the pending marks without drawing them, for a caller running
+// without the user interface; returns the marks taken
+extern unsigned long ui_take();
+
+#endif
@@ -43,6 +43,9 @@ public:
 	void set_vfoB(unsigned long long);
 
 	bool twovfos() { return true; }
+
+	std::string pipeline_query(std::string poll_name);
+	void push_mode(bool on);
 	bool canswap() { return true; }
 	void selectA();
 	void selectB();
@@ -43,6 +43,10 @@ public:
 	virtual void set_vfoB(unsigned long long);
 
 	virtual bool twovfos();
+
+	std::string pipeline_query(std::string poll_name);
+	void push_mode(bool on);
+
 	virtual void selectA();
 	virtual void selectB();
 	virtual void A2B();
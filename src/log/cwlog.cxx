@@ -0,0 +1,324 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2022
+//              David Freese, W1HKJ
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include "config.h"
+#include "compat.h" // Must precede all FL includes
+
+#include <FL/Fl.H>
+#include <FL/fl_ask.H>
+#include <FL/Fl_Native_File_Chooser.H>
+
+#include <string>
+
+#include "status.h"
+#include "support.h"
+#include "qso_log.h"
+
+#include "cwioUI.h"
+#include "cwlog.h"
+
+// =====================================================================
+// cwlogbook support code
+// =====================================================================
+
+static QSO_LOG cw_log("CW");
+
+bool cwlog_editing = false;
+int  cwlog_edit_nbr = 0;
+
+bool cwlog_is_open = false;
+
+void cwlog_set_edit(bool on)
+{
+	cwlog_editing = on;
+	if (on) {
+		btn_cwlog_edit_entry->label("Delete");
+		btn_cwlog_edit_entry->redraw_label();
+		btn_cwlog_clear_qso->label("Cancel");
+		btn_cwlog_clear_qso->redraw_label();
+	} else {
+		btn_cwlog_edit_entry->label("Edit");
+		btn_cwlog_edit_entry->redraw_label();
+		btn_cwlog_clear_qso->label("Clear");
+		btn_cwlog_clear_qso->redraw_label();
+	}
+}
+
+void cwlog_sort_by_datetime() {
+	if (cwlog_editing) return;
+	cw_log.sort(QSO_LOG::BY_DATETIME);
+}
+
+void cwlog_sort_by_freq() {
+	if (cwlog_editing) return;
+	cw_log.sort(QSO_LOG::BY_FREQ);
+}
+
+void cwlog_sort_by_call() {
+	if (cwlog_editing) return;
+	cw_log.sort(QSO_LOG::BY_CALL);
+}
+
+void cwlog_sort_by_nbr() {
+	if (cwlog_editing) return;
+	cw_log.sort(QSO_LOG::BY_NBR);
+}
+
+void cwlog_clear_qso()
+{
+	cw_qso_date->value("");
+	cw_qso_time->value("");
+	cw_freq->value("");
+	cw_op_call->value("");
+	cw_op_name->value("");
+	cw_rst_in->value("");
+	cw_rst_out->value("");
+	cw_xchg_in->value("");
+
+	if (cwlog_editing)
+		cwlog_set_edit(false);
+
+}
+
+static QSO_RECORD cwlog_entry()
+{
+	QSO_RECORD rec;
+	rec.date = cw_qso_date->value();
+	rec.time = cw_qso_time->value();
+	rec.freq = cw_freq->value();
+	rec.call = cw_op_call->value();
+	rec.name = cw_op_name->value();
+	rec.rst_in = cw_rst_in->value();
+	rec.rst_out = cw_rst_out->value();
+	rec.nbr = (int)cw_log_nbr->value();
+	rec.xchg = cw_xchg_in->value();
+	return rec;
+}
+
+void cwlog_save_qso()
+{
+	if (cwlog_editing) {
+		cw_log.replace(cwlog_edit_nbr, cwlog_entry());
+		brwsr_cwlog_entries->select(cwlog_edit_nbr);
+		cwlog_set_edit(false);
+	} else
+		cw_log.add(cwlog_entry());
+}
+
+void cwlog_delete_entry()
+{
+	cw_log.remove(cwlog_edit_nbr);
+	brwsr_cwlog_entries->select(cwlog_edit_nbr, false);
+	brwsr_cwlog_entries->redraw();
+	cwlog_clear_qso();
+}
+
+void cwlog_edit_entry()
+{
+	if (cwlog_editing) {
+		cwlog_delete_entry();
+		return;
+	}
+
+	cwlog_edit_nbr = brwsr_cwlog_entries->value();
+	if (!cwlog_edit_nbr) return;
+
+	cwlog_clear_qso();
+	const QSO_RECORD &rec = cw_log.entry(cwlog_edit_nbr);
+
+	cw_qso_date->value(rec.date.c_str());
+	cw_qso_time->value(rec.time.c_str());
+	cw_freq->value(rec.freq.c_str());
+	cw_op_call->value(rec.call.c_str());
+	cw_op_name->value(rec.name.c_str());
+	cw_rst_in->value(rec.rst_in.c_str());
+	cw_rst_out->value(rec.rst_out.c_str());
+	cw_log_nbr->value(rec.nbr);
+	cw_xchg_in->value(rec.xchg.c_str());
+
+	cwlog_set_edit(true);
+}
+
+void cwlog_view()
+{
+	if (!cwlog_viewer) {
+		cwlog_viewer = new_cwlogbook_dialog();
+		cw_log.attach(brwsr_cwlog_entries);
+		if (!progStatus.cw_log_name.empty()) {
+			txt_cwlog_file->value(progStatus.cw_log_name.c_str());
+			cwlog_load();
+		} else
+			cwlog_open();
+	}
+	cwlog_viewer->show();
+}
+
+void cwlog_save()
+{
+	if (progStatus.cw_log_name.empty())
+		return;
+	if (!cw_log.save(progStatus.cw_log_name))
+		fl_message ("Could not write to %s", progStatus.cw_log_name.c_str());
+}
+
+void cwlog_load()
+{
+	if (!cw_log.load(progStatus.cw_log_name)) return;
+	cwlog_is_open = true;
+}
+
+void cwlog_save_as()
+{
+// Create and post the local native file chooser
+	Fl_Native_File_Chooser fnfc;
+	fnfc.title("Save As log file");
+	fnfc.type(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
+	fnfc.options(Fl_Native_File_Chooser::SAVEAS_CONFIRM);
+	fnfc.filter("CW Log\t*.txt");
+// default directory to use
+	fnfc.directory(RigHomeDir.c_str());
+	fnfc.preset_file(progStatus.cw_log_name.c_str());
+// Show native chooser
+	switch ( fnfc.show() ) {
+		case -1:
+			fl_message ("ERROR: %s", fnfc.errmsg());
+			return; // ERROR
+		case 1:
+			return; // CANCEL
+		default:
+			progStatus.cw_log_name = fnfc.filename();
+			txt_cwlog_file->value(progStatus.cw_log_name.c_str());
+	}
+	cwlog_save();
+}
+
+void cwlog_open()
+{
+	if (cwlog_is_open && cw_log.changed)
+		cwlog_save();
+
+// Create and post the local native file chooser
+	Fl_Native_File_Chooser fnfc;
+	fnfc.title("Select log file");
+	fnfc.type(Fl_Native_File_Chooser::BROWSE_FILE);
+	fnfc.filter("CW Log\t*.txt");
+// default directory to use
+	fnfc.directory(RigHomeDir.c_str());
+// Show native chooser
+	switch ( fnfc.show() ) {
+		case -1:
+			fl_message ("ERROR: %s", fnfc.errmsg());
+			return; // ERROR
+		case 1:
+			return; // CANCEL
+		default:
+			progStatus.cw_log_name = fnfc.filename();
+			txt_cwlog_file->value(progStatus.cw_log_name.c_str());
+			txt_cwlog_file->redraw();
+			cwlog_load();
+	}
+}
+
+void cwlog_new()
+{
+	if (cwlog_is_open && cw_log.changed)
+		cwlog_save();
+	cw_log.clear();
+	progStatus.cw_log_name.clear();
+	txt_cwlog_file->value(progStatus.cw_log_name.c_str());
+	txt_cwlog_file->redraw();
+
+	Fl_Native_File_Chooser fnfc;
+	fnfc.title("Create new log file");
+	fnfc.type(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
+	fnfc.options(Fl_Native_File_Chooser::SAVEAS_CONFIRM);
+	fnfc.filter("CW Log\t*.txt");
+// default directory to use
+	fnfc.directory(RigHomeDir.c_str());
+	fnfc.preset_file("cwlog.txt");
+// Show native chooser
+	switch ( fnfc.show() ) {
+		case -1:
+			fl_message ("ERROR: %s", fnfc.errmsg());
+			return; // ERROR
+		case 1:
+			return; // CANCEL
+		default:
+			progStatus.cw_log_name = fnfc.filename();
+			txt_cwlog_file->value(progStatus.cw_log_name.c_str());
+			cw_log.file(progStatus.cw_log_name);
+			cwlog_is_open = true;
+	}
+}
+
+void cwlog_close()
+{
+	if (cwlog_is_open && cw_log.changed)
+		cwlog_save();
+}
+
+void cwlog_export_adif()
+{
+// Create and post the local native file chooser
+	Fl_Native_File_Chooser fnfc;
+	fnfc.title("Export to ADIF file");
+	fnfc.type(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
+	fnfc.options(Fl_Native_File_Chooser::SAVEAS_CONFIRM);
+	fnfc.filter("ADIF Log\t*.{adi,adif}");
+// default directory to use
+	fnfc.directory(RigHomeDir.c_str());
+// Show native chooser
+	switch ( fnfc.show() ) {
+		case -1:
+			fl_message ("ERROR: %s", fnfc.errmsg());
+			return; // ERROR
+		case 1:
+			return; // CANCEL
+		default:
+			break;
+	}
+
+	std::string export_fname = fnfc.filename();
+	if (!cw_log.export_adif(export_fname))
+		fl_message ("Could not write to %s", export_fname.c_str());
+}
+
+void cwlog_import_adif()
+{
+	Fl_Native_File_Chooser fnfc;
+	fnfc.title("Import from ADIF file");
+	fnfc.type(Fl_Native_File_Chooser::BROWSE_FILE);
+	fnfc.filter("ADIF Log\t*.{adi,adif}");
+// default directory to use
+	fnfc.directory(RigHomeDir.c_str());
+// Show native chooser
+	switch ( fnfc.show() ) {
+		case -1:
+			fl_message ("ERROR: %s", fnfc.errmsg());
+			return; // ERROR
+		case 1:
+			return; // CANCEL
+		default:
+			break;
+	}
+	std::string import_fname = fnfc.filename();
+	if (cw_log.import_adif(import_fname) < 0)
+		fl_message ("Could not read %s", import_fname.c_str());
+}
@@ -0,0 +1,493 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "qso_log.h"
+
+//----------------------------------------------------------------------
+// QSO_RECORD
+//----------------------------------------------------------------------
+
+std::string QSO_RECORD::line() const
+{
+	char snbr[20];
+	snprintf(snbr, sizeof(snbr), "%05d", nbr);
+	std::string s;
+	s.reserve(date.length() + time.length() + freq.length() + call.length() +
+		name.length() + rst_in.length() + rst_out.length() + xchg.length() + 16);
+	s.append(date).append("\t");
+	s.append(time).append("\t");
+	s.append(freq).append("\t");
+	s.append(call).append("\t");
+	s.append(name).append("\t");
+	s.append(rst_in).append("\t");
+	s.append(rst_out).append("\t");
+	s.append(snbr).append("\t");
+	s.append(xchg);
+	return s;
+}
+
+bool QSO_RECORD::parse(const std::string &line)
+{
+	std::string *fields[] = { &date, &time, &freq, &call, &name, &rst_in, &rst_out };
+	std::string snbr;
+	size_t p = 0, tab;
+	for (int n = 0; n < 8; n++) {
+		tab = line.find('\t', p);
+		std::string &fld = (n < 7) ? *fields[n] : snbr;
+		if (tab == std::string::npos) {
+			fld = line.substr(p);
+			p = line.length();
+		} else {
+			fld = line.substr(p, tab - p);
+			p = tab + 1;
+		}
+	}
+	nbr = atoi(snbr.c_str());
+	xchg = line.substr(p);
+	tab = xchg.find('\t');
+	if (tab != std::string::npos) xchg.erase(tab);
+	mhz = atof(freq.c_str());
+	deleted = false;
+	return !line.empty();
+}
+
+// sort order of a column, see indexed_store
+int QSO_RECORD::compare(const QSO_RECORD &r1, const QSO_RECORD &r2, int column)
+{
+	int cmp = 0;
+	switch (column) {
+		case QSO_LOG::BY_DATETIME:
+			cmp = r1.date.compare(r2.date);
+			if (!cmp) cmp = r1.time.compare(r2.time);
+			break;
+		case QSO_LOG::BY_FREQ:
+			cmp = (r1.mhz < r2.mhz) ? -1 : (r1.mhz > r2.mhz) ? 1 : 0;
+			break;
+		case QSO_LOG::BY_CALL:
+			cmp = r1.call.compare(r2.call);
+			break;
+		case QSO_LOG::BY_NBR:
+			cmp = r1.nbr - r2.nbr;
+			break;
+	}
+	return cmp;
+}
+
+//----------------------------------------------------------------------
+// QSO_LOG
+//----------------------------------------------------------------------
+
+QSO_LOG::QSO_LOG(const char *m) :
+	indexed_store<QSO_RECORD>(NSORTS),
+	changed(false), mode(m), browser(0), journal(0), journal_new(true)
+{
+	for (int n = 0; n < NSORTS; n++) dir[n] = 1;
+}
+
+QSO_LOG::~QSO_LOG()
+{
+	journal_close();
+}
+
+void QSO_LOG::show()
+{
+	if (!browser) return;
+	browser->clear();
+	for (size_t n = 0; n < shown.size(); n++)
+		browser->add(records[shown[n]].line().c_str());
+	browser->redraw();
+}
+
+void QSO_LOG::clear()
+{
+	journal_close();
+	records.clear();
+	shown.clear();
+	for (int n = 0; n < NSORTS; n++) index[n].clear();
+	fname.clear();
+	journal_new = true;
+	changed = false;
+	show();
+}
+
+// start a new log file; changes are journaled from here on
+void QSO_LOG::file(const std::string &name)
+{
+	journal_close();
+	fname = name;
+	journal_new = true;
+}
+
+int QSO_LOG::append(const QSO_RECORD &rec)
+{
+	int id = indexed_store<QSO_RECORD>::append(rec);
+	records[id].mhz = atof(rec.freq.c_str());
+	return id;
+}
+
+void QSO_LOG::add(const QSO_RECORD &rec)
+{
+	int id = append(rec);
+	index_add(id);
+	shown.push_back(id);
+	std::string line = records[id].line();
+	if (browser) browser->add(line.c_str());
+	journal_write(std::string("A\t").append(line));
+	changed = true;
+}
+
+void QSO_LOG::replace(int line, const QSO_RECORD &rec)
+{
+	if (line < 1 || line > (int)shown.size()) return;
+	int id = shown[line - 1];
+	index_remove(id);
+	records[id] = rec;
+	records[id].mhz = atof(rec.freq.c_str());
+	records[id].deleted = false;
+	index_add(id);
+	std::string text = records[id].line();
+	if (browser) browser->text(line, text.c_str());
+	char sid[20];
+	snprintf(sid, sizeof(sid), "E\t%d\t", id);
+	journal_write(std::string(sid).append(text));
+	changed = true;
+}
+
+void QSO_LOG::remove(int line)
+{
+	if (line < 1 || line > (int)shown.size()) return;
+	int id = shown[line - 1];
+	index_remove(id);
+	records[id].deleted = true;
+	shown.erase(shown.begin() + (line - 1));
+	if (browser) browser->remove(line);
+	char sid[20];
+	snprintf(sid, sizeof(sid), "D\t%d", id);
+	journal_write(sid);
+	changed = true;
+}
+
+const QSO_RECORD &QSO_LOG::entry(int line) const
+{
+	static QSO_RECORD none;
+	if (line < 1 || line > (int)shown.size()) return none;
+	return records[shown[line - 1]];
+}
+
+// show the log ordered by a column, alternately ascending and descending
+void QSO_LOG::sort(int column)
+{
+	if (column < 0 || column >= NSORTS) return;
+	shown = index[column];
+	if (dir[column] < 0)
+		std::reverse(shown.begin(), shown.end());
+	dir[column] = -dir[column];
+	show();
+}
+
+//----------------------------------------------------------------------
+// log file and journal
+//----------------------------------------------------------------------
+
+long QSO_LOG::snapshot_size()
+{
+	struct stat st;
+	if (fname.empty() || stat(fname.c_str(), &st) != 0)
+		return 0;
+	return (long)st.st_size;
+}
+
+void QSO_LOG::journal_close()
+{
+	if (journal) fclose(journal);
+	journal = 0;
+}
+
+// The journal starts with the size of the log file it applies to, so a
+// journal left over from before the log file was last written is not
+// replayed.
+void QSO_LOG::journal_write(const std::string &entry, bool flush)
+{
+	if (fname.empty()) return;
+	if (!journal) {
+		std::string jname = fname + ".jnl";
+		journal = fopen(jname.c_str(), journal_new ? "w" : "a");
+		if (!journal) return;
+		if (journal_new)
+			fprintf(journal, "S\t%ld\n", snapshot_size());
+		journal_new = false;
+	}
+	fputs(entry.c_str(), journal);
+	fputc('\n', journal);
+	if (flush) fflush(journal);
+}
+
+static bool read_line(FILE *f, std::string &line)
+{
+	line.clear();
+	int c;
+	while ((c = getc(f)) != EOF) {
+		if (c == '\n') return true;
+		if (c != '\r') line += (char)c;
+	}
+	return !line.empty();
+}
+
+bool QSO_LOG::load(const std::string &name)
+{
+	clear();
+	fname = name;
+
+	std::string line;
+	QSO_RECORD rec;
+	FILE *f = fopen(fname.c_str(), "r");
+	if (f) {
+		while (read_line(f, line)) {
+			if (line.empty() || !rec.parse(line)) continue;
+			shown.push_back(append(rec));
+		}
+		fclose(f);
+	}
+
+// replay the changes made since the log file was written
+	std::string jname = fname + ".jnl";
+	FILE *j = fopen(jname.c_str(), "r");
+	if (j) {
+		if (read_line(j, line) && line.substr(0, 2) == "S\t" &&
+			atol(line.c_str() + 2) == snapshot_size()) {
+			while (read_line(j, line)) {
+				if (line.length() < 2) continue;
+				if (line[0] == 'A') {
+					if (rec.parse(line.substr(2)))
+						shown.push_back(append(rec));
+				} else if (line[0] == 'E' || line[0] == 'D') {
+					int id = atoi(line.c_str() + 2);
+					if (id < 0 || id >= (int)records.size()) continue;
+					if (line[0] == 'E') {
+						size_t p = line.find('\t', 2);
+						if (p != std::string::npos && rec.parse(line.substr(p + 1)))
+							records[id] = rec;
+					} else {
+						records[id].deleted = true;
+						std::vector<int>::iterator it = std::find(shown.begin(), shown.end(), id);
+						if (it != shown.end()) shown.erase(it);
+					}
+				}
+				changed = true;
+			}
+			journal_new = false;
+		}
+		fclose(j);
+	}
+
+	reindex();
+	show();
+	return f || j;
+}
+
+// write the log in the order shown and empty the journal
+bool QSO_LOG::save(const std::string &name)
+{
+	if (name.empty()) return false;
+
+	std::string tmpname = name + ".tmp";
+	FILE *f = fopen(tmpname.c_str(), "w");
+	if (!f) return false;
+	for (size_t n = 0; n < shown.size(); n++) {
+		fputs(records[shown[n]].line().c_str(), f);
+		fputc('\n', f);
+	}
+	if (fclose(f) != 0) {
+		::remove(tmpname.c_str());
+		return false;
+	}
+#ifdef __WIN32__
+	::remove(name.c_str());
+#endif
+	if (rename(tmpname.c_str(), name.c_str()) != 0) {
+		::remove(tmpname.c_str());
+		return false;
+	}
+
+// the changes are in the file just written; after a save as, the journal
+// of the old file must not replay them into it when it is opened again,
+// and one left by an earlier log of the new name is stale
+	journal_close();
+	if (!fname.empty())
+		::remove((fname + ".jnl").c_str());
+	if (name != fname)
+		::remove((name + ".jnl").c_str());
+	fname = name;
+	journal_new = true;
+
+// the ids follow the order of the file just written
+	std::vector<QSO_RECORD> saved;
+	saved.reserve(shown.size());
+	for (size_t n = 0; n < shown.size(); n++) {
+		saved.push_back(records[shown[n]]);
+		shown[n] = n;
+	}
+	records.swap(saved);
+	reindex();
+
+	changed = false;
+	return true;
+}
+
+//----------------------------------------------------------------------
+// ADIF
+//----------------------------------------------------------------------
+
+static void adif_field(FILE *f, const char *name, const std::string &value)
+{
+	fprintf(f, "<%s:%d>%s", name, (int)value.length(), value.c_str());
+}
+
+bool QSO_LOG::export_adif(const std::string &name)
+{
+	FILE *f = fopen(name.c_str(), "w");
+	if (!f) return false;
+
+	fprintf(f, "flrig %s log\n<PROGRAMID:5>flrig<EOH>\n", mode.c_str());
+	char snbr[20];
+	for (size_t n = 0; n < shown.size(); n++) {
+		const QSO_RECORD &r = records[shown[n]];
+		snprintf(snbr, sizeof(snbr), "%05d", r.nbr);
+		adif_field(f, "QSO_DATE", r.date);
+		adif_field(f, "TIME_ON", r.time);
+		adif_field(f, "FREQ", r.freq);
+		adif_field(f, "MODE", mode);
+		adif_field(f, "CALL", r.call);
+		adif_field(f, "NAME", r.name);
+		adif_field(f, "RST_RCVD", r.rst_in);
+		adif_field(f, "RST_SENT", r.rst_out);
+		adif_field(f, "STX", snbr);
+		adif_field(f, "NOTES", r.xchg);
+		fputs("<EOR>\n", f);
+	}
+	return fclose(f) == 0;
+}
+
+static std::string dup_key(const QSO_RECORD &r)
+{
+	std::string key;
+	key.append(r.date).append("\t").append(r.time).append("\t");
+	key.append(r.freq).append("\t").append(r.call);
+	return key;
+}
+
+// Read <NAME:length[:type]>data fields a record at a time, to <EOR>.
+// Records of this log's mode which are not already in the log, by date,
+// time, frequency and call, are added.  Returns the number added.
+int QSO_LOG::import_adif(const std::string &name)
+{
+	FILE *f = fopen(name.c_str(), "r");
+	if (!f) return -1;
+
+	std::set<std::string> keys;
+	for (size_t n = 0; n < shown.size(); n++)
+		keys.insert(dup_key(records[shown[n]]));
+
+	int added = 0;
+	QSO_RECORD rec;
+	std::string rmode, snbr;
+	std::string tag, value;
+	int c;
+
+	while ((c = getc(f)) != EOF) {
+		if (c != '<') continue;
+		tag.clear();
+		while ((c = getc(f)) != EOF && c != ':' && c != '>')
+			tag += (char)toupper(c);
+		if (c == EOF) break;
+
+		if (c == '>') {
+			if (tag.compare(0, 3, "EOR") == 0) {
+				bool ok = (strcasecmp(rmode.c_str(), mode.c_str()) == 0) &&
+						  !rec.date.empty() && !rec.time.empty();
+				if (ok) {
+					rec.time = rec.time.substr(0, 4);
+					rec.nbr = atoi(snbr.c_str());
+					std::string key = dup_key(rec);
+					if (keys.find(key) == keys.end()) {
+						keys.insert(key);
+						int id = append(rec);
+						shown.push_back(id);
+						std::string line = records[id].line();
+						if (browser) browser->add(line.c_str());
+						journal_write(std::string("A\t").append(line), false);
+						added++;
+					}
+				}
+			}
+			if (tag.compare(0, 3, "EOR") == 0 || tag == "EOH") {
+				rec = QSO_RECORD();
+				rmode.clear();
+				snbr.clear();
+			}
+			continue;
+		}
+
+		int len = 0;
+		while ((c = getc(f)) != EOF && isdigit(c))
+			len = len * 10 + (c - '0');
+		while (c != EOF && c != '>')		// optional data type
+			c = getc(f);
+		if (c == EOF) break;
+
+		value.clear();
+		while (len-- > 0 && (c = getc(f)) != EOF)
+			value += (char)c;
+		size_t nl = value.find_first_of("\r\n");
+		if (nl != std::string::npos) value.erase(nl);
+
+		if      (tag == "QSO_DATE") rec.date = value;
+		else if (tag == "TIME_ON")  rec.time = value;
+		else if (tag == "FREQ")     rec.freq = value;
+		else if (tag == "MODE")     rmode = value;
+		else if (tag == "CALL")     rec.call = value;
+		else if (tag == "NAME")     rec.name = value;
+		else if (tag == "RST_RCVD") rec.rst_in = value;
+		else if (tag == "RST_SENT") rec.rst_out = value;
+		else if (tag == "STX")      snbr = value;
+		else if (tag == "NOTES")    rec.xchg = value;
+	}
+	fclose(f);
+
+	if (journal) fflush(journal);
+	if (browser) browser->redraw();
+	if (added) {
+		reindex();
+		changed = true;
+	}
+	return added;
+}
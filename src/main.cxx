@@ -86,12 +86,19 @@
 #include "cwioUI.h"
 #include "fsk.h"
 #include "fskioUI.h"
+#include "cat_capture.h"
+#include "radio.h"
 #include "serial.h"
 
 #include "flrig_icon.cxx"
 
 int parse_args(int argc, char **argv, int& idx);
 
+#ifdef FLRIG_BENCH
+extern int bench_arg(int argc, char **argv, int &idx);
+extern int flrig_bench();
+#endif
+
 Fl_Double_Window *mainwindow = (Fl_Double_Window *)0;
 Fl_Double_Window *tabs_dialog = (Fl_Double_Window *)0;
 Fl_Double_Window *cwio_keyer_dialog = (Fl_Double_Window *)0;
@@ -377,6 +384,7 @@ void startup(void*)
 		default :
 			break;
 	}
+	radios_start();
 	start_server(xmlport);
 
 }
@@ -421,7 +429,9 @@ int main (int argc, char *argv[])
 	RigHomeDir.clear();
 
 	Fl::args(argc, argv, arg_idx, parse_args);
+#ifndef FLRIG_BENCH
 	Fl::set_fonts(0);
+#endif
 
 	char dirbuf[FL_PATH_MAX + 1];
 	std::string appdir = argv[0];
@@ -463,7 +473,9 @@ int main (int argc, char *argv[])
 
 #endif
 
+#ifndef FLRIG_BENCH
 	make_trace_window();
+#endif
 	checkdirectories();
 
 #if SERIAL_DEBUG
@@ -511,6 +523,15 @@ int main (int argc, char *argv[])
 	if (use_rpc_trace) progStatus.rpctrace = true;
 	if (use_tci_trace) progStatus.tcitrace = true;
 
+	if (progStatus.cat_capture) cat_capture_start();
+
+// flrig-bench runs the CAT and poll functions without a display,
+// no window is built
+#ifdef FLRIG_BENCH
+	Fl::lock();
+	return flrig_bench();
+#endif
+
 	switch (progStatus.UIsize) {
 		case touch_ui :
 			mainwindow = touch_rig_window();
@@ -804,6 +825,10 @@ int parse_args(int argc, char **argv, int& idx)
 		idx++;
 		return 1;
 	}
+#ifdef FLRIG_BENCH
+	if (strncasecmp("--bench-", argv[idx], 8) == 0 && bench_arg(argc, argv, idx))
+		return 1;
+#endif
 #  ifdef __APPLE__
 	if (strncasecmp("-psn", argv[idx], 4) == 0) {
 		idx++;
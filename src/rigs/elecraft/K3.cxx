@@ -105,7 +105,8 @@ RIG_K3::RIG_K3() {
 	has_power_out =
 	has_split =
 	has_ifshift_control =
-	has_preamp_control = true;
+	has_preamp_control =
+	can_push = true;
 
 	has_notch_control =
 	has_tune_control =
@@ -193,6 +194,22 @@ void RIG_K3::initialize()
 
 }
 
+// queries answered by auto information reports, see rigbase::push_match
+std::string RIG_K3::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ") return "FA;FB;";	// read_vfo reads both
+	if (poll_name == "MODE") return "MD;MD$;";
+	return "";
+}
+
+void RIG_K3::push_mode(bool on)
+{
+	cmd = on ? "AI2;" : "AI0;";
+	set_trace(1, on ? "enable auto info" : "disable auto info");
+	sendCommand(cmd);
+	sett("");
+}
+
 void RIG_K3::shutdown()
 {
 }
@@ -118,6 +118,7 @@ RIG_K4::RIG_K4() {
 	has_split = true;
 	has_ifshift_control =
 	has_preamp_control = true;
+	can_push = true;
 	has_agc_control = true;
 
 	has_notch_control =
@@ -231,6 +232,22 @@ void RIG_K4::initialize()
 
 }
 
+// queries answered by auto information reports, see rigbase::push_match
+std::string RIG_K4::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ") return "FA;FB;";	// read_vfo reads both
+	if (poll_name == "MODE") return "MD;MD$;";
+	return "";
+}
+
+void RIG_K4::push_mode(bool on)
+{
+	cmd = on ? "AI2;" : "AI0;";
+	set_trace(1, on ? "enable auto info" : "disable auto info");
+	sendCommand(cmd);
+	sett("");
+}
+
 void RIG_K4::shutdown()
 {
 }
@@ -23,6 +23,7 @@
 #include "status.h"
 
 #include "support.h"
+#include "radio.h"
 
 const char KX3name_[] = "KX3";
 
@@ -233,7 +234,7 @@ void RIG_KX3::initialize()
 	bandwidths_ = KX3_widths;
 	bw_vals_ = KX3_bw_vals;
 
-	RigSerial->Timeout(50);
+	rig_port()->Timeout(50);
 
 	LOG_INFO("KX3");
 
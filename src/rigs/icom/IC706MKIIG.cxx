@@ -99,6 +99,8 @@ RIG_IC706MKIIG::RIG_IC706MKIIG() {
 void RIG_IC706MKIIG::initialize()
 {
 	VECTOR (IC706MKIIGmodes_, vIC706MKIIGmodes_);
+// rebuilt each time, the user's filter names are put in below
+	IC706MKIIG_ssb_cw_rtty_bws.clear();
 	VECTOR (IC706MKIIG_ssb_cw_rtty_bws, vIC706MKIIG_ssb_cw_rtty_bws);
 	VECTOR (IC706MKIIG_am_fm_bws, vIC706MKIIG_am_fm_bws);
 	VECTOR (IC706MKIIG_wfm_bws, vIC706MKIIG_wfm_bws);
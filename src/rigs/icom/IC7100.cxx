@@ -27,6 +27,7 @@
 #include "status.h"
 
 #include "support.h"
+#include "radio.h"
 
 //=============================================================================
 // IC-7100
@@ -354,7 +355,7 @@ void RIG_IC7100::set_xcvr_auto_on()
 		cmd.append(pre_to);
 		cmd += '\x18'; cmd += '\x01';
 		cmd.append(post);
-		RigSerial->failed(0);
+		rig_port()->failed(0);
 		set_trace(1, "set_xcvr_auto_on()");
 		if (waitFB("Power ON")) {
 			seth();
@@ -365,7 +366,7 @@ void RIG_IC7100::set_xcvr_auto_on()
 			for (i = 0; i < 100; i++) {
 				MilliSleep(50);
 				if (waitFOR(8, "get ID") == true) {
-					RigSerial->failed(0);
+					rig_port()->failed(0);
 					xcvr_is_on = true;
 					return;
 				}
@@ -373,11 +374,11 @@ void RIG_IC7100::set_xcvr_auto_on()
 				Fl::awake();
 			}
 			xcvr_is_on = false;
-			RigSerial->failed(1);
+			rig_port()->failed(1);
 			return;
 		}
 		seth();
-		RigSerial->failed(1);
+		rig_port()->failed(1);
 		xcvr_is_on = false;
 		return;
 	}
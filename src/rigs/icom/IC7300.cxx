@@ -31,6 +31,7 @@
 #include "trace.h"
 
 #include "support.h"
+#include "radio.h"
 
 //=============================================================================
 // IC-7300
@@ -337,6 +338,8 @@ RIG_IC7300::RIG_IC7300() {
 	inuse = onA;
 
 	can_synch_clock = true;
+	can_pipeline =
+	can_push = true;
 
 	CW_sense = 0; // CW is LSB
 
@@ -420,7 +423,7 @@ void RIG_IC7300::set_xcvr_auto_on()
 	get_trace(1, "getID()");
 
 	cmd.append(post);
-	RigSerial->failed(0);
+	rig_port()->failed(0);
 
 	if (waitFOR(8, "get ID", 100) == false) {
 		cmd.clear();
@@ -428,15 +431,15 @@ void RIG_IC7300::set_xcvr_auto_on()
 		if (progStatus.serial_baudrate >= 0 && progStatus.serial_baudrate <= 11) {
 			cmd.append( fes[progStatus.serial_baudrate], '\xFE');
 		}
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 
 		std::string tempbuf;
-		RigSerial->ReadBuffer(tempbuf, 150);
+		rig_port()->ReadBuffer(tempbuf, 150);
 
 		cmd.assign(pre_to);
 		cmd += '\x18'; cmd += '\x01';
 		cmd.append(post);
-		RigSerial->failed(0);
+		rig_port()->failed(0);
 
 		if ( waitFB("Power ON", 100) ) {
 // 5 second delay
@@ -453,7 +456,7 @@ void RIG_IC7300::set_xcvr_auto_on()
 			int i = 0;
 			for (i = 0; i < 50; i++) { // 5 second total timeout
 				if (waitFOR(8, "get ID", 100) == true) {
-					RigSerial->failed(0);
+					rig_port()->failed(0);
 					update_progress(0);
 					return;
 				}
@@ -463,7 +466,7 @@ void RIG_IC7300::set_xcvr_auto_on()
 		}
 		update_progress(0);
 		set_trace(1, "power_ON failed");
-		RigSerial->failed(1);
+		rig_port()->failed(1);
 		xcvr_is_on = false;
 		return;
 	}
@@ -1649,6 +1652,22 @@ void RIG_IC7300::get_pc_min_max_step(double &min, double &max, double &step)
 	min = 0; pmax = max = 100; step = 1;
 }
 
+// queries made by the poll entries, see RIG_ICOM::pipeline
+std::string RIG_IC7300::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ")
+		return civ_frame(std::string("\x25\x00", 2)).append(civ_frame("\x25\x01"));
+// get_modeA and get_modeB ask for the selected (00) or the unselected
+// (01) vfo, as inuse makes the vfo they read
+	if (poll_name == "MODE")
+		return civ_frame(std::string("\x26\x00", 2)).append(civ_frame("\x26\x01"));
+	if (poll_name == "SMETER") return civ_frame("\x15\x02");
+	if (poll_name == "pout")   return civ_frame("\x15\x11");
+	if (poll_name == "swr")    return civ_frame("\x15\x12");
+	if (poll_name == "alc")    return civ_frame("\x15\x13");
+	return "";
+}
+
 int RIG_IC7300::get_smeter()
 {
 	std::string cstr = "\x15\x02";
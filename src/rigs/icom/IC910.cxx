@@ -21,6 +21,7 @@
 #include "icom/IC910.h"
 
 #include "support.h"
+#include "ui_refresh.h"
 
 const char IC910Hname_[] = "IC-910H";
 static std::vector<std::string>IC910Hmodes_;
@@ -149,7 +150,7 @@ void RIG_IC910H::set_vfoA (unsigned long long freq)
 
 	if (freqA != freq) {
 		vfoA.freq = freqA;
-		setFreqDispA((void*)0);
+		ui_mark(UI_FREQ_A);
 	}
 	A.freq = freqA;
 	cmd = pre_to;
@@ -23,6 +23,7 @@
 #include "icom/IC9700.h"
 
 #include "support.h"
+#include "radio.h"
 
 //=============================================================================
 // IC-9700
@@ -287,6 +288,7 @@ RIG_IC9700::RIG_IC9700() {
 	has_a2b = true;
 
 	can_synch_clock = true;
+	can_pipeline = true;
 
 	precision = 1;
 	ndigits = 10;
@@ -308,7 +310,7 @@ void RIG_IC9700::set_xcvr_auto_on()
 	get_trace(1, "getID()");
 
 	cmd.append(post);
-	RigSerial->failed(0);
+	rig_port()->failed(0);
 
 	if (waitFOR(8, "get ID") == false) {
 		cmd.clear();
@@ -316,13 +318,13 @@ void RIG_IC9700::set_xcvr_auto_on()
 		if (progStatus.serial_baudrate >= 0 && progStatus.serial_baudrate <= 11) {
 			cmd.append( fes[progStatus.serial_baudrate], '\xFE');
 		}
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 
 		cmd.assign(pre_to);
 		cmd += '\x18'; cmd += '\x01';
 		set_trace(1, "power_on()");
 		cmd.append(post);
-		RigSerial->failed(0);
+		rig_port()->failed(0);
 
 		if (waitFB("Power ON")) {
 			isett("power_on()");
@@ -333,18 +335,18 @@ void RIG_IC9700::set_xcvr_auto_on()
 			int i = 0;
 			for (i = 0; i < 100; i++) { // 10 second total timeout
 				if (waitFOR(8, "get ID", 100) == true) {
-					RigSerial->failed(0);
+					rig_port()->failed(0);
 					return;
 				}
 				update_progress(i / 2);
 				Fl::awake();
 			}
-			RigSerial->failed(0);
+			rig_port()->failed(0);
 			return;
 		}
 
 		isett("power_on()");
-		RigSerial->failed(1);
+		rig_port()->failed(1);
 		xcvr_is_on = false;
 		return;
 	}
@@ -1231,6 +1233,17 @@ void RIG_IC9700::get_rf_min_max_step(double &min, double &max, double &step)
 	min = 0; max = 100; step = 1;
 }
 
+// queries made by the poll entries, see RIG_ICOM::pipeline
+// frequency reads depend on the satellite mode and are not batched
+std::string RIG_IC9700::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "SMETER") return civ_frame("\x15\x02");
+	if (poll_name == "pout")   return civ_frame("\x15\x11");
+	if (poll_name == "swr")    return civ_frame("\x15\x12");
+	if (poll_name == "alc")    return civ_frame("\x15\x13");
+	return "";
+}
+
 int RIG_IC9700::get_smeter()
 {
 	std::string cstr = "\x15\x02";
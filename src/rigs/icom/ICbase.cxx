@@ -23,6 +23,7 @@
 #include "icom/ICbase.h"
 #include "debug.h"
 #include "icons.h"
+#include "cat_stats.h"
 #include "tod_clock.h"
 #include "trace.h"
 #include "status.h"
@@ -32,6 +33,7 @@
 #include "support.h"
 
 #include "xmlrpc_rig.h"
+#include "radio.h"
 
 pthread_mutex_t command_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -45,10 +47,10 @@ void RIG_ICOM::adjustCIV(uchar adr)
 
 void RIG_ICOM::checkresponse()
 {
-	if (!progStatus.use_tcpip && !RigSerial->IsOpen())
+	if (!rig_tcpip() && !rig_port()->IsOpen())
 		return;
 
-	if (!RigSerial->IsOpen()) return;
+	if (!rig_port()->IsOpen()) return;
 
 	if (replystr.rfind(ok) != std::string::npos)
 		return;
@@ -60,42 +62,42 @@ void RIG_ICOM::checkresponse()
 
 bool RIG_ICOM::sendICcommand(std::string cmd, int nbr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
 
-	if (progStatus.xmlrpc_rig) {
-		respstr = xml_cat_string(cmd);
+	if (rig_xmlrpc()) {
+		rig_respstr() = xml_cat_string(cmd);
 //std::cout << "respstr: " << str2hex(respstr.c_str(), respstr.length()) << std::endl;
-		return respstr.length();
+		return rig_respstr().length();
 	}
 
 	int ret = sendCommand(cmd);
 
-	if (!progStatus.use_tcpip && !RigSerial->IsOpen())
+	if (!rig_tcpip() && !rig_port()->IsOpen())
 		return false;
 
-	if (!RigSerial->IsOpen()) return false;
+	if (!rig_port()->IsOpen()) return false;
 
 	if (ret < nbr) {
 		LOG_ERROR("Expected %d received %d", nbr, ret);
 		return false;
 	}
 
-	if (ret > nbr) respstr.erase(0, ret - nbr);
+	if (ret > nbr) rig_respstr().erase(0, ret - nbr);
 
 // look for preamble at beginning
-	if (respstr.rfind(pre_fm) == std::string::npos)  {
+	if (rig_respstr().rfind(pre_fm) == std::string::npos)  {
 		LOG_ERROR("preamble: %s not in %s", pre_fm.c_str(), cmd.c_str());
 		replystr.clear();
 		return false;
 	}
 
 // look for postamble
-	if (respstr.rfind(post) == std::string::npos) {
+	if (rig_respstr().rfind(post) == std::string::npos) {
 		LOG_ERROR("postample: %s not at end of %s", post.c_str(), cmd.c_str());
 		replystr.clear();
 		return false;
 	}
-	replystr = respstr;
+	replystr = rig_respstr();
 	return true;
 }
 
@@ -109,7 +111,7 @@ void RIG_ICOM::ICtrace(std::string cmd, std::string hexstr)
 
 bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 {
-	static char sztemp[200];
+	char sztemp[200];
 	memset(sztemp, 0, 200);
 	std::string check = "1234";
 	std::string eor   = "\xFD";
@@ -122,31 +124,38 @@ bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 	check[2] = cmd[3];
 	check[3] = cmd[2];
 
-//	int delay =  n * 11000.0 / RigSerial->Baud();
+//	int delay =  n * 11000.0 / rig_port()->Baud();
 	int retnbr = 0;
 
 	replystr.clear();
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 		return replystr.length();
 	}
 
+	{
+		guard_lock reply_lock(rig_reply_mutex());
+		if (pipeline_hit(sz))
+			return true;
+	}
+
 	ullint tstart = 0;
 	ullint tout = 0;
 	size_t pcheck = 0;
 	size_t peor = 0;
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		LOG_DEBUG("TEST %s", sz);
 		return false;
 	}
-	   if (progStatus.use_tcpip) {
+	ullint ustart = zusec();
+	   if (rig_tcpip()) {
 		send_to_remote(cmd);
 	   }
 	   else {
-   		RigSerial->FlushBuffer();
-	  	RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+   		rig_port()->FlushBuffer();
+	  	rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	   }
 
 	tstart = zmsec();
@@ -159,11 +168,11 @@ bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 
 	while ( zmsec() < tout ) {
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(
+			nret = rig_port()->ReadBuffer(
 				tempstr, 
 				n,
 				check, 
@@ -174,6 +183,7 @@ bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 
 		if (replystr.rfind(bad) != std::string::npos) {
 			LOG_ERROR("%s: BAD response; %s", sz, str2hex(replystr.c_str(), replystr.length()));
+			stats_command(sz, zusec() - ustart, cmd.length(), replystr.length(), false);
 			return false;
 		}
 		pcheck = replystr.rfind(check);
@@ -187,11 +197,14 @@ bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 					retnbr,
 					(int)(zmsec() - tstart), 
 					str2hex(replystr.c_str(), replystr.length()));
+			stats_command(sz, zusec() - ustart, cmd.length(), replystr.length(), false);
 			return true;
 		}
 		MilliSleep(1);
 	}
 
+	stats_command(sz, zusec() - ustart, cmd.length(), replystr.length(), true);
+
 	LOG_ERROR("%s: FAILED in %d msec; %s", 
 			sz,
 			(int)(zmsec() - tstart),
@@ -199,6 +212,147 @@ bool RIG_ICOM::waitFOR(size_t n, const char *sz, ullint timeout)
 	return false;
 }
 
+//----------------------------------------------------------------------
+// Batched CI-V queries
+//
+// All frames in 'queries' are written in a single burst.  The returning
+// byte stream is split into frames as it arrives; frames addressed to the
+// transceiver (the CI-V bus echo) or broadcast by it (transceive) are
+// dropped, and every reply is routed to the request whose command and
+// sub command bytes it repeats.  waitFOR consumes the replies in place of
+// a fresh exchange.  An NG reply, or a reply that does not arrive, leaves
+// the request to be served by a normal waitFOR.
+//----------------------------------------------------------------------
+std::string RIG_ICOM::civ_frame(std::string body)
+{
+	std::string frame = pre_to;
+	frame.append(body).append(post);
+	return frame;
+}
+
+int RIG_ICOM::pipeline(std::string queries, int timeout)
+{
+	guard_lock reply_lock(rig_reply_mutex());
+
+	if (!can_pipeline || rig_xmlrpc())
+		return 0;
+	if (!rig_tcpip() && !rig_port()->IsOpen())
+		return 0;
+
+	std::vector<std::string> qlist;
+	size_t p0 = 0, p1;
+	while ((p1 = queries.find('\xFD', p0)) != std::string::npos) {
+		std::string q = queries.substr(p0, p1 - p0 + 1);
+		if (p1 - p0 > pre_to.length() && pipeline_replies.find(q) == pipeline_replies.end())
+			qlist.push_back(q);
+		p0 = p1 + 1;
+	}
+	if (qlist.size() < 2) return 0;
+
+	std::string batch;
+	for (size_t n = 0; n < qlist.size(); n++)
+		batch.append(qlist[n]);
+
+	if (rig_tcpip())
+		send_to_remote(batch);
+	else {
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(batch.c_str(), batch.length());
+	}
+
+	ullint tstart = zmsec();
+	ullint tout = tstart + timeout;
+	std::string stream, tempstr;
+	std::vector<bool> done(qlist.size(), false);
+	size_t answered = 0;
+	int nret = 0;
+
+	while (answered < qlist.size() && zmsec() < tout) {
+		tempstr.clear();
+		if (rig_tcpip())
+			nret = read_from_remote(tempstr);
+		else
+			nret = rig_port()->ReadBuffer(tempstr, 256, post);
+		if (nret) {
+			stream.append(tempstr);
+			tout = zmsec() + progStatus.serial_timeout;
+		}
+// parse complete frames
+		while ((p1 = stream.find('\xFD')) != std::string::npos) {
+			std::string frame = stream.substr(0, p1 + 1);
+			stream.erase(0, p1 + 1);
+			p0 = frame.find("\xFE\xFE");
+			if (p0 == std::string::npos) continue;
+			frame.erase(0, p0);
+			if (frame.find(pre_fm) != 0) continue;	// echo or broadcast
+			if (frame == bad) {		// NG, answers the oldest open request
+				for (size_t n = 0; n < qlist.size(); n++)
+					if (!done[n]) { done[n] = true; answered++; break; }
+				continue;
+			}
+			std::string body = frame.substr(pre_fm.length());
+			for (size_t n = 0; n < qlist.size(); n++) {
+				if (done[n]) continue;
+				std::string qbody = qlist[n].substr(pre_to.length(),
+					qlist[n].length() - pre_to.length() - 1);
+				if (body.find(qbody) == 0) {
+					pipeline_replies[qlist[n]] = frame;
+					done[n] = true;
+					answered++;
+					break;
+				}
+			}
+		}
+		if (!nret) MilliSleep(1);
+	}
+
+	char ctrace[1000];
+	snprintf( ctrace, sizeof(ctrace), "pipeline: %d frames, %d replies in %d msec",
+		(int)qlist.size(), (int)pipeline_replies.size(),
+		(int)(zmsec() - tstart) );
+	ser_trace(1, ctrace);
+	LOG_DEBUG ("%s", ctrace);
+
+	return pipeline_replies.size();
+}
+
+// CI-V transceive: the transceiver broadcasts frequency (0x00) and mode
+// (0x01) changes to address 0x00.  A frequency report is rewritten as the
+// reply to a 0x03 or 0x25 0x00 (selected vfo) read.  The mode report does
+// not carry the data mode of the 0x26 reply, so it only triggers a read.
+std::string RIG_ICOM::push_match(std::string &frame, std::string queries)
+{
+	std::string bcast = "\xFE\xFE";
+	bcast += '\x00';
+	bcast += CIV;
+	if (frame.find(bcast) != 0 || frame.length() < 6)
+		return "";
+
+	char tcmd = frame[4];
+	std::string data = frame.substr(5);
+
+	size_t p0 = 0, p1;
+	while ((p1 = queries.find('\xFD', p0)) != std::string::npos) {
+		std::string q = queries.substr(p0, p1 - p0 + 1);
+		p0 = p1 + 1;
+		if (q.length() <= pre_to.length() + 1) continue;
+		std::string qbody = q.substr(pre_to.length(), q.length() - pre_to.length() - 1);
+		if (tcmd == '\x00') {
+			if (qbody == "\x03" || qbody == std::string("\x25\x00", 2)) {
+				frame = pre_fm;
+				frame.append(qbody).append(data);
+				return q;
+			}
+		} else if (tcmd == '\x01') {
+			if (qbody[0] == '\x04' || qbody[0] == '\x26') {
+				frame.clear();
+				return q;
+			}
+		}
+	}
+	return "";
+}
+
 // waitFB - This function sends the command in the 'cmd' member string (via 'waitFOR'),
 //          specifying the number of bytes in the expected resposne.  'waitFOR' already
 //          knows the construction of the response message so this seems superfluous.
@@ -478,7 +478,7 @@ std::vector<std::string>& RIG_TS2000::lotable(int val)
 		return TS2000_SL;
 	if (val == AM)
 		return TS2000_AM_SL;
-	return vNOBWS;
+	return bandwidths_;
 }
 
 std::vector<std::string>& RIG_TS2000::hitable(int val)
@@ -487,7 +487,7 @@ std::vector<std::string>& RIG_TS2000::hitable(int val)
 		return TS2000_SH;
 	if (val == AM)
 		return TS2000_AM_SH;
-	return vNOBWS;
+	return bandwidths_;
 }
 
 void RIG_TS2000::set_modeA(int val)
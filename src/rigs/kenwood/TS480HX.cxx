@@ -462,9 +462,9 @@ std::vector<std::string>& RIG_TS480HX::lotable(int m)
 	if (m == 0 || m == 1 || m == 3)
 		return TS480HX_SL;
 	else if (m == 2 || m == 6)
-		return vNOBWS;
+		return bandwidths_;
 	else if (m == 5 || m == 7)
-		return vNOBWS;
+		return bandwidths_;
 	return TS480HX_AM_SL;
 }
 
@@ -473,9 +473,9 @@ std::vector<std::string>& RIG_TS480HX::hitable(int m)
 	if (m == 0 || m == 1 || m == 3)
 		return TS480HX_SH;
 	else if (m == 2 || m == 6)
-		return vNOBWS;
+		return bandwidths_;
 	else if (m == 5 || m == 7)
-		return vNOBWS;
+		return bandwidths_;
 	return TS480HX_AM_SH;
 }
 
@@ -456,9 +456,9 @@ std::vector<std::string>& RIG_TS480SAT::lotable(int m)
 	if (m == 0 || m == 1 || m == 3)
 		return TS480SAT_SL;
 	else if (m == 2 || m == 6)
-		return vNOBWS;
+		return bandwidths_;
 	else if (m == 5 || m == 7)
-		return vNOBWS;
+		return bandwidths_;
 	return TS480SAT_AM_SL;
 }
 
@@ -467,9 +467,9 @@ std::vector<std::string> &RIG_TS480SAT::hitable(int m)
 	if (m == 0 || m == 1 || m == 3)
 		return TS480SAT_SH;
 	else if (m == 2 || m == 6)
-		return vNOBWS;
+		return bandwidths_;
 	else if (m == 5 || m == 7)
-		return vNOBWS;
+		return bandwidths_;
 	return TS480SAT_AM_SH;
 }
 
@@ -661,7 +661,7 @@ std::vector<std::string>& RIG_TS590S::lotable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS590S_DATA_shift;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 std::vector<std::string>& RIG_TS590S::hitable(int m)
@@ -673,7 +673,7 @@ std::vector<std::string>& RIG_TS590S::hitable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS590S_DATA_width;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 int RIG_TS590S::adjust_bandwidth(int val)
@@ -677,7 +677,7 @@ std::vector<std::string>& RIG_TS590SG::lotable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS590SG_DATA_shift;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 std::vector<std::string>& RIG_TS590SG::hitable(int m)
@@ -689,7 +689,7 @@ std::vector<std::string>& RIG_TS590SG::hitable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS590SG_DATA_width;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 int RIG_TS590SG::adjust_bandwidth(int val)
@@ -878,7 +878,7 @@ std::vector<std::string>& RIG_TS870S::lotable(int m)
 	if (m == tsAM)
 		return TS870S_AM_SL;
 
-	return vNOBWS;//TS870S_empty;
+	return bandwidths_;//TS870S_empty;
 }
 
 std::vector<std::string>& RIG_TS870S::hitable(int m)
@@ -337,7 +337,9 @@ RIG_TS890S::RIG_TS890S() {
 	has_mode_control =
 	has_bandwidth_control =
 	has_ifshift_control =
-	has_ptt_control = true;
+	has_ptt_control =
+	can_pipeline =
+	can_push = true;
 
 	rxtxa = true;
 
@@ -386,6 +388,25 @@ int RIG_TS890S::get_smeter()
 	return mtr;
 }
 
+// queries made by the poll entries, see rigbase::pipeline
+std::string RIG_TS890S::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ")   return "FA;FB;";	// read_vfo reads both
+	if (poll_name == "SMETER") return "SM;";
+	if (poll_name == "MODE")   return "MD;";
+	if (poll_name == "pout")   return "SM0;";
+	return "";
+}
+
+// auto information, see rigbase::push_read
+void RIG_TS890S::push_mode(bool on)
+{
+	cmd = on ? "AI2;" : "AI0;";
+	sendCommand(cmd);
+	showresp(INFO, ASC, "auto info", cmd, "");
+	sett("push_mode");
+}
+
 int RIG_TS890S::get_power_out()
 {
 	int mtr = 0;
@@ -686,7 +707,7 @@ std::vector<std::string>& RIG_TS890S::lotable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS890S_DATA_shift;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 std::vector<std::string>& RIG_TS890S::hitable(int m)
@@ -698,7 +719,7 @@ std::vector<std::string>& RIG_TS890S::hitable(int m)
 	else if (m == LSBD || m == USBD)
 		return TS890S_DATA_width;
 // CW CWR FSK FSKR
-	return vNOBWS;
+	return bandwidths_;
 }
 
 int RIG_TS890S::adjust_bandwidth(int val)
@@ -473,6 +473,8 @@ RIG_TS990::RIG_TS990() {
 	has_ptt_control =
 	has_xcvr_auto_on_off = 
 	can_synch_clock = 
+	can_pipeline =
+	can_push =
 	true;
 
 	rxtxa = true;
@@ -875,6 +877,26 @@ int RIG_TS990::get_smeter()
 // Power out reading
 //==============================================================================
 // response SMbmmmm;
+// queries made by the poll entries, see rigbase::pipeline
+std::string RIG_TS990::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ") return "FA;FB;";	// read_vfo reads both
+	if (poll_name == "SMETER" || poll_name == "pout")
+		return (inuse == onB) ? "SM1;" : "SM0;";
+	if (poll_name == "MODE")
+		return (inuse == onB) ? "OM1;" : "OM0;";
+	return "";
+}
+
+// auto information, see rigbase::push_read
+void RIG_TS990::push_mode(bool on)
+{
+	cmd = on ? "AI2;" : "AI0;";
+	sendCommand(cmd);
+	showresp(INFO, ASC, "auto info", cmd, "");
+	sett("push_mode");
+}
+
 int RIG_TS990::get_power_out()
 {
 	gett("get_power_out()");
@@ -1544,10 +1566,10 @@ std::vector<std::string>& RIG_TS990::lotable(int m)
 			filter = TS990_CW_width;
 			break;
 		case FSK: case FSKR:
-			filter = vNOBWS;//TS990_FSK_filt;
+			filter = bandwidths_;//TS990_FSK_filt;
 			break;
 		case PSK: case PSKR:
-			filter = vNOBWS;//TS990_PSK_filt;
+			filter = bandwidths_;//TS990_PSK_filt;
 			break;
 		case AM: case AMD1: case AMD2: case AMD3:
 			filter = TS990_AM_SL;
@@ -1584,10 +1606,10 @@ std::vector<std::string>& RIG_TS990::hitable(int m)
 			filter = TS990_filt_SH;
 			break;
 		case FSK: case FSKR:
-			filter = vNOBWS;
+			filter = bandwidths_;
 			break;
 		case PSK: case PSKR:
-			filter = vNOBWS;
+			filter = bandwidths_;
 			break;
 		case AM: case AMD1: case AMD2: case AMD3:
 			filter = TS990_AM_SH;
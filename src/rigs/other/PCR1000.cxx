@@ -51,6 +51,7 @@
 #include "config.h"
 #include "other/PCR1000.h"
 #include "support.h"
+#include "radio.h"
 
 #define PCR_WAIT 100
 
@@ -237,7 +238,7 @@ void RIG_PCR1000::initialize()
 	}
 
 //	sendCommand("G105\r\n");
-//	RigSerial->Baud(38400);
+//	rig_port()->Baud(38400);
 //	MilliSleep(500);
 	
 
@@ -272,7 +273,7 @@ void RIG_PCR1000::shutdown()
 	set_trace(1, "shutdown()");
 	wait_crlf(cmd = power_off_command, "power OFF");
 	sett("");
-	RigSerial->Baud(9600);
+	rig_port()->Baud(9600);
 }
 //----------------------------------------------------------------------
 
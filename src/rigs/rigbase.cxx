@@ -39,6 +39,9 @@
 
 #include "rigs.h"
 #include "xmlrpc_rig.h"
+#include "tci_io.h"
+#include "cat_stats.h"
+#include "radio.h"
 
 const char *szNORIG = "NONE";
 
@@ -60,11 +63,6 @@ const int  ibw_val = -1;
 
 static GUI basewidgets[] = { {NULL, 0, 0} };
 
-std::vector<std::string> &rigbase::modes_ = vNOMODES;
-std::vector<std::string> &rigbase::bandwidths_ = vNOBWS;
-std::vector<std::string> &rigbase::dsp_SL = vDSPLO;
-std::vector<std::string> &rigbase::dsp_SH = vDSPHI;
-
 std::vector<std::string> vAGC_LABELS;
 const char *AGCVAL[] = {"AGC"};
 
@@ -89,15 +87,6 @@ const char *m60VAL[] = {""};
 std::vector<std::string> vAN_LABELS;
 const char *ANVAL[] = {"AN"};
 
-std::vector<std::string> &rigbase::agc_labels_ = vAGC_LABELS;
-std::vector<std::string> &rigbase::att_labels_ = vATT_LABELS;
-std::vector<std::string> &rigbase::pre_labels_ = vPRE_LABELS;
-std::vector<std::string> &rigbase::nb_labels_ = vNB_LABELS;
-std::vector<std::string> &rigbase::nr_labels_ = vNR_LABELS;
-std::vector<std::string> &rigbase::bk_labels_ = vBK_LABELS;
-std::vector<std::string> &rigbase::m60_labels_ = v60M_LABELS;
-std::vector<std::string> &rigbase::an_labels_ = vAN_LABELS;
-
 rigbase::rigbase()
 {
 	IDstr = "";
@@ -207,6 +196,9 @@ rigbase::rigbase()
 	ICOMrig =
 	ICOMmainsub =
 	can_synch_clock =
+	can_pipeline =
+	can_push =
+	pushing =
 	has_a2b =
 	has_vfoAB = false;
 
@@ -360,7 +352,7 @@ unsigned long long rigbase::fm_bcd_be(std::string bcd, int len)
 
 std::string rigbase::to_binary_be(unsigned long long val, int len)
 {
-	static std::string bin = "";
+	std::string bin = "";
 	for (int i = 0; i < len; i++) {
 		bin += val & 0xFF;
 		val >>= 8;
@@ -370,7 +362,7 @@ std::string rigbase::to_binary_be(unsigned long long val, int len)
 
 std::string rigbase::to_binary(unsigned long long val, int len)
 {
-	static std::string bin = "";
+	std::string bin = "";
 	std::string bin_be = to_binary_be(val, len);
 	int binlen = bin_be.size();
 	for (int i = binlen - 1; i >= 0; i--)
@@ -404,7 +396,7 @@ unsigned long long rigbase::fm_binary_be(std::string binary_be, int len)
 
 std::string rigbase::to_decimal_be(unsigned long long d, int len)
 {
-	static std::string sdec_be;
+	std::string sdec_be;
 	sdec_be.clear();
 	for (int i = 0; i < len; i++) {
 		sdec_be += (char)((d % 10) + '0');
@@ -415,7 +407,7 @@ std::string rigbase::to_decimal_be(unsigned long long d, int len)
 
 std::string rigbase::to_decimal(unsigned long long d, int len)
 {
-	static std::string sdec;
+	std::string sdec;
 	sdec.clear();
 	std::string sdec_be = to_decimal_be(d, len);
 	int bcdlen = sdec_be.size();
@@ -497,28 +489,30 @@ int rigbase::hex2val(std::string hexstr)
 
 int rigbase::waitN(int n, int timeout, const char *sz, int pr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies.clear();	// not a pipelined query, see pipeline_hit
 
 	int retnbr = 0;
 
 	replystr.clear();
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 		return replystr.length();
 	}
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		LOG_DEBUG("TEST %s", sz);
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+	ullint ustart = zusec();
+	if (rig_tcpip()) {
 		send_to_remote(cmd);
 	}
 	else {
-		RigSerial->FlushBuffer();
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	}
 
 	ullint tstart = zmsec();
@@ -528,11 +522,11 @@ int rigbase::waitN(int n, int timeout, const char *sz, int pr)
 
 	do {
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			nret = read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(tempstr, n - retnbr);
+			nret = rig_port()->ReadBuffer(tempstr, n - retnbr);
 		}
 		if (nret) {
 			for (int nc = 0; nc < nret; nc++)
@@ -545,7 +539,9 @@ int rigbase::waitN(int n, int timeout, const char *sz, int pr)
 		MilliSleep(1);
 	} while  ( zmsec() < tout );
 
-	static char ctrace[1000];
+	stats_command(sz, zusec() - ustart, cmd.length(), retnbr, retnbr < n);
+
+	char ctrace[1000];
 	memset(ctrace, 0, 1000);
 	snprintf( ctrace, sizeof(ctrace), "%s: read %d bytes in %d msec, %s",
 		sz, retnbr,
@@ -561,31 +557,45 @@ int rigbase::waitN(int n, int timeout, const char *sz, int pr)
 
 int rigbase::wait_char(int ch, int n, int timeout, const char *sz, int pr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
 
 	std::string wait_str = " ";
 	wait_str[0] = ch;
 
 	int retnbr = 0;
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 		return replystr.length();
 	}
 
+	if (pipeline_hit(sz))
+		return replystr.length();
+
 	replystr.clear();
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		LOG_DEBUG("TEST %s", sz);
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+// with auto information on, reports may be waiting at the port or arrive
+// ahead of the reply; they are kept for the serial thread, see push_read
+	bool push = pushing && !rig_tcpip();
+	std::string prefix = cmd.substr(0, 2);
+	std::string stream;
+
+	ullint ustart = zusec();
+	if (rig_tcpip()) {
 		send_to_remote(cmd);
 	}
 	else {
-		RigSerial->FlushBuffer();
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		if (push) {
+			stream = push_stream;
+			push_stream.clear();
+		} else
+			rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	}
 
 	ullint tstart = zmsec();
@@ -597,19 +607,37 @@ int rigbase::wait_char(int ch, int n, int timeout, const char *sz, int pr)
 	do  {
 		++tries;
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			nret = read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(tempstr, n - retnbr, wait_str);
+			nret = rig_port()->ReadBuffer(tempstr, push ? 256 : n - retnbr, wait_str);
 		}
-		if (nret) {
+		if (nret && push) {
+			stream.append(tempstr);
+			size_t p;
+			while (replystr.empty() && (p = stream.find(wait_str)) != std::string::npos) {
+				std::string frame = stream.substr(0, p + 1);
+				stream.erase(0, p + 1);
+				if (frame.find(prefix) == 0 || frame == "?;")
+					replystr = frame;
+				else
+					push_stream.append(frame);
+			}
+			retnbr = replystr.length();
+			tout = zmsec() + progStatus.serial_timeout;
+		}
+		else if (nret) {
 			for (int nc = 0; nc < nret; nc++)
 				replystr += tempstr[nc];
 			retnbr += nret;
 			tout = zmsec() + progStatus.serial_timeout;
 		}
-		if (retnbr >= n)
+		if (push) {
+			if (!replystr.empty())
+				break;
+		}
+		else if (retnbr >= n)
 			break;
 
 		if (replystr.find(wait_str) != std::string::npos)
@@ -618,7 +646,13 @@ int rigbase::wait_char(int ch, int n, int timeout, const char *sz, int pr)
 		MilliSleep(1);
 	} while ( zmsec() < tout );
 
-	static char ctrace[1000];
+	if (push)
+		push_stream.append(stream);
+
+	stats_command(sz, zusec() - ustart, cmd.length(), retnbr,
+		retnbr < n && replystr.find(wait_str) == std::string::npos);
+
+	char ctrace[1000];
 	memset(ctrace, 0, 1000);
 	snprintf( ctrace, sizeof(ctrace), "%s: read %d bytes in %d msec, %d tries, %s",
 		sz, retnbr,
@@ -633,31 +667,209 @@ int rigbase::wait_char(int ch, int n, int timeout, const char *sz, int pr)
 	return retnbr;
 }
 
+//----------------------------------------------------------------------
+// Pipelined queries
+//
+// Several ';' terminated queries are written to the transceiver in a
+// single write and the replies read back in one pass.  Each reply is
+// matched, in order, to the query whose command prefix it carries and is
+// held until the driver's own wait_char() for that query consumes it.
+// Replies not consumed are discarded by the next pipeline() call or by
+// pipeline_flush(), which is also called by every sendCommand, and any
+// exchange that is not a pipelined query discards them as well, so that
+// a reply never outlives a change made to the transceiver.
+//----------------------------------------------------------------------
+int rigbase::pipeline(std::string queries, int timeout)
+{
+	guard_lock reply_lock(rig_reply_mutex());
+
+	if (!can_pipeline || rig_xmlrpc() || rig_tci())
+		return 0;
+	if (!rig_tcpip() && !rig_port()->IsOpen())
+		return 0;
+
+// a query answered by an unsolicited report is not sent again
+	std::vector<std::string> qlist;
+	size_t p0 = 0, p1;
+	while ((p1 = queries.find(';', p0)) != std::string::npos) {
+		std::string q = queries.substr(p0, p1 - p0 + 1);
+		if (p1 > p0 && pipeline_replies.find(q) == pipeline_replies.end())
+			qlist.push_back(q);
+		p0 = p1 + 1;
+	}
+	if (qlist.size() < 2) return 0;
+
+	std::string batch;
+	for (size_t n = 0; n < qlist.size(); n++)
+		batch.append(qlist[n]);
+
+	if (rig_tcpip()) {
+		send_to_remote(batch);
+	}
+	else {
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(batch.c_str(), batch.length());
+	}
+
+	ullint tstart = zmsec();
+	ullint tout = tstart + timeout;
+	std::string replies, tempstr;
+	size_t nterm = 0;
+	int nret;
+
+	do {
+		tempstr.clear();
+		if (rig_tcpip())
+			nret = read_from_remote(tempstr);
+		else
+			nret = rig_port()->ReadBuffer(tempstr, 256, ";");
+		if (nret) {
+			for (int nc = 0; nc < nret; nc++) {
+				replies += tempstr[nc];
+				if (tempstr[nc] == ';') nterm++;
+			}
+			tout = zmsec() + progStatus.serial_timeout;
+		}
+		if (nterm >= qlist.size())
+			break;
+		MilliSleep(1);
+	} while (zmsec() < tout);
+
+// demultiplex; a rejected query ("?;") leaves no entry and the
+// driver falls back to a normal exchange
+	size_t nq = 0;
+	p0 = 0;
+	while (nq < qlist.size() && (p1 = replies.find(';', p0)) != std::string::npos) {
+		std::string reply = replies.substr(p0, p1 - p0 + 1);
+		p0 = p1 + 1;
+		for (size_t n = nq; n < qlist.size(); n++) {
+			std::string prefix = qlist[n].substr(0, qlist[n].length() - 1);
+			if (reply.find(prefix) == 0) {
+				pipeline_replies[qlist[n]] = reply;
+				nq = n + 1;
+				break;
+			}
+		}
+	}
+
+	char ctrace[1000];
+	snprintf( ctrace, sizeof(ctrace), "pipeline: %s, read %d bytes in %d msec, %d/%d replies, %s",
+		batch.c_str(),
+		(int)replies.length(),
+		(int)(zmsec() - tstart),
+		(int)pipeline_replies.size(), (int)qlist.size(),
+		replies.c_str() );
+	ser_trace(1, ctrace);
+	LOG_DEBUG ("%s", ctrace);
+
+	return pipeline_replies.size();
+}
+
+void rigbase::pipeline_flush()
+{
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies.clear();
+}
+
+// Unsolicited status frames, read by the serial thread while the bus is
+// idle or set aside in push_stream by wait_char.  A frame is held as the reply to the query it answers so that the
+// poll entry it triggers is serviced without a bus exchange.
+int rigbase::push_read(std::vector<std::string> &frames)
+{
+	if (rig_tcpip() || !rig_port()->IsOpen())
+		return 0;
+
+	std::string eom = ICOMrig ? "\xFD" : ";";
+	std::string tempstr;
+
+	while (rig_port()->InputWaiting(0)) {
+		tempstr.clear();
+		if (!rig_port()->ReadBuffer(tempstr, 256, eom)) break;
+		push_stream.append(tempstr);
+	}
+
+	size_t p;
+	while ((p = push_stream.find(eom)) != std::string::npos) {
+		frames.push_back(push_stream.substr(0, p + 1));
+		push_stream.erase(0, p + 1);
+	}
+	if (push_stream.length() > 256) push_stream.clear();
+
+	return frames.size();
+}
+
+// ASCII: the query with the longest command prefix carried by the frame
+std::string rigbase::push_match(std::string &frame, std::string queries)
+{
+	std::string match;
+	size_t p0 = 0, p1;
+	while ((p1 = queries.find(';', p0)) != std::string::npos) {
+		std::string q = queries.substr(p0, p1 - p0 + 1);
+		p0 = p1 + 1;
+		if (q.length() < 2 || q.length() <= match.length()) continue;
+		if (frame.length() > q.length() && frame.find(q.substr(0, q.length() - 1)) == 0)
+			match = q;
+	}
+	return match;
+}
+
+void rigbase::push_reply(std::string query, std::string frame)
+{
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies[query] = frame;
+}
+
+// called with mutex_replystr held by every wait function, rigbase and
+// RIG_ICOM, before the command is sent; a command other than a pipelined
+// query may change the state the remaining replies describe
+bool rigbase::pipeline_hit(const char *sz)
+{
+	if (pipeline_replies.empty()) return false;
+
+	std::map<std::string, std::string>::iterator it = pipeline_replies.find(cmd);
+	if (it == pipeline_replies.end()) {
+		pipeline_replies.clear();
+		return false;
+	}
+
+	replystr = it->second;
+	pipeline_replies.erase(it);
+
+	char ctrace[1000];
+	snprintf( ctrace, sizeof(ctrace), "%s: pipelined, %s", sz, replystr.c_str());
+	ser_trace(1, ctrace);
+	LOG_DEBUG ("%s", ctrace);
+
+	return true;
+}
+
 int rigbase::wait_crlf(std::string cmd, std::string sz, int nr, int timeout, int pr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies.clear();	// not a pipelined query, see pipeline_hit
 
 	char crlf[3] = "\r\n";
 
 	int retnbr = 0;
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 		return replystr.length();
 	}
 
 	replystr.clear();
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+	ullint ustart = zusec();
+	if (rig_tcpip()) {
 		send_to_remote(cmd);
 	}
 	else {
-		RigSerial->FlushBuffer();
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	}
 
 	ullint tstart = zmsec();
@@ -667,11 +879,11 @@ int rigbase::wait_crlf(std::string cmd, std::string sz, int nr, int timeout, int
 
 	do {
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			nret = read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(tempstr, nr - retnbr, crlf);
+			nret = rig_port()->ReadBuffer(tempstr, nr - retnbr, crlf);
 		}
 		if (nret) {
 			replystr.append(tempstr);
@@ -687,7 +899,10 @@ int rigbase::wait_crlf(std::string cmd, std::string sz, int nr, int timeout, int
 		MilliSleep(1);
 	} while ( zmsec() < tout );
 
-	static char ctrace[1000];
+	stats_command(sz.c_str(), zusec() - ustart, cmd.length(), retnbr,
+		retnbr < nr && replystr.find(crlf) == std::string::npos);
+
+	char ctrace[1000];
 	memset(ctrace, 0, 1000);
 	std::string srx = replystr;
 	if (srx[0] == '\n') srx.replace(0,1,"<lf>");
@@ -710,28 +925,30 @@ int rigbase::wait_crlf(std::string cmd, std::string sz, int nr, int timeout, int
 
 int rigbase::wait_string(std::string sz, int nr, int timeout, int pr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies.clear();	// not a pipelined query, see pipeline_hit
 
 	int retnbr = 0;
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 		return replystr.length();
 	}
 
 	replystr.clear();
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		LOG_DEBUG("TEST %s", sz.c_str());
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+	ullint ustart = zusec();
+	if (rig_tcpip()) {
 		send_to_remote(cmd);
 	}
 	else {
-		RigSerial->FlushBuffer();
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	}
 
 	ullint tstart = zmsec();
@@ -741,11 +958,11 @@ int rigbase::wait_string(std::string sz, int nr, int timeout, int pr)
 
 	do {
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			nret = read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(tempstr, nr - retnbr, sz);
+			nret = rig_port()->ReadBuffer(tempstr, nr - retnbr, sz);
 		}
 		if (nret) {
 			replystr.append(tempstr);
@@ -761,7 +978,10 @@ int rigbase::wait_string(std::string sz, int nr, int timeout, int pr)
 		MilliSleep(1);
 	} while ( zmsec() < tout );
 
-	static char ctrace[1000];
+	stats_command(stats_command_name(cmd).c_str(), zusec() - ustart, cmd.length(), retnbr,
+		retnbr < nr && replystr.find(sz) == std::string::npos);
+
+	char ctrace[1000];
 	memset(ctrace, 0, 1000);
 
 	snprintf( ctrace, sizeof(ctrace), "%s: read %d bytes in %d msec, %s", 
@@ -779,11 +999,12 @@ int rigbase::wait_string(std::string sz, int nr, int timeout, int pr)
 
 int rigbase::waitfor(int nr, int timeout, int pr)
 {
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
+	pipeline_replies.clear();	// not a pipelined query, see pipeline_hit
 
 	int retnbr = 0;
 
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 //std::cout << "replystr: " << replystr << std::endl;
 		return replystr.length();
@@ -791,16 +1012,17 @@ int rigbase::waitfor(int nr, int timeout, int pr)
 
 	replystr.clear();
 
-	if(!progStatus.use_tcpip && !RigSerial->IsOpen()) {
+	if(!rig_tcpip() && !rig_port()->IsOpen()) {
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+	ullint ustart = zusec();
+	if (rig_tcpip()) {
 		send_to_remote(cmd);
 	}
 	else {
-		RigSerial->FlushBuffer();
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->FlushBuffer();
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 	}
 
 	ullint tstart = zmsec();
@@ -811,11 +1033,11 @@ int rigbase::waitfor(int nr, int timeout, int pr)
 
 	do {
 		tempstr.clear();
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			nret = read_from_remote(tempstr);
 		}
 		else {
-			nret = RigSerial->ReadBuffer(tempstr, nr - retnbr);
+			nret = rig_port()->ReadBuffer(tempstr, nr - retnbr);
 		}
 		if (nret) {
 			replystr.append(tempstr);
@@ -826,7 +1048,10 @@ int rigbase::waitfor(int nr, int timeout, int pr)
 		MilliSleep(1);
 	} while ( zmsec() < tout );
 
-	static char ctrace[1000];
+	stats_command(stats_command_name(cmd).c_str(), zusec() - ustart, cmd.length(), retnbr,
+		retnbr < nr);
+
+	char ctrace[1000];
 	memset(ctrace, 0, 1000);
 
 	snprintf( ctrace, sizeof(ctrace), "read %d bytes in %d msec, %s", 
@@ -851,24 +1076,24 @@ int rigbase::waitfor(int nr, int timeout, int pr)
 // retry - number of retries, default
 bool rigbase::id_OK(std::string ID, int wait)
 {
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		replystr = xml_cat_string(cmd);
 //std::cout << "replystr: " << replystr << std::endl;
 		return replystr.length();
 	}
 
-	guard_lock reply_lock(&mutex_replystr);
+	guard_lock reply_lock(rig_reply_mutex());
 
 	std::string buff;
 	int retn = 0;
 	size_t tout = 0;
 	for (int n = 0; n < progStatus.serial_retries; n++) {
-		if (progStatus.use_tcpip) {
+		if (rig_tcpip()) {
 			send_to_remote(cmd);
 		}
 		else {
-			RigSerial->FlushBuffer();
-			RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+			rig_port()->FlushBuffer();
+			rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 		}
 
 		replystr.clear();
@@ -878,11 +1103,11 @@ bool rigbase::id_OK(std::string ID, int wait)
 			MilliSleep(50);
 			buff.clear();
 
-			if (progStatus.use_tcpip) {
+			if (rig_tcpip()) {
 				retn = read_from_remote(buff);
 			}
 			else {
-				retn = RigSerial->ReadBuffer(buff, 10, ID, ";");
+				retn = rig_port()->ReadBuffer(buff, 10, ID, ";");
 			}
 			if (retn) {
 				replystr.append(buff);
@@ -902,7 +1127,7 @@ bool rigbase::id_OK(std::string ID, int wait)
 
 void rigbase::sendOK(std::string cmd)
 {
-	if (progStatus.xmlrpc_rig) {
+	if (rig_xmlrpc()) {
 		xml_cat_string(cmd);
 		return;
 	}
@@ -261,3 +261,32 @@ rigbase *rigs[] = {
 };
 
 //=============================================================================
+
+// a new instance of the named transceiver's driver, for a radio other
+// than the one selected on the panel; NULL if the name is not known or
+// the driver cannot run beside radio 0.
+//
+// Only drivers which keep their state in the instance are listed.  The
+// others read or write the panel's vfoA / vfoB / vfo, its widgets or
+// progStatus from their get and set functions (IC910 set_vfoA stores
+// vfoA.freq, IC7300 and FT950 select by vfo->imode, K3 by vfoA.imode),
+// keep scratch state in file statics, or are reached over tcp/ip or
+// TCI, and would mix their radio with radio 0.
+rigbase *new_rig(std::string name)
+{
+	if (name == rig_FT736R.name_) return new RIG_FT736R;
+	if (name == rig_FT747.name_) return new RIG_FT747;
+	if (name == rig_FT757GX2.name_) return new RIG_FT757GX2;
+	if (name == rig_FT767.name_) return new RIG_FT767;
+	if (name == rig_FT847.name_) return new RIG_FT847;
+	if (name == rig_FT920.name_) return new RIG_FT920;
+	if (name == rig_FT990.name_) return new RIG_FT990;
+	if (name == rig_FT990A.name_) return new RIG_FT990A;
+	if (name == rig_IC728.name_) return new RIG_IC728;
+	if (name == rig_IC735.name_) return new RIG_IC735;
+	if (name == rig_IC751.name_) return new RIG_IC751;
+	if (name == rig_ICR71.name_) return new RIG_ICR71;
+	if (name == rig_TMD710.name_) return new RIG_TMD710;
+	if (name == rig_TT563.name_) return new RIG_TT563;
+	return NULL;
+}
@@ -39,6 +39,7 @@
 #include "tentec/TT538.h"
 #include "support.h"
 #include "math.h"
+#include "radio.h"
 
 static const char TT538name_[] = "TT-538";
 
@@ -179,7 +180,7 @@ RIG_TT538::RIG_TT538() {
 
 void RIG_TT538::checkresponse(std::string s)
 {
-	if (RigSerial->IsOpen() == false)
+	if (rig_port()->IsOpen() == false)
 		return;
 	gTT(s.c_str());
 }
@@ -37,6 +37,8 @@
 
 #include "rigbase.h"
 #include "rig.h"
+#include "ui_refresh.h"
+#include "meter_history.h"
 
 static const char TT550name_[] = "TT-550";
 
@@ -1159,13 +1161,15 @@ int RIG_TT550::get_smeter()
 		sval = (int)(fval * 100.0 / 18.0);
 		if (sval > 100) sval = 0;
 		smtrval = sval;
-		Fl::awake(updateSmeter);
+		meter_record(MTR_SMETER, sval);
+		ui_mark(UI_SMETER);
 	}
 
 	else if (replystr[0] == 'T' && len > 3) {
 		fp = (unsigned char)replystr[1];
 		pwrval = fp;
-		Fl::awake(updateFwdPwr);
+		meter_record(MTR_POWER, (double)fp / power_scale());
+		ui_mark(UI_PWR);
 	}
 
 	std::stringstream s;
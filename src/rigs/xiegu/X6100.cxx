@@ -32,6 +32,7 @@
 #include "tod_clock.h"
 
 #include "support.h"
+#include "radio.h"
 
 //=============================================================================
 // X6100
@@ -336,7 +337,7 @@ void RIG_X6100::set_xcvr_auto_on()
 	get_trace(1, "getID()");
 
 	cmd.append(post);
-	RigSerial->failed(0);
+	rig_port()->failed(0);
 
 	if (waitFOR(8, "get ID") == false) {
 		cmd.clear();
@@ -344,13 +345,13 @@ void RIG_X6100::set_xcvr_auto_on()
 		if (progStatus.serial_baudrate >= 0 && progStatus.serial_baudrate <= 11) {
 			cmd.append( fes[progStatus.serial_baudrate], '\xFE');
 		}
-		RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+		rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 
 		cmd.assign(pre_to);
 		cmd += '\x18'; cmd += '\x01';
 		set_trace(1, "power_on()");
 		cmd.append(post);
-		RigSerial->failed(0);
+		rig_port()->failed(0);
 
 		if (waitFB("Power ON")) {
 			isett("power_on()");
@@ -360,18 +361,18 @@ void RIG_X6100::set_xcvr_auto_on()
 			int i = 0;
 			for (i = 0; i < 150; i++) { // 15 second total timeout
 				if (waitFOR(8, "get ID", 100) == true) {
-					RigSerial->failed(0);
+					rig_port()->failed(0);
 					return;
 				}
 				update_progress(i / 2);
 				Fl::awake();
 			}
-			RigSerial->failed(0);
+			rig_port()->failed(0);
 			return;
 		}
 
 		isett("power_on()");
-		RigSerial->failed(1);
+		rig_port()->failed(1);
 		return;
 	}
 }
@@ -208,7 +208,9 @@ RIG_FT991A::RIG_FT991A() {
 	has_ifshift_control =
 	has_ptt_control =
 	has_tune_control =
-	can_synch_clock = true;
+	can_synch_clock =
+	can_pipeline =
+	can_push = true;
 
 // derived specific
 	atten_state = 1;
@@ -551,6 +553,26 @@ const static PAIR swr_tbl[] = {
 	{255, 100 }, // infinity
 };
 
+// queries made by the poll entries, see rigbase::pipeline
+std::string RIG_FT991A::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ")   return "FA;FB;";
+	if (poll_name == "SMETER") return "SM0;";
+	if (poll_name == "MODE")   return (inuse == onB) ? "OI;" : "MD0;";
+	if (poll_name == "pout")   return "RM5;";
+	if (poll_name == "swr")    return "RM6;";
+	return "";
+}
+
+// auto information, see rigbase::push_read
+void RIG_FT991A::push_mode(bool on)
+{
+	cmd = on ? "AI1;" : "AI0;";
+	sendCommand(cmd);
+	showresp(INFO, ASC, "auto info", cmd, "");
+	sett("push_mode");
+}
+
 int RIG_FT991A::get_swr()
 {
 	PAIRS swr_pairs( define_PAIR(swr_tbl) );
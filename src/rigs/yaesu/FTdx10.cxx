@@ -27,6 +27,7 @@
 #include "yaesu/FTdx10.h"
 #include "debug.h"
 #include "support.h"
+#include "radio.h"
 
 enum mFTdx10 {
    mLSB, mUSB, mCW_U, mFM, mAM, mRTTY_L, mCW_L, mDATA_L, mRTTY_U, mDATA_FM, mFM_N, mDATA_U, mAM_N, mPSK, mDATA_FMN };
@@ -320,7 +321,7 @@ void RIG_FTdx10::set_xcvr_auto_on()
 
 	cmd = "PS1;";
 //	std::cout << "power ON" << std::endl;
-	RigSerial->WriteBuffer(cmd.c_str(), cmd.length());
+	rig_port()->WriteBuffer(cmd.c_str(), cmd.length());
 
 	update_progress(0);
 
@@ -335,7 +336,7 @@ void RIG_FTdx10::set_xcvr_auto_on()
 
 //	std::cout << "restart serial port" << std::endl;
 
-	RigSerial->OpenPort();
+	rig_port()->OpenPort();
 	cmd = "PS;";
 	wait_char(';', 4, 100, "closed/reopened port", ASC);
 	if (replystr.find("PS1;") == std::string::npos) {
@@ -272,7 +272,9 @@ RIG_FTdx101D::RIG_FTdx101D() {
 	has_ptt_control =
 	has_tune_control = 
 	has_xcvr_auto_on_off =
-	can_synch_clock = true;
+	can_synch_clock =
+	can_pipeline =
+	can_push = true;
 
 // derived specific
 	atten_state = 0;
@@ -566,6 +568,25 @@ int RIG_FTdx101D::get_smeter()
 	return mtr;
 }
 
+// queries made by the poll entries, see rigbase::pipeline
+std::string RIG_FTdx101D::pipeline_query(std::string poll_name)
+{
+	if (poll_name == "FREQ")   return "FA;FB;";
+	if (poll_name == "SMETER") return "SM0;";
+	if (poll_name == "MODE")   return (inuse == onB) ? "MD1;" : "MD0;";
+	if (poll_name == "swr")    return "RM6;";
+	return "";
+}
+
+// auto information, see rigbase::push_read
+void RIG_FTdx101D::push_mode(bool on)
+{
+	cmd = on ? "AI1;" : "AI0;";
+	sendCommand(cmd);
+	showresp(INFO, ASC, "auto info", cmd, "");
+	sett("push_mode");
+}
+
 int RIG_FTdx101D::get_swr()
 {
 	cmd = rsp = "RM6";
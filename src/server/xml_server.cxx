@@ -33,7 +33,9 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <fcntl.h>
+#include <time.h>
 #include <vector>
+#include <map>
 #include <pthread.h>
 #include <algorithm>
 
@@ -46,17 +48,35 @@
 #include "trace.h"
 
 #include "xml_server.h"
+#include "state_snapshot.h"
 #include "XmlRpc.h"
 #include "tod_clock.h"
+#include "cat_stats.h"
+#include "mem_bank.h"
+#include "meter_history.h"
+#include "band_sweep.h"
 #include "cwioUI.h"
 #include "ptt.h"
 
 #include "rigpanel.h"
+#include "ui_refresh.h"
+#include "radio.h"
 
 // The server
 using namespace XmlRpc;
 
-XmlRpcServer rig_server;
+// the state changed by a method is published once it has executed, see
+// rig.wait_update; a method that changes nothing leaves the version as is
+class rig_xml_server : public XmlRpcServer {
+public:
+	using XmlRpcServer::executeRequest;
+	void executeRequest(std::string const& request, std::string& response) {
+		XmlRpcServer::executeRequest(request, response);
+		publish_state();
+	}
+};
+
+rig_xml_server rig_server;
 
 
 void connection_OFF(void*) {
@@ -109,16 +129,52 @@ public:
 
 //------------------------------------------------------------------------------
 // Request for info
-//------------------------------------------------------------------------------
-std::string uname;
-std::string ufreq;
-std::string umode;
-std::string unotch;
-std::string ubw;
-std::string utx;
-std::string urfg;
-std::string uvol;
-std::string umic;
+//
+// rig.get_update and rig.wait_update return the lines which changed since
+// the same client's previous call.  Clients are told apart by the clientid
+// carried in the request; those sending none share a single record.  The
+// record of a client not heard from for UPDATE_CLIENT_IDLE seconds is
+// dropped, its next call then returns every line.
+//------------------------------------------------------------------------------
+struct UPDATE_INFO {
+	std::string uname;
+	std::string ufreq;
+	std::string umode;
+	std::string unotch;
+	std::string ubw;
+	std::string utx;
+	std::string urfg;
+	std::string uvol;
+	std::string umic;
+	unsigned long version;	// state version last sent by rig.wait_update
+	time_t used;			// time of the client's last call
+	UPDATE_INFO() : version(0), used(0) {}
+};
+
+#define UPDATE_CLIENT_IDLE 600
+
+static std::map<std::string, UPDATE_INFO> update_clients;
+static pthread_mutex_t mutex_updates = PTHREAD_MUTEX_INITIALIZER;
+
+// caller holds mutex_updates
+static UPDATE_INFO &client_info()
+{
+	static time_t pruned = 0;
+	time_t now = time(NULL);
+	if (now - pruned >= 60) {
+		pruned = now;
+		std::map<std::string, UPDATE_INFO>::iterator it = update_clients.begin();
+		while (it != update_clients.end()) {
+			if (now - it->second.used > UPDATE_CLIENT_IDLE)
+				update_clients.erase(it++);
+			else
+				++it;
+		}
+	}
+	UPDATE_INFO &u = update_clients[XmlRpc::get_client_id()];
+	u.used = now;
+	return u;
+}
 
 static std::string sname()
 {
@@ -227,16 +283,19 @@ public:
 			return;
 		}
 
-		uname = sname();   info.assign(uname);
-		utx = stx();       info.append(utx);
+		guard_lock lk(&mutex_updates);
+		UPDATE_INFO &u = client_info();
+
+		u.uname = sname();   info.assign(u.uname);
+		u.utx = stx();       info.append(u.utx);
 		freq_mode_bw();
-		ufreq = tempfreq;  info.append(ufreq);
-		umode = tempmode;  info.append(umode);
-		ubw = tempbw;      info.append(ubw);
-		unotch = snotch(); info.append(unotch);
-		uvol = svol();     info.append(uvol);
-		umic = smic();     info.append(umic);
-		urfg = srfg();     info.append(urfg);
+		u.ufreq = tempfreq;  info.append(u.ufreq);
+		u.umode = tempmode;  info.append(u.umode);
+		u.ubw = tempbw;      info.append(u.ubw);
+		u.unotch = snotch(); info.append(u.unotch);
+		u.uvol = svol();     info.append(u.uvol);
+		u.umic = smic();     info.append(u.umic);
+		u.urfg = srfg();     info.append(u.urfg);
 
 		result = info;
 
@@ -262,27 +321,30 @@ public:
 		}
 
 		if (selrig->has_smeter && !btnPTT->value()) {
-			static char szval[10];
+			char szval[10];
 			snprintf(szval, sizeof(szval), "S:%5.0f\n", smtrval);
 			info.append(szval);
 		}
 		if (selrig->has_power_out && btnPTT->value()) {
-			static char szval[10];
+			char szval[10];
 			snprintf(szval, sizeof(szval), "P:%5.0f\n", pwrval);
 			info.append(szval);
 		}
 
-		if ((temp = sname()) != uname) { uname = temp;     info.append(uname); }
-		if ((temp = stx()) != utx)     { utx = temp;       info.append(utx);}
+		guard_lock lk(&mutex_updates);
+		UPDATE_INFO &u = client_info();
+
+		if ((temp = sname()) != u.uname) { u.uname = temp;     info.append(u.uname); }
+		if ((temp = stx()) != u.utx)     { u.utx = temp;       info.append(u.utx);}
 
 		freq_mode_bw();
-		if (tempfreq != ufreq) { ufreq = tempfreq; info.append(ufreq); }
-		if (tempmode != umode) { umode = tempmode; info.append(umode); }
-		if (tempbw != ubw)     { ubw = tempbw;     info.append(ubw); }
-		if ((temp = snotch()) != unotch) { unotch = temp; info.append(unotch); }
-		uvol = svol();     info.append(uvol);
-		umic = smic();     info.append(umic);
-		urfg = srfg();     info.append(urfg);
+		if (tempfreq != u.ufreq) { u.ufreq = tempfreq; info.append(u.ufreq); }
+		if (tempmode != u.umode) { u.umode = tempmode; info.append(u.umode); }
+		if (tempbw != u.ubw)     { u.ubw = tempbw;     info.append(u.ubw); }
+		if ((temp = snotch()) != u.unotch) { u.unotch = temp; info.append(u.unotch); }
+		u.uvol = svol();     info.append(u.uvol);
+		u.umic = smic();     info.append(u.umic);
+		u.urfg = srfg();     info.append(u.urfg);
 
 		if (info.empty()) info.assign("NIL");
 
@@ -294,6 +356,507 @@ public:
 
 } rig_get_update(&rig_server);
 
+//------------------------------------------------------------------------------
+// Long poll for state changes
+//
+// rig.wait_update(since_version, timeout_msec) returns as soon as the
+// published state version differs from since_version, or when the timeout
+// expires.  The reply is a struct: "version" to pass to the next call and
+// "update", the changed lines in rig.get_update format ("NIL" if none).
+// A client whose since_version is not the one last sent to it receives
+// every line.
+//------------------------------------------------------------------------------
+#define MAX_WAIT_UPDATE 30000
+
+static int update_waiters = 0;
+
+static void snapshot_lines(const RIG_SNAPSHOT &snap, std::string &tx,
+			std::string &freq, std::string &mode, std::string &bw)
+{
+	const XCVR_STATE &vfo = (snap.inuse == onB) ? snap.B : snap.A;
+	char szval[20];
+
+	tx.assign("T:").append(snap.ptt ? "X" : "R").append("\n");
+
+	snprintf(szval, sizeof(szval), "%llu", (unsigned long long)vfo.freq);
+	freq.assign("F").append((snap.inuse == onB) ? "B:" : "A:").append(szval).append("\n");
+
+	mode.clear();
+	bw.clear();
+// the names are looked up in the driver's tables, which it changes
+// holding mutex_serial
+	guard_lock serial_lock(&mutex_serial, "xml update lines");
+	try {
+		int BW = vfo.iBW;
+		std::vector<std::string>& bwt = selrig->bwtable(vfo.imode);
+		std::vector<std::string>& dsplo = selrig->lotable(vfo.imode);
+		std::vector<std::string>& dsphi = selrig->hitable(vfo.imode);
+
+		mode.assign("M:").append(selrig->modes_.at(vfo.imode)).append("\n");
+
+		bw.assign("L:").append((BW > 256) ?
+						dsplo.at(BW & 0x7F) :
+						bwt.at(BW & 0x7F)).append("\n");
+		bw.append("U:").append((BW > 256) ?
+						dsphi.at((BW >> 8) & 0x7F) : "n/a").append("\n");
+	} catch (const std::exception& e) {
+		LOG_ERROR("%s", e.what());
+	}
+}
+
+class rig_wait_update : public XmlRpcServerMethod {
+public:
+	rig_wait_update(XmlRpcServer* s) : XmlRpcServerMethod("rig.wait_update", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		unsigned long since = 0;
+		int msec = 0;
+		if (params.getType() == XmlRpcValue::TypeArray) {
+			if (params.size() > 0) since = (unsigned long)int(params[0]);
+			if (params.size() > 1) msec = int(params[1]);
+		}
+		if (msec > MAX_WAIT_UPDATE) msec = MAX_WAIT_UPDATE;
+
+// keep workers free for the other methods
+		{
+			guard_lock lk(&mutex_updates);
+			if (update_waiters >= rig_server.getWorkers() - 2) msec = 0;
+			else if (msec > 0) update_waiters++;
+			else msec = 0;
+		}
+
+		RIG_SNAPSHOT snap;
+		wait_state(since, snap, msec);
+
+		std::string tx, freq, mode, bw;
+		if (snap.online && selrig)
+			snapshot_lines(snap, tx, freq, mode, bw);
+
+		std::string info;
+		{
+			guard_lock lk(&mutex_updates);
+			if (msec > 0) update_waiters--;
+
+			UPDATE_INFO &u = client_info();
+			bool all = (since != u.version);
+			if (all || tx != u.utx)     { u.utx = tx;     info.append(tx); }
+			if (all || freq != u.ufreq) { u.ufreq = freq; info.append(freq); }
+			if (all || mode != u.umode) { u.umode = mode; info.append(mode); }
+			if (all || bw != u.ubw)     { u.ubw = bw;     info.append(bw); }
+			u.version = snap.version;
+		}
+		if (info.empty()) info.assign("NIL");
+
+		result["version"] = int(snap.version);
+		result["update"] = info;
+xml_trace(2, "rig_wait_update ", info.c_str());
+	}
+
+	std::string help() { return std::string("waits for a state change, returns version and changes; returns at once if all workers are busy"); }
+
+} rig_wait_update(&rig_server);
+
+//------------------------------------------------------------------------------
+// rig.get_stats returns the latency statistics kept for each CAT command,
+// poll function, named mutex and keyer, busiest first; times are in msec.
+// Counts are doubles, an XML-RPC int is 32 bits and would wrap.
+//------------------------------------------------------------------------------
+static void stats_array(int kind, XmlRpcValue &list)
+{
+	std::vector<STATS_SUMMARY> stats;
+	stats_summary(kind, stats);
+	list.setSize(stats.size());
+	for (size_t n = 0; n < stats.size(); n++) {
+		STATS_SUMMARY &s = stats[n];
+		XmlRpcValue &v = list[(int)n];
+		v["name"] = s.name;
+		v["count"] = (double)s.count;
+		v["total"] = s.total;
+		v["mean"] = s.mean;
+		v["p50"] = s.p50;
+		v["p90"] = s.p90;
+		v["p99"] = s.p99;
+		v["max"] = s.max;
+		if (kind == STATS_CMD) {
+			v["tx_bytes"] = (double)s.tx_bytes;
+			v["rx_bytes"] = (double)s.rx_bytes;
+			v["timeouts"] = (double)s.timeouts;
+		}
+	}
+}
+
+class rig_get_stats : public XmlRpcServerMethod {
+public:
+	rig_get_stats(XmlRpcServer* s) : XmlRpcServerMethod("rig.get_stats", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		stats_array(STATS_CMD, result["commands"]);
+		stats_array(STATS_POLL, result["polls"]);
+		stats_array(STATS_LOCK_WAIT, result["lock_wait"]);
+		stats_array(STATS_LOCK_HOLD, result["lock_hold"]);
+		stats_array(STATS_TIMING, result["timing"]);
+	}
+
+	std::string help() { return std::string("returns latency statistics of commands, polls and mutexes"); }
+
+} rig_get_stats(&rig_server);
+
+//------------------------------------------------------------------------------
+// frequency memories
+//   a memory is a struct {freq, mode, bw, tag}, freq in Hz, mode and bw by
+//   name or by table index.  The memory bank has its own lock, so these run
+//   alongside the other methods and the memory dialog is rebuilt once by the
+//   main thread however many memories are changed.  The mode and bandwidth
+//   tables belong to the driver and are looked up under mutex_serial, never
+//   across a memory bank call.
+//------------------------------------------------------------------------------
+
+static double xml_number(XmlRpcValue &v)
+{
+	switch (v.getType()) {
+		case XmlRpcValue::TypeInt:      return int(v);
+		case XmlRpcValue::TypeUnsigned: return (unsigned int)(v);
+		case XmlRpcValue::TypeLongLong: return (long long)(v);
+		case XmlRpcValue::TypeDouble:   return double(v);
+		case XmlRpcValue::TypeString:   return atof(std::string(v).c_str());
+		default: return -1;
+	}
+}
+
+static int xml_mode(XmlRpcValue &v)
+{
+	if (v.getType() != XmlRpcValue::TypeString)
+		return (int)xml_number(v);
+	std::string name = v;
+	for (size_t i = 0; i < selrig->modes_.size(); i++)
+		if (name == selrig->modes_[i]) return i;
+	return -1;
+}
+
+static int xml_bw(XmlRpcValue &v, int imode)
+{
+	if (v.getType() != XmlRpcValue::TypeString)
+		return (int)xml_number(v);
+	std::string name = v;
+	std::vector<std::string> &bws = selrig->bwtable(imode);
+	for (size_t i = 0; i < bws.size(); i++)
+		if (name == bws[i]) return i;
+	return selrig->def_bandwidth(imode);
+}
+
+static bool xml_to_memory(XmlRpcValue &v, MEMORY &m)
+{
+	if (v.getType() != XmlRpcValue::TypeStruct ||
+		!v.hasMember("freq") || !v.hasMember("mode"))
+		return false;
+	double freq = xml_number(v["freq"]);
+	int imode = xml_mode(v["mode"]);
+	if (freq <= 0 || imode < 0 || imode >= (int)selrig->modes_.size())
+		return false;
+	m.freq = (unsigned long long)(freq + 0.5);
+	m.imode = imode;
+	m.iBW = v.hasMember("bw") ? xml_bw(v["bw"], imode) : selrig->def_bandwidth(imode);
+	if (m.iBW < 0) m.iBW = 0;
+	m.tag.clear();
+	if (v.hasMember("tag") && v["tag"].getType() == XmlRpcValue::TypeString)
+		m.tag = std::string(v["tag"]);
+	return true;
+}
+
+static void memory_to_xml(const MEMORY &m, const std::string &mode,
+		const std::string &bw, XmlRpcValue &v)
+{
+	v["freq"] = (double)m.freq;
+	v["mode"] = mode;
+	v["bw"]   = bw;
+	v["tag"]  = m.tag;
+}
+
+class rig_mem_list : public XmlRpcServerMethod {
+public:
+	rig_mem_list(XmlRpcServer* s) : XmlRpcServerMethod("rig.mem_list", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		MEM_FILTER filter;
+		if (params.getType() == XmlRpcValue::TypeArray && params.size() > 0 &&
+			params[0].getType() == XmlRpcValue::TypeString)
+			filter.parse(std::string(params[0]));
+
+		std::vector<MEMORY> list;
+		if (filter.hi)
+			mem_bank.query(filter.lo, filter.hi, list);
+		else
+			mem_bank.list(list);
+
+		std::vector<MEMORY> shown;
+		for (size_t i = 0; i < list.size(); i++)
+			if (filter.match(list[i]))
+				shown.push_back(list[i]);
+
+		std::vector<std::string> modes, bws;
+		{
+			guard_lock serial_lock(&mutex_serial, "xml rig_mem_list");
+			for (size_t i = 0; i < shown.size(); i++) {
+				modes.push_back(selrig->get_modename_(shown[i].imode));
+				bws.push_back(selrig->get_bwname_(shown[i].iBW, shown[i].imode));
+			}
+		}
+
+		result.setSize(0);
+		try {
+			for (size_t i = 0; i < shown.size(); i++)
+				memory_to_xml(shown[i], modes[i], bws[i], result[(int)i]);
+		} catch (const std::exception& e) {
+			LOG_ERROR("%s", e.what());
+		}
+	}
+
+	std::string help() { return std::string("returns memories in a band (20m), kHz range (14000-14350) or with tag text, by frequency"); }
+
+} rig_mem_list(&rig_server);
+
+class rig_mem_add : public XmlRpcServerMethod {
+public:
+	rig_mem_add(XmlRpcServer* s) : XmlRpcServerMethod("rig.mem_add", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		MEMORY m;
+		result = 0;
+		if (params.getType() != XmlRpcValue::TypeArray || params.size() < 1)
+			return;
+		{
+			guard_lock serial_lock(&mutex_serial, "xml rig_mem_add");
+			if (!xml_to_memory(params[0], m))
+				return;
+		}
+		mem_bank.add(m);
+		result = 1;
+	}
+
+	std::string help() { return std::string("add memory {freq, mode, bw, tag}, replaces one at the same freq and mode"); }
+
+} rig_mem_add(&rig_server);
+
+class rig_mem_add_list : public XmlRpcServerMethod {
+public:
+	rig_mem_add_list(XmlRpcServer* s) : XmlRpcServerMethod("rig.mem_add_list", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		result = 0;
+		if (params.getType() != XmlRpcValue::TypeArray || params.size() < 1 ||
+			params[0].getType() != XmlRpcValue::TypeArray)
+			return;
+
+		XmlRpcValue &entries = params[0];
+		std::vector<MEMORY> list;
+		list.reserve(entries.size());
+		MEMORY m;
+		{
+			guard_lock serial_lock(&mutex_serial, "xml rig_mem_add_list");
+			for (int i = 0; i < entries.size(); i++)
+				if (xml_to_memory(entries[i], m))
+					list.push_back(m);
+		}
+		mem_bank.add(list);
+		result = (int)list.size();
+	}
+
+	std::string help() { return std::string("add array of memories {freq, mode, bw, tag}, returns number added"); }
+
+} rig_mem_add_list(&rig_server);
+
+class rig_mem_delete : public XmlRpcServerMethod {
+public:
+	rig_mem_delete(XmlRpcServer* s) : XmlRpcServerMethod("rig.mem_delete", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		result = 0;
+		if (params.getType() != XmlRpcValue::TypeArray || params.size() < 2)
+			return;
+		double freq = xml_number(params[0]);
+		int imode;
+		{
+			guard_lock serial_lock(&mutex_serial, "xml rig_mem_delete");
+			imode = xml_mode(params[1]);
+		}
+		if (freq <= 0 || imode < 0)
+			return;
+		result = (int)mem_bank.remove((unsigned long long)(freq + 0.5), imode);
+	}
+
+	std::string help() { return std::string("delete memory at freq (Hz) and mode"); }
+
+} rig_mem_delete(&rig_server);
+
+class rig_mem_clear : public XmlRpcServerMethod {
+public:
+	rig_mem_clear(XmlRpcServer* s) : XmlRpcServerMethod("rig.mem_clear", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+		mem_bank.clear();
+	}
+
+	std::string help() { return std::string("delete all memories"); }
+
+} rig_mem_clear(&rig_server);
+
+//------------------------------------------------------------------------------
+// rig.get_meter_history returns the readings kept for one meter
+//   params: meter name (smeter, power, swr, alc, idd, volts),
+//           resolution (raw, sec, min; default sec),
+//           since, seconds since the epoch (default 0, all)
+//   result: array of [time, min, avg, max], oldest first
+//------------------------------------------------------------------------------
+class rig_get_meter_history : public XmlRpcServerMethod {
+public:
+	rig_get_meter_history(XmlRpcServer* s) : XmlRpcServerMethod("rig.get_meter_history", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		result.setSize(0);
+		if (params.getType() != XmlRpcValue::TypeArray || params.size() < 1 ||
+			params[0].getType() != XmlRpcValue::TypeString)
+			return;
+		int meter = meter_index(std::string(params[0]));
+		int resolution = MTR_SECOND;
+		if (params.size() > 1 && params[1].getType() == XmlRpcValue::TypeString)
+			resolution = meter_resolution(std::string(params[1]));
+		double since = 0;
+		if (params.size() > 2)
+			since = xml_number(params[2]);
+		if (meter < 0 || resolution < 0)
+			return;
+
+		std::vector<METER_POINT> points;
+		meter_history(meter, resolution, since, points);
+		result.setSize(points.size());
+		for (size_t n = 0; n < points.size(); n++) {
+			XmlRpcValue &v = result[(int)n];
+			v[0] = points[n].t;
+			v[1] = (double)points[n].min;
+			v[2] = (double)points[n].avg;
+			v[3] = (double)points[n].max;
+		}
+	}
+
+	std::string help() { return std::string("returns [time, min, avg, max] readings of a meter: raw, per second or per minute"); }
+
+} rig_get_meter_history(&rig_server);
+
+//------------------------------------------------------------------------------
+// band sweep
+//   rig.sweep_start(start, stop, step Hz, settle msec) steps the active vfo
+//   and reads the S-meter at each frequency; rig.sweep_read(next, msec)
+//   returns the points from index 'next' on, waiting up to msec for new
+//   ones, so a client follows the sweep as it runs:
+//     {running, total, next, points: [[freq, level], ...]}
+//------------------------------------------------------------------------------
+class rig_sweep_start : public XmlRpcServerMethod {
+public:
+	rig_sweep_start(XmlRpcServer* s) : XmlRpcServerMethod("rig.sweep_start", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		if (params.getType() != XmlRpcValue::TypeArray || params.size() < 3) {
+			result = "start, stop and step required";
+			return;
+		}
+		double start = xml_number(params[0]);
+		double stop = xml_number(params[1]);
+		double step = xml_number(params[2]);
+		int settle = 20;
+		if (params.size() > 3) settle = (int)xml_number(params[3]);
+
+		std::string err;
+		if (disable_xmlrpc->value())
+			err = "xmlrpc disabled";
+		else if (start <= 0 || stop <= 0 || step < 1)
+			err = "invalid range";
+		else if (sweep_start((unsigned long long)(start + 0.5),
+							 (unsigned long long)(stop + 0.5),
+							 (unsigned long long)(step + 0.5), settle, err))
+			err = "OK";
+		result = err;
+	}
+
+	std::string help() { return std::string("start a sweep: start, stop, step Hz, settle msec; returns OK or the reason"); }
+
+} rig_sweep_start(&rig_server);
+
+class rig_sweep_read : public XmlRpcServerMethod {
+public:
+	rig_sweep_read(XmlRpcServer* s) : XmlRpcServerMethod("rig.sweep_read", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		int next = 0;
+		int msec = 0;
+		if (params.getType() == XmlRpcValue::TypeArray) {
+			if (params.size() > 0) next = (int)xml_number(params[0]);
+			if (params.size() > 1) msec = (int)xml_number(params[1]);
+		}
+		if (next < 0) next = 0;
+		if (msec > MAX_WAIT_UPDATE) msec = MAX_WAIT_UPDATE;
+
+// keep workers free for the other methods
+		{
+			guard_lock lk(&mutex_updates);
+			if (update_waiters >= rig_server.getWorkers() - 2) msec = 0;
+			else if (msec > 0) update_waiters++;
+			else msec = 0;
+		}
+
+		std::vector<SWEEP_POINT> points;
+		bool running = false;
+		size_t total = sweep_read(next, points, running, msec);
+
+		if (msec > 0) {
+			guard_lock lk(&mutex_updates);
+			update_waiters--;
+		}
+
+		result["running"] = running;
+		result["total"] = (int)total;
+		result["next"] = (int)(next + points.size());
+		XmlRpcValue &list = result["points"];
+		list.setSize(points.size());
+		for (size_t n = 0; n < points.size(); n++) {
+			list[(int)n][0] = (double)points[n].freq;
+			list[(int)n][1] = points[n].level;
+		}
+	}
+
+	std::string help() { return std::string("returns sweep points [freq, level] from index next, waiting up to msec for new ones"); }
+
+} rig_sweep_read(&rig_server);
+
+class rig_sweep_stop : public XmlRpcServerMethod {
+public:
+	rig_sweep_stop(XmlRpcServer* s) : XmlRpcServerMethod("rig.sweep_stop", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+		sweep_stop();
+	}
+
+	std::string help() { return std::string("end the sweep in progress and restore the vfo"); }
+
+} rig_sweep_stop(&rig_server);
+
 
 //------------------------------------------------------------------------------
 // Request for PTT state
@@ -305,7 +868,9 @@ public:
 		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
 		Fl::awake(connection_ON);
 
-		result = int(PTT);
+		RIG_SNAPSHOT snap;
+		read_state(snap);
+		result = int(snap.ptt);
 	}
 
 	std::string help() { return std::string("returns state of PTT"); }
@@ -324,10 +889,16 @@ public:
 		Fl::awake(connection_ON);
 
 
-		guard_lock serial(&mutex_serial, "xml 01");
-
-		int split_state = selrig->get_split();
-		progStatus.split = split_state;
+		int split_state;
+		if (progStatus.poll_split) {
+			RIG_SNAPSHOT snap;
+			read_state(snap);
+			split_state = snap.split;
+		} else {
+			guard_lock serial(&mutex_serial, "xml 01");
+			split_state = selrig->get_split();
+			progStatus.split = split_state;
+		}
 		result = split_state;
 xml_trace(2, "rig_get_split ", (split_state ? "ON" : "OFF"));
 	}
@@ -351,19 +922,20 @@ public:
 			return;
 		}
 
-		static char szfreq[20];
+		char szfreq[20];
 		unsigned long long freq;
 
-		guard_lock serial_lock(&mutex_serial, "xml rig_get_vfo");
+		RIG_SNAPSHOT snap;
+		read_state(snap);
 
 		if (selrig->ICOMmainsub) {
-			if (progStatus.split && PTT) freq = vfoB.freq;
-			else freq = vfoA.freq;
+			if (snap.split && snap.ptt) freq = snap.B.freq;
+			else freq = snap.A.freq;
 		} else {
-			if (selrig->inuse == onB)
-				freq = vfoB.freq;
+			if (snap.inuse == onB)
+				freq = snap.B.freq;
 			else
-				freq = vfoA.freq;
+				freq = snap.A.freq;
 		}
 
 		snprintf(szfreq, sizeof(szfreq), "%llu", freq);
@@ -390,15 +962,24 @@ public:
 			result = "14070000";
 			return;
 		}
-//		int freq;
-
-		guard_lock serial(&mutex_serial, "xml 02");
+		unsigned long long freq;
 
-		vfoA.freq = selrig->get_vfoA();
-		Fl::awake(setFreqDispA);
+		if (progStatus.poll_frequency) {
+			RIG_SNAPSHOT snap;
+			read_state(snap);
+			freq = snap.A.freq;
+		} else {
+			guard_lock serial(&mutex_serial, "xml 02");
+			freq = selrig->get_vfoA();
+// a band sweep moves the vfo, the operating frequency stays for the restore
+			if (!sweep_running()) {
+				vfoA.freq = freq;
+				ui_mark(UI_FREQ_A);
+			}
+		}
 
-		static char szfreq[20];
-		snprintf(szfreq, sizeof(szfreq), "%llu", vfoA.freq);
+		char szfreq[20];
+		snprintf(szfreq, sizeof(szfreq), "%llu", freq);
 		std::string result_string = szfreq;
 xml_trace(2, "rig_get_vfoA", szfreq);
 
@@ -423,13 +1004,24 @@ public:
 			result = "14070000";
 			return;
 		}
-		guard_lock serial(&mutex_serial, "xml 03");
+		unsigned long long freq;
 
-		vfoB.freq = selrig->get_vfoB();
-		Fl::awake(setFreqDispB);
+		if (progStatus.poll_frequency) {
+			RIG_SNAPSHOT snap;
+			read_state(snap);
+			freq = snap.B.freq;
+		} else {
+			guard_lock serial(&mutex_serial, "xml 03");
+			freq = selrig->get_vfoB();
+// a band sweep moves the vfo, the operating frequency stays for the restore
+			if (!sweep_running()) {
+				vfoB.freq = freq;
+				ui_mark(UI_FREQ_B);
+			}
+		}
 
-		static char szfreq[20];
-		snprintf(szfreq, sizeof(szfreq), "%llu", vfoB.freq);
+		char szfreq[20];
+		snprintf(szfreq, sizeof(szfreq), "%llu", freq);
 		std::string result_string = szfreq;
 xml_trace(2, "rig_get_vfoB", szfreq);
 
@@ -456,10 +1048,11 @@ public:
 			return;
 		}
 
-		guard_lock serial_lock(&mutex_serial, "xml rig_get_AB");
+		RIG_SNAPSHOT snap;
+		read_state(snap);
 
-		xml_trace(2, "rig_get_AB: " , ((selrig->inuse == onB) ? "B" : "A"));
-		result = (selrig->inuse == onB) ? "B" : "A";
+		xml_trace(2, "rig_get_AB: " , ((snap.inuse == onB) ? "B" : "A"));
+		result = (snap.inuse == onB) ? "B" : "A";
 	}
 
 	std::string help() { return std::string("returns vfo in use A or B"); }
@@ -509,6 +1102,7 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_notch");
 		static int ntch;
 		ntch = (int)(params[0]);
 		progStatus.notch_val = ntch;
@@ -516,8 +1110,6 @@ public:
 			progStatus.notch = true;
 		else
 			progStatus.notch = false;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_notch");
 		selrig->set_notch(progStatus.notch, progStatus.notch_val);
 		xml_trace(1, "rig_set_notch");
 		Fl::awake(setNotchControl, static_cast<void *>(&ntch));
@@ -539,6 +1131,7 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_notch");
 		static int ntch;
 		ntch = (int)(params[0]);
 		progStatus.notch_val = ntch;
@@ -546,8 +1139,6 @@ public:
 			progStatus.notch = true;
 		else
 			progStatus.notch = false;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_notch");
 		selrig->set_notch(progStatus.notch, progStatus.notch_val);
 		xml_trace(1, "rig_set_verify_notch");
 		Fl::awake(setNotchControl, static_cast<void *>(&ntch));
@@ -601,11 +1192,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_rfgain");
 		static int rfg;
 		rfg = static_cast<int>((double)((params[0])));
 		progStatus.rfgain = rfg;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_rfgain");
 		selrig->set_rf_gain(progStatus.rfgain);
 		xml_trace(1, "rig_set_rfgain");
 		Fl::awake(setRFGAINControl, static_cast<void *>(0));
@@ -627,11 +1217,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set _verify_rfgain");
 		static int rfg;
 		rfg = static_cast<int>((double)((params[0])));
 		progStatus.rfgain = rfg;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set _verify_rfgain");
 		selrig->set_rf_gain(progStatus.rfgain);
 
 		progStatus.rfgain = selrig->get_rf_gain();
@@ -718,11 +1307,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_micgain");
 		static int micg;
 		micg = (int)(params[0]);
 		progStatus.mic_gain = micg;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_micgain");
 		xml_trace(1, "rig_set_micgain");
 		selrig->set_mic_gain(progStatus.mic_gain);
 		Fl::awake(setMicGainControl, static_cast<void *>(0));
@@ -744,11 +1332,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_micgain");
 		static int micg;
 		micg = (int)(params[0]);
 		progStatus.mic_gain = micg;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_micgain");
 		xml_trace(1, "rig_set_verify_micgain");
 		selrig->set_mic_gain(progStatus.mic_gain);
 
@@ -805,11 +1392,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_volume");
 		static int volume;
 		volume = (int)(params[0]);
 		progStatus.volume = volume;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_volume");
 		selrig->set_volume_control(progStatus.volume);
 		xml_trace(1, "rig_set_volume");
 		Fl::awake(setVolumeControl, static_cast<void *>(0));
@@ -831,11 +1417,10 @@ public:
 			return;
 		}
 
+		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_volume");
 		static int volume;
 		volume = (int)(params[0]);
 		progStatus.volume = volume;
-
-		guard_lock serial_lock(&mutex_serial, "xml rig_set_verify_volume");
 		selrig->set_volume_control(progStatus.volume);
 
 		progStatus.volume = selrig->get_volume_control();
@@ -973,13 +1558,17 @@ public:
 		int mode;
 
 		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_mode");
+			RIG_SNAPSHOT snap;
+			read_state(snap);
 
-			mode = vfo->imode;
+			mode = (snap.inuse == onB) ? snap.B.imode : snap.A.imode;
 
 			std::string result_string = "none";
-			result_string = selrig->modes_.at(mode);
-			xml_trace(2, "mode on ", ((selrig->inuse == onB) ? "B " : "A "), result_string.c_str());
+			{
+				guard_lock serial_lock(&mutex_serial, "xml get mode");
+				result_string = selrig->modes_.at(mode);
+			}
+			xml_trace(2, "mode on ", ((snap.inuse == onB) ? "B " : "A "), result_string.c_str());
 			result = result_string;
 		} catch (const std::exception& e) {
 			LOG_ERROR("%s", e.what());
@@ -1010,12 +1599,16 @@ public:
 		int mode;
 
 		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_mode");
+			RIG_SNAPSHOT snap;
+			read_state(snap);
 
-			mode = vfoA.imode;
+			mode = snap.A.imode;
 
 			std::string result_string = "none";
-			result_string = selrig->modes_.at(mode);
+			{
+				guard_lock serial_lock(&mutex_serial, "xml get mode");
+				result_string = selrig->modes_.at(mode);
+			}
 			xml_trace(2, "mode A ", result_string.c_str());
 			result = result_string;
 		} catch (const std::exception& e) {
@@ -1048,12 +1641,16 @@ public:
 		int mode;
 
 		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_mode");
+			RIG_SNAPSHOT snap;
+			read_state(snap);
 
-			mode = vfoB.imode;
+			mode = snap.B.imode;
 
 			std::string result_string = "none";
-			result_string = selrig->modes_.at(mode);
+			{
+				guard_lock serial_lock(&mutex_serial, "xml get mode");
+				result_string = selrig->modes_.at(mode);
+			}
 			xml_trace(2, "mode B ", result_string.c_str());
 			result = result_string;
 		} catch (const std::exception& e) {
@@ -1155,19 +1752,23 @@ public:
 
 
 
-		int BW = (selrig->inuse == onB) ? vfoB.iBW : vfoA.iBW;
-		int mode = (selrig->inuse == onB) ? vfoB.imode : vfoA.imode;
+		RIG_SNAPSHOT snap;
+		read_state(snap);
 
-		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_bw");
+		int BW = (snap.inuse == onB) ? snap.B.iBW : snap.A.iBW;
+		int mode = (snap.inuse == onB) ? snap.B.imode : snap.A.imode;
 
+		try {
 			if (!selrig->has_bandwidth_control)
 				return;
 
+// the driver changes its tables holding mutex_serial
+			guard_lock serial_lock(&mutex_serial, "xml get bw");
+
 			result[0] = result[1] = "";
 			if (BW < 256) {
 				std::vector<std::string>& bwt = selrig->bwtable(mode);
-				result[0] = bwt[BW & 0x7F];
+				result[0] = bwt.at(BW & 0x7F);
 			}
 			else {
 				std::vector<std::string>& dsplo = selrig->lotable(mode);
@@ -1180,7 +1781,7 @@ public:
 			result[0] = result[1] = "";
 		}
 		std::string s1 = result[0], s2 = result[1];
-		xml_trace( 5, "bandwidth on ", ((selrig->inuse == onB) ? "B " : "A "), s1.c_str(), " | ", s2.c_str());
+		xml_trace( 5, "bandwidth on ", ((snap.inuse == onB) ? "B " : "A "), s1.c_str(), " | ", s2.c_str());
 	}
 
 	std::string help() { return std::string("returns current bw L/U value"); }
@@ -1206,15 +1807,19 @@ public:
 
 
 
-		int BW = vfoA.iBW;
-		int mode = vfoA.imode;
+		RIG_SNAPSHOT snap;
+		read_state(snap);
 
-		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_bwA");
+		int BW = snap.A.iBW;
+		int mode = snap.A.imode;
 
+		try {
 			if (!selrig->has_bandwidth_control)
 				return;
 
+// the driver changes its tables holding mutex_serial
+			guard_lock serial_lock(&mutex_serial, "xml get bw");
+
 			result[0] = result[1] = "";
 			if (BW < 256) {
 				std::vector<std::string>& bwt = selrig->bwtable(mode);
@@ -1258,16 +1863,20 @@ public:
 
 
 
-		int BW = vfoB.iBW;
-		int mode = vfoB.imode;
+		RIG_SNAPSHOT snap;
+		read_state(snap);
+
+		int BW = snap.B.iBW;
+		int mode = snap.B.imode;
 		result[0] = result[1] = "";
 
 		try {
-			guard_lock serial_lock(&mutex_serial, "xml rig_get_bwB");
-
 			if (!selrig->has_bandwidth_control)
 				return;
 
+// the driver changes its tables holding mutex_serial
+			guard_lock serial_lock(&mutex_serial, "xml get bw");
+
 			if (BW < 256) {
 				std::vector<std::string>& bwt = selrig->bwtable(mode);
 				result[0] = bwt.at(BW & 0x7F);
@@ -1290,6 +1899,31 @@ public:
 
 } rig_get_bwB(&rig_server);
 
+//------------------------------------------------------------------------------
+// meter readings come from the published state when the meter is polled
+//------------------------------------------------------------------------------
+static int smeter_value(const char *how)
+{
+	if (progStatus.poll_smeter) {
+		RIG_SNAPSHOT snap;
+		read_state(snap);
+		return snap.smeter;
+	}
+	guard_lock serial_lock(&mutex_serial, how);
+	return selrig->get_smeter();
+}
+
+static int swr_value(const char *how)
+{
+	if (progStatus.poll_swr) {
+		RIG_SNAPSHOT snap;
+		read_state(snap);
+		return snap.swr;
+	}
+	guard_lock serial_lock(&mutex_serial, how);
+	return selrig->get_swr();
+}
+
 class rig_get_smeter : public XmlRpcServerMethod {
 public:
 	rig_get_smeter(XmlRpcServer* s) : XmlRpcServerMethod("rig.get_smeter", s) {}
@@ -1300,8 +1934,7 @@ public:
 		if (!xcvr_online || disable_xmlrpc->value() || !selrig->has_smeter)
 			result = "0";
 		else {
-			guard_lock serial_lock(&mutex_serial, "xml 04");
-			int val = selrig->get_smeter();
+			int val = smeter_value("xml 04");
 
 			char szMeter[20];
 			snprintf(szMeter, sizeof(szMeter), "%d", val);
@@ -1324,8 +1957,7 @@ public:
 		if (!xcvr_online || disable_xmlrpc->value() || !selrig->has_smeter)
 			result = "0";
 		else {
-			guard_lock serial_lock(&mutex_serial, "xml 05");
-			int val = selrig->get_smeter();
+			int val = smeter_value("xml 05");
 			if (val > 50) val = round(-73.0 + (val - 50.0) * 6.0 / 5.0);
 			else          val = round(-127.0 + val * 54.0 / 50.0);
 
@@ -1350,8 +1982,7 @@ public:
 		if (!xcvr_online || disable_xmlrpc->value() || !selrig->has_smeter)
 			result = "0";
 		else {
-			guard_lock serial_lock(&mutex_serial, "xml 06");
-			int val = selrig->get_smeter();
+			int val = smeter_value("xml 06");
 
 			char szMeter[20];
 			if (val > 50) {
@@ -1411,8 +2042,15 @@ public:
 		if (!xcvr_online || disable_xmlrpc->value() || !selrig->has_power_out)
 			result = "0";
 		else {
-			guard_lock serial_lock(&mutex_serial, "xml 08");
-			int val = selrig->get_power_out();
+			int val;
+			if (progStatus.poll_pout) {
+				RIG_SNAPSHOT snap;
+				read_state(snap);
+				val = snap.pout;
+			} else {
+				guard_lock serial_lock(&mutex_serial, "xml 08");
+				val = selrig->get_power_out();
+			}
 			char szmeter[20];
 			snprintf(szmeter, sizeof(szmeter), "%d", val);
 			std::string result_string = szmeter;
@@ -1435,8 +2073,7 @@ public:
 		if (!xcvr_online || disable_xmlrpc->value() || !selrig->has_swr_control)
 			result = "0";
 		else {
-			guard_lock serial_lock(&mutex_serial, "xml 09");
-			int val = selrig->get_swr();
+			int val = swr_value("xml 09");
 			char szmeter[20];
 			snprintf(szmeter, sizeof(szmeter), "%d", val);
 			std::string result_string = szmeter;
@@ -1471,8 +2108,7 @@ public:
 			result = "0";
 		else {
 			PAIRS swr_pairs( define_PAIR(swr_tbl) );
-			guard_lock serial_lock(&mutex_serial, "xml 09");
-			int val = selrig->get_swr();
+			int val = swr_value("xml 09");
 			double swr = swr_pairs.value(val);
 			char szmeter[20];
 			snprintf(szmeter, sizeof(szmeter), "%2.1f", swr);
@@ -1634,7 +2270,7 @@ class rig_set_verify_ptt : public XmlRpcServerMethod {
 public:
 	rig_set_verify_ptt(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_ptt", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1658,7 +2294,7 @@ public:
 			std::stringstream s;
 			s << "ptt returned " << get << " in " << cnt * 10 << " msec";
 			xml_trace(1, s.str().c_str());
-			Fl::awake(update_UI_PTT);
+			ui_mark(UI_PTT);
 		}
 	}
 
@@ -1672,7 +2308,7 @@ class rig_set_ptt : public XmlRpcServerMethod {
 public:
 	rig_set_ptt(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_ptt", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1697,7 +2333,7 @@ public:
 			std::stringstream s;
 			s << "ptt returned " << get << " in " << cnt * 10 << " msec";
 			xml_trace(1, s.str().c_str());
-			Fl::awake(update_UI_PTT);
+			ui_mark(UI_PTT);
 		}
 	}
 
@@ -1709,7 +2345,7 @@ class rig_set_ptt_fast : public XmlRpcServerMethod {
 public:
 	rig_set_ptt_fast(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_ptt_fast", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1722,7 +2358,7 @@ public:
 		PTT = int(params[0]);
 		xml_trace(1, (PTT ? "rig_ptt ON" : "rig_ptt OFF"));
 		rigPTT(PTT);
-		Fl::awake(update_UI_PTT);
+		ui_mark(UI_PTT);
 	}
 
 	std::string help() { return std::string("deprecated; use rig.set_ptt"); }
@@ -1741,7 +2377,7 @@ class rig_swap : public XmlRpcServerMethod {
 public:
 	rig_swap(XmlRpcServer* s) : XmlRpcServerMethod("rig.swap", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1764,7 +2400,7 @@ class rig_set_swap : public XmlRpcServerMethod {
 public:
 	rig_set_swap(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_swap", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1786,7 +2422,7 @@ class rig_set_verify_swap : public XmlRpcServerMethod {
 public:
 	rig_set_verify_swap(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_swap", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1813,7 +2449,7 @@ class rig_set_split : public XmlRpcServerMethod {
 public:
 	rig_set_split(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_split", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1842,7 +2478,7 @@ class rig_set_verify_split : public XmlRpcServerMethod {
 public:
 	rig_set_verify_split(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_split", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1886,7 +2522,7 @@ class rig_set_AB : public XmlRpcServerMethod {
 public:
 	rig_set_AB(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_AB", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1923,7 +2559,7 @@ class rig_set_verify_AB : public XmlRpcServerMethod {
 public:
 	rig_set_verify_AB(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_AB", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1963,7 +2599,7 @@ class rig_set_vfoA : public XmlRpcServerMethod {
 public:
 	rig_set_vfoA(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfoA", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -1984,7 +2620,7 @@ public:
 			selrig->set_vfoA(vfoA.freq);
 		}
 
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 
 	}
 	std::string help() { return std::string("rig.set_vfo NNNNNNNN (Hz)"); }
@@ -1995,7 +2631,7 @@ class rig_set_verify_vfoA : public XmlRpcServerMethod {
 public:
 	rig_set_verify_vfoA(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_vfoA", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2016,7 +2652,7 @@ public:
 			vfoA.freq = selrig->get_vfoA();
 		}
 
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 	}
 	std::string help() { return std::string("rig.set_verify_vfo NNNNNNNN (Hz)"); }
 
@@ -2026,7 +2662,7 @@ class rig_set_vfoA_fast : public XmlRpcServerMethod {
 public:
 	rig_set_vfoA_fast(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfoA_fast", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2047,7 +2683,7 @@ public:
 			selrig->set_vfoA(vfoA.freq);
 		}
 
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 	}
 	std::string help() { return std::string("deprecated; use rig.set_vfoA"); }
 
@@ -2057,7 +2693,7 @@ class rig_mod_vfoA : public XmlRpcServerMethod {
 public:
 	rig_mod_vfoA(XmlRpcServer* s) : XmlRpcServerMethod("rig.mod_vfoA", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2078,7 +2714,7 @@ public:
 			selrig->set_vfoA(vfoA.freq);
 		}
 
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 
 	}
 	std::string help() { return std::string("rig.mod_vfo +/- NNN (Hz)"); }
@@ -2093,7 +2729,7 @@ class rig_set_vfoB : public XmlRpcServerMethod {
 public:
 	rig_set_vfoB(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfoB", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2114,7 +2750,7 @@ public:
 			vfoB.freq = freq;
 		}
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 	}
 	std::string help() { return std::string("rig.set_vfo NNNNNNNN (Hz)"); }
 
@@ -2124,7 +2760,7 @@ class rig_set_verify_vfoB : public XmlRpcServerMethod {
 public:
 	rig_set_verify_vfoB(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_vfoB", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2145,7 +2781,7 @@ public:
 			vfoB.freq = selrig->get_vfoB();
 		}
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 	}
 	std::string help() { return std::string("rig.set_verify_vfo NNNNNNNN (Hz)"); }
 
@@ -2155,7 +2791,7 @@ class rig_set_vfoB_fast : public XmlRpcServerMethod {
 public:
 	rig_set_vfoB_fast(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfoB_fast", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2176,7 +2812,7 @@ public:
 			vfoB.freq = freq;
 		}
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 	}
 	std::string help() { return std::string("deprecated; use rig.set_vfoB"); }
 
@@ -2186,7 +2822,7 @@ class rig_mod_vfoB : public XmlRpcServerMethod {
 public:
 	rig_mod_vfoB(XmlRpcServer* s) : XmlRpcServerMethod("rig.mod_vfoB", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2207,7 +2843,7 @@ public:
 			vfoB.freq += freq;
 		}
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 
 	}
 	std::string help() { return std::string("rig.mod_vfoB +/- NNN (Hz)"); }
@@ -2222,7 +2858,7 @@ class rig_vfoA2B : public XmlRpcServerMethod {
 public:
 	rig_vfoA2B (XmlRpcServer* s) : XmlRpcServerMethod("rig.vfoA2B", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2238,7 +2874,7 @@ public:
 		selrig->set_vfoB(vfoB.freq);
 		selrig->set_modeB(vfoB.imode);
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 
 	}
 	std::string help() { return std::string("sets vfoB to vfoA freq/mode"); }
@@ -2253,7 +2889,7 @@ class rig_freqA2B : public XmlRpcServerMethod {
 public:
 	rig_freqA2B (XmlRpcServer* s) : XmlRpcServerMethod("rig.freqA2B", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2267,7 +2903,7 @@ public:
 
 		selrig->set_vfoB(vfoB.freq);
 
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 
 	}
 	std::string help() { return std::string("sets freqB to freqA"); }
@@ -2282,7 +2918,7 @@ class rig_modeA2B : public XmlRpcServerMethod {
 public:
 	rig_modeA2B (XmlRpcServer* s) : XmlRpcServerMethod("rig.modeA2B", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2309,7 +2945,7 @@ class rig_set_vfo : public XmlRpcServerMethod {
 public:
 	rig_set_vfo(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_vfo", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2322,11 +2958,11 @@ public:
 		if (selrig->inuse == onB) {
 			selrig->set_vfoB(freq);
 			vfoB.freq = freq;
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 		}else {
 			selrig->set_vfoA(freq);
 			vfoA.freq = freq;
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 		}
 
 	}
@@ -2338,7 +2974,7 @@ class rig_set_verify_vfo : public XmlRpcServerMethod {
 public:
 	rig_set_verify_vfo(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_vfo", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2351,11 +2987,11 @@ public:
 		if (selrig->inuse == onB) {
 			selrig->set_vfoB(freq);
 			vfoB.freq = selrig->get_vfoB();
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 		}else {
 			selrig->set_vfoA(freq);
 			vfoA.freq = selrig->get_vfoA();
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 		}
 
 	}
@@ -2381,11 +3017,11 @@ public:
 		if (selrig->inuse == onB) {
 			selrig->set_vfoB(freq);
 			vfoB.freq = freq;
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 		}else {
 			selrig->set_vfoA(freq);
 			vfoA.freq = freq;
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 		}
 
 	}
@@ -2397,7 +3033,7 @@ class rig_set_frequency : public XmlRpcServerMethod {
 public:
 	rig_set_frequency(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_frequency", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2410,11 +3046,11 @@ public:
 		if (selrig->inuse == onB) {
 			selrig->set_vfoB(freq);
 			vfoB.freq = freq;
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 		}else {
 			selrig->set_vfoA(freq);
 			vfoA.freq = freq;
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 		}
 
 		result = 1;
@@ -2427,7 +3063,7 @@ class rig_set_verify_frequency : public XmlRpcServerMethod {
 public:
 	rig_set_verify_frequency(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_frequency", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2440,11 +3076,11 @@ public:
 		if (selrig->inuse == onB) {
 			selrig->set_vfoB(freq);
 			vfoB.freq = selrig->get_vfoB();
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 		}else {
 			selrig->set_vfoA(freq);
 			vfoA.freq = selrig->get_vfoA();
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 		}
 
 		result = 1;
@@ -2740,7 +3376,7 @@ class rig_set_bandwidth : public XmlRpcServerMethod {
 public:
 	rig_set_bandwidth(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_bandwidth", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2795,7 +3431,7 @@ class rig_set_verify_bandwidth : public XmlRpcServerMethod {
 public:
 	rig_set_verify_bandwidth(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_bandwidth", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2846,7 +3482,7 @@ class rig_set_bw : public XmlRpcServerMethod {
 public:
 	rig_set_bw(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_bw", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2894,7 +3530,7 @@ class rig_set_verify_bw : public XmlRpcServerMethod {
 public:
 	rig_set_verify_bw(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_bw", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2946,7 +3582,7 @@ class rig_set_BW : public XmlRpcServerMethod {
 public:
 	rig_set_BW(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_BW", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -2995,7 +3631,7 @@ class rig_set_verify_BW : public XmlRpcServerMethod {
 public:
 	rig_set_verify_BW(XmlRpcServer* s) : XmlRpcServerMethod("rig.set_verify_BW", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -3047,7 +3683,7 @@ class rig_mod_bw: public XmlRpcServerMethod {
 public:
 	rig_mod_bw(XmlRpcServer* s) : XmlRpcServerMethod("rig.mod_bw", s) {}
 
-		void execute(XmlRpcValue& params, XmlRpcValue& result) { 
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
 		Fl::awake(connection_ON);
 
 		if (!xcvr_online || disable_xmlrpc->value()) {
@@ -4295,6 +4931,282 @@ public:
 } rig_cmd(&rig_server);
 
 
+//------------------------------------------------------------------------------
+// multiple radios
+//   radio.* methods take the radio number as their first argument; radio 0
+//   is the transceiver on the panel and is served by the rig.* method of
+//   the same name, other radios from their own driver and poll state
+//------------------------------------------------------------------------------
+// the arguments which follow the radio number
+static XmlRpcValue radio_args(XmlRpcValue &params)
+{
+	XmlRpcValue args;
+	args.setSize(0);
+	if (params.getType() != XmlRpcValue::TypeArray) return args;
+	for (int n = 1; n < params.size(); n++)
+		args[n - 1] = params[n];
+	return args;
+}
+
+static int radio_number(XmlRpcValue &params)
+{
+	if (params.getType() != XmlRpcValue::TypeArray || params.size() < 1)
+		return -1;
+	int id = (int)xml_number(params[0]);
+	if (id != 0 && !radio_get(id)) return -1;
+	return id;
+}
+
+class radio_list : public XmlRpcServerMethod {
+public:
+	radio_list(XmlRpcServer* s) : XmlRpcServerMethod("radio.list", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		Fl::awake(connection_ON);
+
+		result.setSize(radio_count());
+		result[0]["radio"] = 0;
+		result[0]["xcvr"] = selrig->name_;
+		result[0]["port"] = progStatus.xcvr_serial_port;
+		result[0]["online"] = (bool)xcvr_online;
+		for (int n = 1; n < radio_count(); n++) {
+			RADIO *r = radio_get(n);
+			result[n]["radio"] = n;
+			result[n]["xcvr"] = r ? r->model : std::string("");
+			result[n]["port"] = r ? r->port : std::string("");
+			result[n]["online"] = r ? r->state().online : false;
+		}
+	}
+
+	std::string help() { return std::string("returns the radios: [{radio, xcvr, port, online}]"); }
+
+} radio_list(&rig_server);
+
+class radio_get_vfo : public XmlRpcServerMethod {
+public:
+	radio_get_vfo(XmlRpcServer* s) : XmlRpcServerMethod("radio.get_vfo", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_get_vfo.execute(args, result);
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		RADIO *r = radio_get(id);
+		char szfreq[20];
+		snprintf(szfreq, sizeof(szfreq), "%llu",
+			r ? r->state().freq : 0ULL);
+		result = std::string(szfreq);
+	}
+
+	std::string help() { return std::string("radio.get_vfo N, returns active vfo of radio N in Hertz"); }
+
+} radio_get_vfo(&rig_server);
+
+class radio_set_vfo : public XmlRpcServerMethod {
+public:
+	radio_set_vfo(XmlRpcServer* s) : XmlRpcServerMethod("radio.set_vfo", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_set_vfo.execute(args, result);
+			if (!result.valid()) result = 1;	// rig.set_vfo returns nothing when set
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		if (id < 0 || params.size() < 2 || disable_xmlrpc->value()) {
+			result = 0;
+			return;
+		}
+		unsigned long long freq = (unsigned long long)xml_number(params[1]);
+
+		radio_lock lk(id, "xml radio vfo");
+		RADIO *r = lk.radio();
+		if (!lk.ok() || !r->state().online) {
+			result = 0;
+			return;
+		}
+		if (r->rig->inuse == onB)
+			r->rig->set_vfoB(freq);
+		else
+			r->rig->set_vfoA(freq);
+		RADIO_STATE st = r->state();
+		st.freq = freq;
+		r->update(st);
+		result = 1;
+	}
+
+	std::string help() { return std::string("radio.set_vfo N NNNNNNNN (Hz), returns 1 if set"); }
+
+} radio_set_vfo(&rig_server);
+
+class radio_get_mode : public XmlRpcServerMethod {
+public:
+	radio_get_mode(XmlRpcServer* s) : XmlRpcServerMethod("radio.get_mode", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_get_mode.execute(args, result);
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		std::string mode = "none";
+		if (id > 0) {
+			radio_lock lk(id, "xml radio get mode");
+			RADIO *r = lk.radio();
+			int imode = lk.ok() ? r->state().imode : -1;
+			if (imode >= 0 && imode < (int)r->rig->modes_.size())
+				mode = r->rig->modes_[imode];
+		}
+		result = mode;
+	}
+
+	std::string help() { return std::string("radio.get_mode N, returns mode of radio N"); }
+
+} radio_get_mode(&rig_server);
+
+class radio_set_mode : public XmlRpcServerMethod {
+public:
+	radio_set_mode(XmlRpcServer* s) : XmlRpcServerMethod("radio.set_mode", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_set_mode.execute(args, result);
+			if (!result.valid()) result = 0;	// nothing when the mode is not known
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		if (id < 0 || params.size() < 2 || disable_xmlrpc->value()) {
+			result = 0;
+			return;
+		}
+		std::string numode = (std::string)params[1];
+
+		radio_lock lk(id, "xml radio mode");
+		RADIO *r = lk.radio();
+		if (!lk.ok() || !r->state().online) {
+			result = 0;
+			return;
+		}
+		for (size_t imode = 0; imode < r->rig->modes_.size(); imode++) {
+			if (numode != r->rig->modes_[imode]) continue;
+			if (r->rig->inuse == onB)
+				r->rig->set_modeB(imode);
+			else
+				r->rig->set_modeA(imode);
+			RADIO_STATE st = r->state();
+			st.imode = imode;
+			r->update(st);
+			result = 1;
+			return;
+		}
+		result = 0;
+	}
+
+	std::string help() { return std::string("radio.set_mode N MODE, set mode of radio N, returns 1 if set"); }
+
+} radio_set_mode(&rig_server);
+
+class radio_get_smeter : public XmlRpcServerMethod {
+public:
+	radio_get_smeter(XmlRpcServer* s) : XmlRpcServerMethod("radio.get_smeter", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_get_smeter.execute(args, result);
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		RADIO *r = radio_get(id);
+		char szmeter[20];
+		snprintf(szmeter, sizeof(szmeter), "%d",
+			r ? r->state().smeter : 0);
+		result = std::string(szmeter);
+	}
+
+	std::string help() { return std::string("radio.get_smeter N, returns S-meter of radio N"); }
+
+} radio_get_smeter(&rig_server);
+
+class radio_get_ptt : public XmlRpcServerMethod {
+public:
+	radio_get_ptt(XmlRpcServer* s) : XmlRpcServerMethod("radio.get_ptt", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_get_ptt.execute(args, result);
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		RADIO *r = radio_get(id);
+		result = r ? int(r->state().ptt) : 0;
+	}
+
+	std::string help() { return std::string("radio.get_ptt N, returns PTT state of radio N"); }
+
+} radio_get_ptt(&rig_server);
+
+// keying is refused while another radio transmits
+class radio_set_ptt : public XmlRpcServerMethod {
+public:
+	radio_set_ptt(XmlRpcServer* s) : XmlRpcServerMethod("radio.set_ptt", s) {}
+
+		void execute(XmlRpcValue& params, XmlRpcValue& result) {
+		int id = radio_number(params);
+		if (id == 0) {
+			XmlRpcValue args = radio_args(params);
+			rig_set_ptt.execute(args, result);
+			return;
+		}
+		Fl::awake(connection_ON);
+
+		if (id < 0 || params.size() < 2 || disable_xmlrpc->value()) {
+			result = 0;
+			return;
+		}
+		bool on = (int)xml_number(params[1]) != 0;
+
+		radio_lock lk(id, "xml radio ptt");
+		RADIO *r = lk.radio();
+		if (!lk.ok()) {
+			result = 0;
+			return;
+		}
+		guard_lock interlock(&mutex_ptt_interlock, "xml radio ptt");
+		if (!r->state().online || (on && radio_ptt_locked(id))) {
+			result = 0;
+			return;
+		}
+		r->rig->set_PTT_control(on);
+		radio_ptt_keyed(id, on);
+		RADIO_STATE st = r->state();
+		st.ptt = on;
+		r->update(st);
+		result = 1;
+	}
+
+	std::string help() { return std::string("radio.set_ptt N 0/1, refused while another radio transmits"); }
+
+} radio_set_ptt(&rig_server);
+
 struct MLIST {
 	std::string name; std::string signature; std::string help;
 } mlist[] = {
@@ -4327,7 +5239,10 @@ struct MLIST {
 	{ "rig.get_DBM",              "s:n", "return Smeter in dBm" },
 	{ "rig.get_Sunits",           "s:n", "return Smeter in S units" },
 	{ "rig.get_split",            "i:n", "return split state" },
+	{ "rig.get_meter_history",    "A:ssd", "return meter readings [time, min, avg, max] since time" },
+	{ "rig.get_stats",            "S:n", "return command, poll and mutex latency statistics" },
 	{ "rig.get_update",           "s:n", "return update to info" },
+	{ "rig.wait_update",          "S:ii", "wait for state change, return version and changes" },
 	{ "rig.get_vfo",              "s:n", "return current VFO in Hz" },
 	{ "rig.get_vfoA",             "s:n", "return vfo A in Hz" },
 	{ "rig.get_vfoB",             "s:n", "return vfo B in Hz" },
@@ -4336,6 +5251,23 @@ struct MLIST {
 	{ "rig.get_rfgain",           "i:n", "returns rf gain control value" },
 	{ "rig.get_micgain",          "i:n", "returns mic gain control value" },
 
+	{ "rig.mem_list",             "A:s", "return memories in band, kHz range or with tag text" },
+	{ "rig.mem_add",              "i:S", "add memory {freq, mode, bw, tag}" },
+	{ "rig.mem_add_list",         "i:A", "add array of memories, return number added" },
+	{ "rig.mem_delete",           "i:ds", "delete memory at freq and mode" },
+	{ "rig.mem_clear",            "n:n", "delete all memories" },
+	{ "rig.sweep_start",          "s:dddi", "sweep start to stop by step Hz, read S-meter at each" },
+	{ "rig.sweep_read",           "S:ii", "return sweep points from index, wait msec for new ones" },
+	{ "rig.sweep_stop",           "n:n", "end sweep, restore vfo" },
+	{ "radio.list",               "A:n", "return radios [{radio, xcvr, port, online}]" },
+	{ "radio.get_vfo",            "s:i", "return active vfo of radio N in Hz" },
+	{ "radio.set_vfo",            "i:id", "set active vfo of radio N, Hz; 1 if set" },
+	{ "radio.get_mode",           "s:i", "return mode of radio N" },
+	{ "radio.set_mode",           "i:is", "set mode of radio N; 1 if set" },
+	{ "radio.get_smeter",         "s:i", "return S-meter of radio N" },
+	{ "radio.get_ptt",            "i:i", "return PTT of radio N" },
+	{ "radio.set_ptt",            "i:ii", "key radio N unless another radio transmits" },
+
 	{ "rig.get_agc_label",        "s:n", "return agc string descriptor" },
 	{ "rig.get_agc_labels",       "s:n", "return agc string label list" },
 	{ "rig.get_an_label",         "s:n", "return an string descriptor" },
@@ -4448,6 +5380,8 @@ public:
 
 pthread_t *xml_thread = 0;
 
+#define XML_WORKERS 8
+
 static bool run_server = false;
 
 void * xml_thread_loop(void *d)
@@ -4470,6 +5404,10 @@ void start_server(int port)
 // Enable introspection
 	rig_server.enableIntrospection(true);
 
+// Execute requests on a worker pool; a slow set_verify_... no longer
+// stalls the other clients
+	rig_server.setWorkers(XML_WORKERS);
+
 	xml_thread = new pthread_t;
 	if (pthread_create(xml_thread, NULL, xml_thread_loop, NULL)) {
 		perror("pthread_create");
@@ -4477,10 +5415,13 @@ void start_server(int port)
 	}
 }
 
+// the methods in progress are completed before the radios they use are
+// deleted, see close_UI
 void exit_server()
 {
 	rig_server.exit();
 	run_server = false;
+	rig_server.stopWorkers();
 }
 
 void set_server_port(int port)
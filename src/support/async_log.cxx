@@ -0,0 +1,306 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include "threads.h"
+#include "util.h"
+#include "async_log.h"
+
+//----------------------------------------------------------------------
+// The ring is a bounded multi-producer, single-consumer queue of fixed
+// size cells, each carrying a sequence number.  A cell at position p is
+// free for the producer when seq == p, holds a published line when
+// seq == p + 1, and is handed back by the consumer as seq = p + LOG_CELLS.
+// A line longer than one cell occupies up to LOG_MAX_PARTS consecutive
+// cells, all claimed by a single compare-and-swap on enqueue_pos.
+//----------------------------------------------------------------------
+
+#define LOG_CELLS      4096		// power of 2
+#define LOG_MASK       (LOG_CELLS - 1)
+#define LOG_CELL_TEXT  244
+#define LOG_MAX_PARTS  32
+#define LOG_BATCH      512		// lines per write
+#define LOG_FLUSH_MSEC 1000
+
+struct LOG_CELL {
+	volatile unsigned long seq;
+	unsigned short len;
+	unsigned char  dest;
+	unsigned char  parts;		// cells in this line, 0 on continuation cells
+	char text[LOG_CELL_TEXT];
+};
+
+static LOG_CELL ring[LOG_CELLS];
+
+static volatile unsigned long enqueue_pos = 0;
+static unsigned long dequeue_pos = 0;			// logger thread only
+static volatile unsigned long written_pos = 0;
+static volatile unsigned long dropped = 0;
+
+struct LOG_TARGET {
+	FILE *fp;
+	bool  owned;
+	void (*display)(const std::string &);
+};
+
+static LOG_TARGET targets[ASYNC_DESTS];
+static pthread_mutex_t mutex_targets = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t log_once = PTHREAD_ONCE_INIT;
+static pthread_t log_thread;
+static bool log_running = false;
+
+// An idle logger thread sleeps on log_wake, producers signal it only
+// when it has announced that in logger_idle, so the common case of a
+// busy logger costs them no lock.  log_written wakes async_log_flush.
+static pthread_mutex_t mutex_wake = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t log_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t log_written = PTHREAD_COND_INITIALIZER;
+static volatile int logger_idle = 0;
+
+// number of cells of the line at dequeue_pos, 0 until all are published
+static unsigned long line_ready()
+{
+	LOG_CELL &head = ring[dequeue_pos & LOG_MASK];
+	if (head.seq != dequeue_pos + 1)
+		return 0;
+	full_memory_barrier();
+	unsigned long parts = head.parts ? head.parts : 1;
+	for (unsigned long i = 1; i < parts; i++)
+		if (ring[(dequeue_pos + i) & LOG_MASK].seq != dequeue_pos + i + 1)
+			return 0;
+	full_memory_barrier();
+	return parts;
+}
+
+static void wake_logger()
+{
+	full_memory_barrier();
+	if (!logger_idle)
+		return;
+	guard_lock lk(&mutex_wake);
+	pthread_cond_signal(&log_wake);
+}
+
+static void write_batch(std::string *batch)
+{
+	static unsigned long reported = 0;
+	unsigned long lost = dropped;
+	if (lost != reported) {
+		char msg[80];
+		snprintf(msg, sizeof(msg), "*** %lu log lines dropped, ring full ***\n", lost - reported);
+		batch[ASYNC_TRACE].append(msg);
+		reported = lost;
+	}
+
+	guard_lock lk(&mutex_targets);
+	for (int d = 0; d < ASYNC_DESTS; d++) {
+		if (batch[d].empty()) continue;
+		if (targets[d].fp) {
+			fwrite(batch[d].data(), 1, batch[d].length(), targets[d].fp);
+			fflush(targets[d].fp);
+		}
+		if (targets[d].display)
+			targets[d].display(batch[d]);
+		batch[d].clear();
+	}
+}
+
+static void *logger_loop(void *)
+{
+	std::string batch[ASYNC_DESTS];
+	unsigned long seen = 0;	// dropped count at the last write
+
+	for (;;) {
+		int lines = 0;
+		while (lines < LOG_BATCH) {
+			unsigned long parts = line_ready();
+			if (!parts)
+				break;
+			int dest = ring[dequeue_pos & LOG_MASK].dest;
+			for (unsigned long i = 0; i < parts; i++) {
+				LOG_CELL &c = ring[(dequeue_pos + i) & LOG_MASK];
+				batch[dest].append(c.text, c.len);
+				full_memory_barrier();
+				c.seq = dequeue_pos + i + LOG_CELLS;
+			}
+			dequeue_pos += parts;
+			lines++;
+		}
+		if (lines || dropped != seen) {
+			seen = dropped;
+			write_batch(batch);
+			guard_lock lk(&mutex_wake);
+			written_pos = dequeue_pos;
+			pthread_cond_broadcast(&log_written);
+		}
+		if (lines == LOG_BATCH)
+			continue;
+
+// announce the wait before the last look at the ring, a producer
+// publishing after that look sees logger_idle and signals
+		guard_lock lk(&mutex_wake);
+		logger_idle = 1;
+		full_memory_barrier();
+		if (!line_ready() && dropped == seen)
+			pthread_cond_wait(&log_wake, &mutex_wake);
+		logger_idle = 0;
+	}
+	return NULL;
+}
+
+static void stop_logger()
+{
+	async_log_flush();
+	guard_lock lk(&mutex_targets);
+	for (int d = 0; d < ASYNC_DESTS; d++) {
+		if (targets[d].fp && targets[d].owned)
+			fclose(targets[d].fp);
+		targets[d].fp = NULL;
+		targets[d].display = NULL;
+	}
+}
+
+static void start_logger()
+{
+	for (unsigned long i = 0; i < LOG_CELLS; i++)
+		ring[i].seq = i;
+	for (int d = 0; d < ASYNC_DESTS; d++) {
+		targets[d].fp = NULL;
+		targets[d].owned = false;
+		targets[d].display = NULL;
+	}
+	full_memory_barrier();
+
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (pthread_create(&log_thread, &attr, logger_loop, NULL) == 0) {
+		log_running = true;
+		atexit(stop_logger);
+	}
+	pthread_attr_destroy(&attr);
+}
+
+void async_log(int dest, const char *text, size_t len)
+{
+	if (dest < 0 || dest >= ASYNC_DESTS || !text || !len)
+		return;
+	pthread_once(&log_once, start_logger);
+
+	if (len > LOG_CELL_TEXT * LOG_MAX_PARTS)
+		len = LOG_CELL_TEXT * LOG_MAX_PARTS;
+	unsigned long parts = (len + LOG_CELL_TEXT - 1) / LOG_CELL_TEXT;
+
+	unsigned long pos;
+	for (;;) {
+		pos = enqueue_pos;
+		long dif = 0;
+		for (unsigned long i = 0; i < parts; i++) {
+			dif = (long)(ring[(pos + i) & LOG_MASK].seq - (pos + i));
+			if (dif) break;
+		}
+		if (dif < 0) {	// consumer has not freed the cells yet
+			__sync_fetch_and_add(&dropped, 1);
+			wake_logger();
+			return;
+		}
+		if (dif == 0 && __sync_bool_compare_and_swap(&enqueue_pos, pos, pos + parts))
+			break;
+	}
+
+	for (unsigned long i = 0; i < parts; i++) {
+		LOG_CELL &c = ring[(pos + i) & LOG_MASK];
+		size_t n = len - i * LOG_CELL_TEXT;
+		if (n > LOG_CELL_TEXT) n = LOG_CELL_TEXT;
+		memcpy(c.text, text + i * LOG_CELL_TEXT, n);
+		c.len = n;
+		c.dest = dest;
+		c.parts = i ? 0 : parts;
+		full_memory_barrier();
+		c.seq = pos + i + 1;
+	}
+	wake_logger();
+}
+
+void async_log_open(int dest, const char *path)
+{
+	if (dest < 0 || dest >= ASYNC_DESTS)
+		return;
+	pthread_once(&log_once, start_logger);
+	FILE *fp = fopen(path, "a");
+	if (!fp)
+		return;
+	guard_lock lk(&mutex_targets);
+	if (targets[dest].fp && targets[dest].owned)
+		fclose(targets[dest].fp);
+	targets[dest].fp = fp;
+	targets[dest].owned = true;
+}
+
+void async_log_file(int dest, FILE *fp)
+{
+	if (dest < 0 || dest >= ASYNC_DESTS)
+		return;
+	pthread_once(&log_once, start_logger);
+	if (!fp)
+		async_log_flush();
+	guard_lock lk(&mutex_targets);
+	if (targets[dest].fp && targets[dest].owned)
+		fclose(targets[dest].fp);
+	targets[dest].fp = fp;
+	targets[dest].owned = false;
+}
+
+void async_log_display(int dest, void (*display)(const std::string &))
+{
+	if (dest < 0 || dest >= ASYNC_DESTS)
+		return;
+	pthread_once(&log_once, start_logger);
+	guard_lock lk(&mutex_targets);
+	targets[dest].display = display;
+}
+
+void async_log_flush()
+{
+	if (!log_running || pthread_equal(pthread_self(), log_thread))
+		return;
+	unsigned long target = enqueue_pos;
+	wake_logger();
+
+// bounded, a stalled producer must not hang the caller
+	struct timespec deadline;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += LOG_FLUSH_MSEC / 1000;
+	guard_lock lk(&mutex_wake);
+	while ((long)(written_pos - target) < 0)
+		if (pthread_cond_timedwait(&log_written, &mutex_wake, &deadline) == ETIMEDOUT)
+			break;
+}
+
+unsigned long async_log_dropped()
+{
+	return dropped;
+}
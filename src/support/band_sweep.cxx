@@ -0,0 +1,185 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <sys/time.h>
+#include <errno.h>
+
+#include <string>
+#include <vector>
+
+#include "band_sweep.h"
+#include "support.h"
+#include "status.h"
+#include "threads.h"
+#include "util.h"
+#include "ui_refresh.h"
+#include "cat_stats.h"
+#include "tod_clock.h"
+#include "debug.h"
+
+static pthread_mutex_t mutex_sweep = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  cond_point = PTHREAD_COND_INITIALIZER;
+
+static pthread_t sweep_thread;
+static bool started = false;		// sweep_thread to be joined
+static volatile bool running = false;
+static volatile bool abort_sweep = false;
+
+static unsigned long long sweep_from, sweep_step;
+static size_t sweep_count;
+static int sweep_settle;
+
+static std::vector<SWEEP_POINT> results;
+
+// set the vfo in use, caller holds mutex_serial
+static void sweep_set(unsigned long long freq)
+{
+	if (selrig->inuse == onB)
+		selrig->set_vfoB(freq);
+	else
+		selrig->set_vfoA(freq);
+}
+
+static void *sweep_loop(void *)
+{
+	STATS_ENTRY *step_time = stats_entry(STATS_TIMING, "sweep step");
+
+	for (size_t n = 0; n < sweep_count && !abort_sweep; n++) {
+		SWEEP_POINT p;
+		p.freq = sweep_from + n * sweep_step;
+		ullint t0 = zusec();
+		{
+			guard_lock serial_lock(&mutex_serial, "sweep");
+			if (PTT || !xcvr_online) break;
+			sweep_set(p.freq);
+		}
+// the port is free for the poll and the UI while the receiver settles;
+// keying meanwhile ends the sweep
+		if (sweep_settle) MilliSleep(sweep_settle);
+		{
+			guard_lock serial_lock(&mutex_serial, "sweep");
+			if (PTT || !xcvr_online || abort_sweep) break;
+			p.level = selrig->get_smeter();
+		}
+		stats_record(step_time, zusec() - t0);
+		guard_lock lk(&mutex_sweep);
+		results.push_back(p);
+		pthread_cond_broadcast(&cond_point);
+	}
+
+// back to the operating frequency, including any tuning done meanwhile
+	{
+		guard_lock serial_lock(&mutex_serial, "sweep");
+		sweep_set((selrig->inuse == onB) ? vfoB.freq : vfoA.freq);
+	}
+
+	{
+		guard_lock lk(&mutex_sweep);
+		running = false;
+		pthread_cond_broadcast(&cond_point);
+	}
+	ui_mark(UI_FREQ_A | UI_FREQ_B);
+
+	LOG_INFO("sweep ended, %d points", (int)results.size());
+	return NULL;
+}
+
+bool sweep_start(unsigned long long start, unsigned long long stop,
+	unsigned long long step, int settle, std::string &err)
+{
+	if (!selrig || !xcvr_online) { err = "transceiver not connected"; return false; }
+	if (!selrig->has_smeter) { err = "no S-meter reading"; return false; }
+	if (PTT) { err = "transmitting"; return false; }
+	if (!step || stop < start) { err = "invalid range"; return false; }
+
+	size_t count = (stop - start) / step + 1;
+	if (count > SWEEP_MAX_POINTS) { err = "too many points"; return false; }
+	if (settle < 0) settle = 0;
+	if (settle > SWEEP_MAX_SETTLE) settle = SWEEP_MAX_SETTLE;
+
+	guard_lock lk(&mutex_sweep);
+	if (running) { err = "sweep in progress"; return false; }
+	if (started) {
+		pthread_join(sweep_thread, NULL);
+		started = false;
+	}
+
+	sweep_from = start;
+	sweep_step = step;
+	sweep_count = count;
+	sweep_settle = settle;
+	results.clear();
+	results.reserve(count);
+	abort_sweep = false;
+	running = true;
+
+	if (pthread_create(&sweep_thread, NULL, sweep_loop, NULL)) {
+		running = false;
+		err = "cannot start sweep thread";
+		LOG_ERROR("%s", err.c_str());
+		return false;
+	}
+	started = true;
+	return true;
+}
+
+void sweep_stop()
+{
+	pthread_t thread;
+	{
+		guard_lock lk(&mutex_sweep);
+		if (!started) return;
+		abort_sweep = true;
+		thread = sweep_thread;
+		started = false;
+	}
+	pthread_join(thread, NULL);
+}
+
+bool sweep_running()
+{
+	return running;
+}
+
+size_t sweep_read(size_t from, std::vector<SWEEP_POINT> &points,
+	bool &is_running, int msec)
+{
+	guard_lock lk(&mutex_sweep);
+
+	if (msec > 0 && running && results.size() <= from) {
+		struct timeval now;
+		gettimeofday(&now, NULL);
+		struct timespec until;
+		long usec = now.tv_usec + (msec % 1000) * 1000L;
+		until.tv_sec = now.tv_sec + msec / 1000 + usec / 1000000L;
+		until.tv_nsec = (usec % 1000000L) * 1000L;
+		while (running && results.size() <= from) {
+			if (pthread_cond_timedwait(&cond_point, &mutex_sweep, &until) == ETIMEDOUT)
+				break;
+		}
+	}
+
+	points.clear();
+	if (from < results.size())
+		points.assign(results.begin() + from, results.end());
+	is_running = running;
+	return running ? sweep_count : results.size();
+}
@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <string>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifndef __WIN32__
+#  include <sys/mman.h>
+#endif
+
+#include "status.h"
+#include "debug.h"
+#include "threads.h"
+#include "cat_capture.h"
+
+extern std::string RigHomeDir;
+
+volatile bool cat_capturing = false;
+
+static pthread_mutex_t mutex_capture = PTHREAD_MUTEX_INITIALIZER;
+
+static CAP_FILE_HEADER *cap_header = 0;
+static char *cap_data = 0;
+static size_t cap_map_size = 0;
+static int cap_fd = -1;
+
+static uint64_t usec_now()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+#ifndef __WIN32__
+
+bool cat_capture_start()
+{
+	guard_lock lk(&mutex_capture);
+	if (cap_header) return true;
+
+	uint64_t data_size = (uint64_t)progStatus.cat_capture_size * 1024 * 1024;
+	if (data_size < 65536) data_size = 65536;
+
+	std::string fname = RigHomeDir;
+	fname.append("cat_capture.bin");
+	std::string oldname = fname;
+	oldname.append(".1");
+	rename(fname.c_str(), oldname.c_str());
+
+	cap_map_size = sizeof(CAP_FILE_HEADER) + data_size;
+	cap_fd = open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (cap_fd < 0) {
+		LOG_ERROR("%s: %s", fname.c_str(), strerror(errno));
+		return false;
+	}
+	if (ftruncate(cap_fd, cap_map_size) < 0) {
+		LOG_ERROR("%s: %s", fname.c_str(), strerror(errno));
+		close(cap_fd);
+		cap_fd = -1;
+		return false;
+	}
+	void *p = mmap(NULL, cap_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, cap_fd, 0);
+	if (p == MAP_FAILED) {
+		LOG_ERROR("mmap %s: %s", fname.c_str(), strerror(errno));
+		close(cap_fd);
+		cap_fd = -1;
+		return false;
+	}
+
+	cap_header = (CAP_FILE_HEADER *)p;
+	cap_data = (char *)p + sizeof(CAP_FILE_HEADER);
+	memset(cap_header, 0, sizeof(CAP_FILE_HEADER));
+	memcpy(cap_header->magic, CAP_MAGIC, sizeof(cap_header->magic));
+	cap_header->version = CAP_VERSION;
+	cap_header->header_size = sizeof(CAP_FILE_HEADER);
+	cap_header->data_size = data_size;
+	cap_header->start_usec = usec_now();
+
+	cat_capturing = true;
+	LOG_INFO("capturing CAT traffic to %s", fname.c_str());
+	return true;
+}
+
+void cat_capture_stop()
+{
+	guard_lock lk(&mutex_capture);
+	cat_capturing = false;
+	if (!cap_header) return;
+	munmap(cap_header, cap_map_size);
+	close(cap_fd);
+	cap_fd = -1;
+	cap_header = 0;
+	cap_data = 0;
+}
+
+#else
+
+// no memory mapped capture on Windows
+bool cat_capture_start()
+{
+	LOG_WARN("%s", "CAT capture is not available on this platform");
+	return false;
+}
+
+void cat_capture_stop()
+{
+	cat_capturing = false;
+}
+
+#endif
+
+// move the tail past the oldest records until 'needed' bytes are free
+static void reclaim(uint64_t needed)
+{
+	CAP_FILE_HEADER &h = *cap_header;
+	while (h.head + needed - h.tail > h.data_size) {
+		uint64_t off = cap_offset(h.tail, h.data_size);
+		if (h.tail >= h.head) {
+			h.tail = h.head;
+			break;
+		}
+		h.tail += ((CAP_RECORD *)(cap_data + off))->size;
+	}
+}
+
+void cat_capture_write(int port, int dir, const char *data, size_t n)
+{
+	guard_lock lk(&mutex_capture);
+	if (!cap_header) return;
+
+	CAP_FILE_HEADER &h = *cap_header;
+// a single record may use at most a quarter of the ring
+	if (n > h.data_size / 4) n = h.data_size / 4;
+	uint64_t size = CAP_ALIGN(sizeof(CAP_RECORD) + n);
+
+	uint64_t pos = h.head;
+	uint64_t off = cap_offset(pos, h.data_size);
+	uint64_t pad = (h.data_size - off < size) ? h.data_size - off : 0;
+
+	reclaim(pos - h.head + pad + size);
+
+	if (pad) {
+		CAP_RECORD *r = (CAP_RECORD *)(cap_data + off);
+		memset(r, 0, sizeof(CAP_RECORD));
+		r->size = pad;
+		r->dir = CAP_PAD;
+		pos += pad;
+		off = 0;
+	}
+
+	CAP_RECORD *r = (CAP_RECORD *)(cap_data + off);
+	r->usec = usec_now();
+	r->size = size;
+	r->nbytes = n;
+	r->dir = dir;
+	r->port = port;
+	memset(r->reserved, 0, sizeof(r->reserved));
+	memcpy(cap_data + off + sizeof(CAP_RECORD), data, n);
+
+	h.head = pos + size;
+}
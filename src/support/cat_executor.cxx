@@ -0,0 +1,160 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <deque>
+#include <pthread.h>
+
+#include "cat_executor.h"
+#include "cat_stats.h"
+#include "state_snapshot.h"
+#include "tod_clock.h"
+#include "debug.h"
+
+struct CAT_CMD {
+	CAT_FUNC func;
+	long long val;
+	bool coalesce;
+	ullint posted;		// usec
+};
+
+static std::deque<CAT_CMD> queue;
+// the command the executor is running, NULL if none
+static CAT_FUNC running_func = NULL;
+
+static pthread_mutex_t mutex_cat = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  cond_posted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  cond_done = PTHREAD_COND_INITIALIZER;
+
+static pthread_once_t executor_once = PTHREAD_ONCE_INIT;
+static pthread_t executor_thread;
+static bool running = false;
+static bool stopping = false;
+
+static unsigned long queued = 0;		// commands queued, less those replaced
+static unsigned long completed = 0;
+static unsigned long replaced = 0;
+
+static void *executor_loop(void *)
+{
+	STATS_ENTRY *wait = stats_entry(STATS_TIMING, "cat queue");
+
+	pthread_mutex_lock(&mutex_cat);
+	for (;;) {
+		while (queue.empty() && !stopping)
+			pthread_cond_wait(&cond_posted, &mutex_cat);
+		if (queue.empty())
+			break;
+		CAT_CMD cmd = queue.front();
+		queue.pop_front();
+		running_func = cmd.func;
+		pthread_mutex_unlock(&mutex_cat);
+
+		if (wait) stats_record(wait, zusec() - cmd.posted);
+		cmd.func(cmd.val);
+		publish_state();
+
+		pthread_mutex_lock(&mutex_cat);
+		running_func = NULL;
+		completed++;
+		pthread_cond_broadcast(&cond_done);
+	}
+	running = false;
+	pthread_cond_broadcast(&cond_done);
+	pthread_mutex_unlock(&mutex_cat);
+	return NULL;
+}
+
+static void start_executor()
+{
+	if (pthread_create(&executor_thread, NULL, executor_loop, NULL) == 0)
+		running = true;
+	else
+		LOG_ERROR("CAT executor thread not started, commands run on the caller's thread");
+}
+
+void cat_post(CAT_FUNC func, long long val, int how)
+{
+	pthread_once(&executor_once, start_executor);
+
+	pthread_mutex_lock(&mutex_cat);
+	if (!running || stopping || pthread_equal(pthread_self(), executor_thread)) {
+		pthread_mutex_unlock(&mutex_cat);
+		func(val);
+		return;
+	}
+	// only the newest command can be replaced, one further back would run
+	// its new value ahead of the commands posted after it
+	if (how == CAT_COALESCE && !queue.empty() &&
+		queue.back().func == func && queue.back().coalesce) {
+		queue.back().val = val;
+		replaced++;
+		pthread_mutex_unlock(&mutex_cat);
+		return;
+	}
+	CAT_CMD cmd;
+	cmd.func = func;
+	cmd.val = val;
+	cmd.coalesce = (how == CAT_COALESCE);
+	cmd.posted = zusec();
+	queue.push_back(cmd);
+	queued++;
+	pthread_cond_signal(&cond_posted);
+	pthread_mutex_unlock(&mutex_cat);
+}
+
+bool cat_pending(CAT_FUNC func)
+{
+	pthread_mutex_lock(&mutex_cat);
+	bool found = (running_func == func);
+	for (size_t n = 0; n < queue.size() && !found; n++)
+		found = (queue[n].func == func);
+	pthread_mutex_unlock(&mutex_cat);
+	return found;
+}
+
+void cat_flush()
+{
+	pthread_mutex_lock(&mutex_cat);
+	if (!pthread_equal(pthread_self(), executor_thread)) {
+		unsigned long target = queued;
+		while (running && completed < target)
+			pthread_cond_wait(&cond_done, &mutex_cat);
+	}
+	pthread_mutex_unlock(&mutex_cat);
+}
+
+void cat_executor_stop()
+{
+	pthread_mutex_lock(&mutex_cat);
+	bool joinable = running && !stopping;
+	stopping = true;
+	pthread_cond_signal(&cond_posted);
+	pthread_mutex_unlock(&mutex_cat);
+	if (joinable)
+		pthread_join(executor_thread, NULL);
+}
+
+unsigned long cat_coalesced()
+{
+	pthread_mutex_lock(&mutex_cat);
+	unsigned long n = replaced;
+	pthread_mutex_unlock(&mutex_cat);
+	return n;
+}
@@ -0,0 +1,329 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <sched.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Double_Window.H>
+#include <FL/Fl_Browser.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Light_Button.H>
+
+#include "gettext.h"
+#include "cat_stats.h"
+
+struct STATS_ENTRY {
+	volatile int state;		// 0 free, 1 being named, 2 in use
+	char name[STATS_NAME_LEN];
+	volatile unsigned long count;
+	volatile ullint sum;
+	volatile ullint max;
+	volatile unsigned long tx_bytes;
+	volatile unsigned long rx_bytes;
+	volatile unsigned long timeouts;
+	volatile unsigned long buckets[STATS_BUCKETS];
+};
+
+static STATS_ENTRY tables[STATS_KINDS][STATS_SLOTS];
+static volatile unsigned long stats_lost = 0;
+
+//----------------------------------------------------------------------
+// histogram buckets
+//----------------------------------------------------------------------
+static int bucket(ullint usec)
+{
+	if (usec < 16) return (int)usec;
+	if (usec > 0xFFFFFFFFULL) usec = 0xFFFFFFFFULL;
+	int e = 63 - __builtin_clzll(usec);		// 4 .. 31
+	int sub = (int)(usec >> (e - 3)) & 7;
+	return 16 + (e - 4) * 8 + sub;
+}
+
+// middle of the bucket, usec
+static double bucket_value(int b)
+{
+	if (b < 16) return b;
+	int e = (b - 16) / 8 + 4;
+	int sub = (b - 16) % 8;
+	return ldexp(8 + sub, e - 3) + ldexp(1, e - 3) / 2;
+}
+
+static unsigned int hash(const char *s)
+{
+	unsigned int h = 2166136261U;
+	while (*s) {
+		h ^= (unsigned char)*s++;
+		h *= 16777619U;
+	}
+	return h;
+}
+
+//----------------------------------------------------------------------
+// recording
+//----------------------------------------------------------------------
+STATS_ENTRY *stats_entry(int kind, const char *name)
+{
+	if (kind < 0 || kind >= STATS_KINDS || !name || !*name)
+		return NULL;
+
+	char key[STATS_NAME_LEN];
+	strncpy(key, name, sizeof(key) - 1);
+	key[sizeof(key) - 1] = 0;
+
+	STATS_ENTRY *table = tables[kind];
+	unsigned int h = hash(key);
+	for (int n = 0; n < STATS_SLOTS; n++) {
+		STATS_ENTRY *e = &table[(h + n) % STATS_SLOTS];
+		if (e->state == 0 && __sync_bool_compare_and_swap(&e->state, 0, 1)) {
+			memcpy(e->name, key, sizeof(key));
+			__sync_synchronize();
+			e->state = 2;
+			return e;
+		}
+		while (e->state == 1)
+			sched_yield();
+		__sync_synchronize();
+		if (strcmp(e->name, key) == 0)
+			return e;
+	}
+	__sync_fetch_and_add(&stats_lost, 1);
+	return NULL;
+}
+
+void stats_record(STATS_ENTRY *e, ullint usec)
+{
+	if (!e) return;
+	__sync_fetch_and_add(&e->count, 1);
+	__sync_fetch_and_add(&e->sum, usec);
+	__sync_fetch_and_add(&e->buckets[bucket(usec)], 1);
+	ullint m = e->max;
+	while (usec > m && !__sync_bool_compare_and_swap(&e->max, m, usec))
+		m = e->max;
+}
+
+void stats_command(const char *name, ullint usec, size_t tx, size_t rx, bool timeout)
+{
+	STATS_ENTRY *e = stats_entry(STATS_CMD, name);
+	if (!e) return;
+	stats_record(e, usec);
+	__sync_fetch_and_add(&e->tx_bytes, tx);
+	__sync_fetch_and_add(&e->rx_bytes, rx);
+	if (timeout)
+		__sync_fetch_and_add(&e->timeouts, 1);
+}
+
+std::string stats_command_name(const std::string &cmd)
+{
+	char name[STATS_NAME_LEN];
+// CI-V, FE FE to from command [sub command]
+	if (cmd.length() >= 6 && (unsigned char)cmd[0] == 0xFE && (unsigned char)cmd[1] == 0xFE) {
+		if ((unsigned char)cmd[5] == 0xFD)
+			snprintf(name, sizeof(name), "CI-V %02X", (unsigned char)cmd[4]);
+		else
+			snprintf(name, sizeof(name), "CI-V %02X %02X",
+				(unsigned char)cmd[4], (unsigned char)cmd[5]);
+		return name;
+	}
+// ASCII, the leading letters
+	size_t n = 0;
+	while (n < cmd.length() && n < 4 && isalpha((unsigned char)cmd[n]))
+		n++;
+	if (n)
+		return cmd.substr(0, n);
+	return "other";
+}
+
+void stats_reset()
+{
+	for (int k = 0; k < STATS_KINDS; k++) {
+		for (int n = 0; n < STATS_SLOTS; n++) {
+			STATS_ENTRY *e = &tables[k][n];
+			if (e->state != 2) continue;
+// atomic stores, recording threads add to these concurrently
+			__sync_lock_test_and_set(&e->count, 0);
+			__sync_lock_test_and_set(&e->sum, 0);
+			__sync_lock_test_and_set(&e->max, 0);
+			__sync_lock_test_and_set(&e->tx_bytes, 0);
+			__sync_lock_test_and_set(&e->rx_bytes, 0);
+			__sync_lock_test_and_set(&e->timeouts, 0);
+			for (int b = 0; b < STATS_BUCKETS; b++)
+				__sync_lock_test_and_set(&e->buckets[b], 0);
+		}
+	}
+	__sync_lock_test_and_set(&stats_lost, 0);
+}
+
+//----------------------------------------------------------------------
+// reporting
+//----------------------------------------------------------------------
+static bool busiest(const STATS_SUMMARY &a, const STATS_SUMMARY &b)
+{
+	return a.total > b.total;
+}
+
+void stats_summary(int kind, std::vector<STATS_SUMMARY> &list)
+{
+	list.clear();
+	if (kind < 0 || kind >= STATS_KINDS) return;
+
+	unsigned long counts[STATS_BUCKETS];
+	for (int n = 0; n < STATS_SLOTS; n++) {
+		STATS_ENTRY *e = &tables[kind][n];
+		if (e->state != 2 || e->count == 0) continue;
+
+		STATS_SUMMARY s;
+		s.name = e->name;
+		s.count = e->count;
+		s.total = e->sum / 1000.0;
+		s.mean = s.total / s.count;
+		s.max = e->max / 1000.0;
+		s.tx_bytes = e->tx_bytes;
+		s.rx_bytes = e->rx_bytes;
+		s.timeouts = e->timeouts;
+
+// percentiles from a copy, the counts may change while we read
+		unsigned long total = 0;
+		for (int b = 0; b < STATS_BUCKETS; b++)
+			total += (counts[b] = e->buckets[b]);
+		double pct[3] = { 0.50, 0.90, 0.99 };
+		double *val[3] = { &s.p50, &s.p90, &s.p99 };
+		for (int p = 0; p < 3; p++) {
+			unsigned long rank = (unsigned long)ceil(pct[p] * total);
+			unsigned long seen = 0;
+			*val[p] = 0;
+			for (int b = 0; b < STATS_BUCKETS; b++) {
+				seen += counts[b];
+				if (seen >= rank && counts[b]) {
+					*val[p] = std::min(bucket_value(b) / 1000.0, s.max);
+					break;
+				}
+			}
+		}
+		list.push_back(s);
+	}
+	std::sort(list.begin(), list.end(), busiest);
+}
+
+static const char *kind_title[STATS_KINDS] = {
+	"CAT commands", "Poll functions", "Mutex wait", "Mutex hold", "Keying lateness"
+};
+
+std::string stats_report()
+{
+	std::string report;
+	char line[200];
+	std::vector<STATS_SUMMARY> list;
+
+	for (int k = 0; k < STATS_KINDS; k++) {
+		stats_summary(k, list);
+		if (list.empty()) continue;
+		snprintf(line, sizeof(line),
+			"%-24s %8s %10s %8s %8s %8s %8s %8s%s\n",
+			kind_title[k], "count", "total ms", "mean", "p50", "p90", "p99", "max",
+			k == STATS_CMD ? "     tx B     rx B  t/o" : "");
+		report.append(line);
+		for (size_t n = 0; n < list.size(); n++) {
+			STATS_SUMMARY &s = list[n];
+			snprintf(line, sizeof(line),
+				"%-24.24s %8lu %10.1f %8.2f %8.2f %8.2f %8.2f %8.2f",
+				s.name.c_str(), s.count, s.total, s.mean, s.p50, s.p90, s.p99, s.max);
+			report.append(line);
+			if (k == STATS_CMD) {
+				snprintf(line, sizeof(line), " %8lu %8lu %4lu",
+					s.tx_bytes, s.rx_bytes, s.timeouts);
+				report.append(line);
+			}
+			report.append("\n");
+		}
+		report.append("\n");
+	}
+	if (stats_lost) {
+		snprintf(line, sizeof(line), "%lu records lost, tables full\n", stats_lost);
+		report.append(line);
+	}
+	if (report.empty())
+		report = "no statistics recorded\n";
+	return report;
+}
+
+//----------------------------------------------------------------------
+// statistics panel, refreshed once a second while visible
+//----------------------------------------------------------------------
+static Fl_Double_Window *stats_window = (Fl_Double_Window *)0;
+static Fl_Browser *stats_browser = (Fl_Browser *)0;
+static Fl_Light_Button *btn_stats_pause = (Fl_Light_Button *)0;
+
+static void show_stats()
+{
+	int top = stats_browser->topline();
+	std::string report = stats_report();
+	stats_browser->clear();
+	size_t p0 = 0, p1;
+	while ((p1 = report.find('\n', p0)) != std::string::npos) {
+		stats_browser->add(report.substr(p0, p1 - p0).c_str());
+		p0 = p1 + 1;
+	}
+	stats_browser->topline(top);
+}
+
+static void update_stats_window(void *)
+{
+	if (!stats_window || !stats_window->visible())
+		return;
+	if (!btn_stats_pause->value())
+		show_stats();
+	Fl::repeat_timeout(1.0, update_stats_window);
+}
+
+static void cb_stats_reset(Fl_Button *, void *)
+{
+	stats_reset();
+	show_stats();
+}
+
+static void make_stats_window()
+{
+	stats_window = new Fl_Double_Window(760, 400, _("CAT statistics"));
+	stats_browser = new Fl_Browser(0, 0, 760, 370);
+	stats_browser->textfont(FL_SCREEN);
+	stats_browser->format_char(0);
+	btn_stats_pause = new Fl_Light_Button(590, 375, 80, 20, _("Pause"));
+	Fl_Button *btn_reset = new Fl_Button(675, 375, 80, 20, _("Reset"));
+	btn_reset->callback((Fl_Callback *)cb_stats_reset);
+	stats_window->resizable(stats_browser);
+	stats_window->end();
+}
+
+void open_stats_window()
+{
+	if (!stats_window) make_stats_window();
+	show_stats();
+	stats_window->show();
+	Fl::remove_timeout(update_stats_window);
+	Fl::add_timeout(1.0, update_stats_window);
+}
@@ -52,6 +52,7 @@
 #include "threads.h"
 #include "support.h"
 #include "trace.h"
+#include "async_log.h"
 
 #define MAX_LINES 65536
 
@@ -119,15 +120,25 @@ void debug::stop(void)
 	}
 }
 
-static char fmt[1024];
-static char sztemp[8096];
 static std::string estr = "";
 
+// the event log file is written by the async_log thread
+static void post_event(const char *text)
+{
+	char line[8200];
+	int len = snprintf(line, sizeof(line), "[%s] %s", ztime(), text);
+	if (len < 0) return;
+	if (len > (int)sizeof(line) - 1) len = sizeof(line) - 1;
+	async_log(ASYNC_EVENTS, line, len);
+}
+
 void debug::log(level_e level, const char* func, const char* srcf, int line, const char* format, ...)
 {
 	if (!inst) return;
 	if (level > debug::level) return;
 
+	char fmt[1024];
+	char sztemp[8096];
 	snprintf(fmt, sizeof(fmt), "%c: %s: %s\n", *prefix[level], func, format);
 
 	va_list args;
@@ -140,12 +151,10 @@ void debug::log(level_e level, const char* func, const char* srcf, int line, con
 
 	if (progStatus.debugtrace) trace(1, sztemp);
 
-	fprintf(wfile, "[%s] %s", ztime(), sztemp);
+	post_event(sztemp);
 
 	va_end(args);
 
-	fflush(wfile);
-
 	Fl::awake(sync_text, 0);
 }
 
@@ -154,6 +163,8 @@ void debug::slog(level_e level, const char* func, const char* srcf, int line, co
 	if (!inst) return;
 	if (level > debug::level) return;
 
+	char fmt[1024];
+	char sztemp[8096];
 	snprintf(fmt, sizeof(fmt), "%c:%s\n", *prefix[level], format);
 
 	va_list args;
@@ -166,12 +177,10 @@ void debug::slog(level_e level, const char* func, const char* srcf, int line, co
 
 	if (progStatus.debugtrace) trace(1, sztemp);
 
-	fprintf(wfile, "[%s] %s", ztime(), sztemp);
+	post_event(sztemp);
 
 	va_end(args);
 
-	fflush(wfile);
-
     Fl::awake(sync_text, 0);
 }
 
@@ -224,6 +233,8 @@ debug::debug(const char* filename)
 		throw strerror(errno);
 #endif
 	tty = isatty(fileno(stderr));
+
+	async_log_file(ASYNC_EVENTS, wfile);
 }
 
 debug::~debug()
@@ -232,6 +243,7 @@ debug::~debug()
 		delete window;
 		window = 0;
 	}
+	async_log_file(ASYNC_EVENTS, NULL);
 	fclose(wfile);
 	fclose(rfile);
 }
@@ -0,0 +1,470 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include <FL/Fl.H>
+
+#include "mem_bank.h"
+#include "threads.h"
+
+MEM_BANK mem_bank;
+
+//----------------------------------------------------------------------
+// amateur band edges, Hz
+//----------------------------------------------------------------------
+
+static struct BAND_EDGES {
+	const char *name;
+	unsigned long long lo, hi;
+} band_edges[] = {
+	{ "2200m",    135700ULL,    137800ULL },
+	{ "630m",     472000ULL,    479000ULL },
+	{ "160m",    1800000ULL,   2000000ULL },
+	{ "80m",     3500000ULL,   4000000ULL },
+	{ "60m",     5330000ULL,   5410000ULL },
+	{ "40m",     7000000ULL,   7300000ULL },
+	{ "30m",    10100000ULL,  10150000ULL },
+	{ "20m",    14000000ULL,  14350000ULL },
+	{ "17m",    18068000ULL,  18168000ULL },
+	{ "15m",    21000000ULL,  21450000ULL },
+	{ "12m",    24890000ULL,  24990000ULL },
+	{ "10m",    28000000ULL,  29700000ULL },
+	{ "6m",     50000000ULL,  54000000ULL },
+	{ "4m",     70000000ULL,  70500000ULL },
+	{ "2m",    144000000ULL, 148000000ULL },
+	{ "1.25m", 222000000ULL, 225000000ULL },
+	{ "70cm",  420000000ULL, 450000000ULL },
+	{ "33cm",  902000000ULL, 928000000ULL },
+	{ "23cm", 1240000000ULL,1300000000ULL }
+};
+
+bool MEM_BANK::band(const std::string &name, unsigned long long &lo, unsigned long long &hi)
+{
+	for (size_t n = 0; n < sizeof(band_edges) / sizeof(*band_edges); n++) {
+		if (strcasecmp(name.c_str(), band_edges[n].name) == 0) {
+			lo = band_edges[n].lo;
+			hi = band_edges[n].hi;
+			return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------
+// MEM_FILTER
+//----------------------------------------------------------------------
+
+static std::string lowercase(const std::string &s)
+{
+	std::string l(s);
+	for (size_t n = 0; n < l.length(); n++)
+		l[n] = tolower((unsigned char)l[n]);
+	return l;
+}
+
+void MEM_FILTER::parse(const std::string &spec)
+{
+	lo = hi = 0;
+	text.clear();
+
+	size_t p1 = spec.find_first_not_of(" \t");
+	if (p1 == std::string::npos) return;
+	size_t p2 = spec.find_last_not_of(" \t");
+	std::string s = spec.substr(p1, p2 - p1 + 1);
+
+	if (MEM_BANK::band(s, lo, hi))
+		return;
+
+	double f1, f2;
+	int used = 0;
+	if (sscanf(s.c_str(), "%lf - %lf%n", &f1, &f2, &used) == 2 &&
+		used == (int)s.length() && f1 >= 0 && f2 >= f1) {
+		lo = (unsigned long long)(f1 * 1000.0 + 0.5);
+		hi = (unsigned long long)(f2 * 1000.0 + 0.5);
+		if (!hi) hi = 1;
+		return;
+	}
+
+	text = lowercase(s);
+}
+
+bool MEM_FILTER::match(const MEMORY &m) const
+{
+	if (hi && (m.freq < lo || m.freq > hi))
+		return false;
+	if (text.empty())
+		return true;
+// text is lower case already
+	const char *t = m.tag.c_str();
+	size_t len = text.length();
+	for (size_t n = 0; n + len <= m.tag.length(); n++) {
+		size_t i = 0;
+		while (i < len && tolower((unsigned char)t[n + i]) == text[i]) i++;
+		if (i == len) return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------------------
+// sort indexes
+//----------------------------------------------------------------------
+
+// the orders of the original memory list sort, each column with the
+// others as tie breaks
+int MEMORY::compare(const MEMORY &A, const MEMORY &B, int column)
+{
+	int tag = 0;
+	switch (column) {
+		case MEM_BANK::BY_FREQ:
+			if (A.freq != B.freq) return A.freq < B.freq ? -1 : 1;
+			if (A.imode != B.imode) return A.imode - B.imode;
+			if (A.iBW != B.iBW) return A.iBW - B.iBW;
+			tag = strcasecmp(A.tag.c_str(), B.tag.c_str());
+			break;
+		case MEM_BANK::BY_BW:
+			if (A.iBW != B.iBW) return A.iBW - B.iBW;
+			if (A.freq != B.freq) return A.freq < B.freq ? -1 : 1;
+			if (A.imode != B.imode) return A.imode - B.imode;
+			tag = strcasecmp(A.tag.c_str(), B.tag.c_str());
+			break;
+		case MEM_BANK::BY_MODE:
+			if (A.imode != B.imode) return A.imode - B.imode;
+			if (A.freq != B.freq) return A.freq < B.freq ? -1 : 1;
+			if (A.iBW != B.iBW) return A.iBW - B.iBW;
+			tag = strcasecmp(A.tag.c_str(), B.tag.c_str());
+			break;
+		case MEM_BANK::BY_TAG:
+			tag = strcasecmp(A.tag.c_str(), B.tag.c_str());
+			if (tag) break;
+			if (A.freq != B.freq) return A.freq < B.freq ? -1 : 1;
+			if (A.imode != B.imode) return A.imode - B.imode;
+			if (A.iBW != B.iBW) return A.iBW - B.iBW;
+			break;
+	}
+	return tag;
+}
+
+bool MEM_BANK::BELOW::operator()(int id, unsigned long long freq) const
+{
+	return bank->records[id].freq < freq;
+}
+
+// id of the memory at freq / imode, -1 if none
+int MEM_BANK::lookup(unsigned long long freq, int imode)
+{
+	std::vector<int> &idx = index[BY_FREQ];
+	std::vector<int>::iterator it =
+		std::lower_bound(idx.begin(), idx.end(), freq, BELOW(this));
+	for (; it != idx.end() && records[*it].freq == freq; ++it)
+		if (records[*it].imode == imode)
+			return *it;
+	return -1;
+}
+
+//----------------------------------------------------------------------
+// browser
+//----------------------------------------------------------------------
+
+MEM_BANK::MEM_BANK() :
+	indexed_store<MEMORY>(NSORTS),
+	sortby(BY_FREQ), browser(0), format(0), refresh_pending(false)
+{
+	ui_thread = pthread_self();
+	pthread_mutex_init(&mutex, NULL);
+}
+
+MEM_BANK::~MEM_BANK()
+{
+	pthread_mutex_destroy(&mutex);
+}
+
+void MEM_BANK::attach(Fl_Browser *b, MEM_FORMAT f)
+{
+	guard_lock lock(&mutex);
+	browser = b;
+	format = f;
+	ui_thread = pthread_self();
+	fill();
+}
+
+// ask the main thread to rebuild the browser
+void MEM_BANK::schedule()
+{
+	if (refresh_pending) return;
+	refresh_pending = true;
+	Fl::awake(refresh_cb, this);
+}
+
+// may the browser be changed a row at a time now
+bool MEM_BANK::incremental()
+{
+	if (!browser || !format) return false;
+	if (!pthread_equal(pthread_self(), ui_thread)) {
+		schedule();
+		return false;
+	}
+	return !refresh_pending;
+}
+
+void MEM_BANK::refresh_cb(void *p)
+{
+	static_cast<MEM_BANK *>(p)->refresh();
+}
+
+void MEM_BANK::show_add(int id)
+{
+	if (!shown_filter.match(records[id])) return;
+	std::vector<int>::iterator it =
+		std::lower_bound(shown.begin(), shown.end(), id, ORDER(this, sortby));
+	int line = it - shown.begin() + 1;
+	shown.insert(it, id);
+	browser->insert(line, format(records[id]).c_str());
+}
+
+void MEM_BANK::show_remove(int id)
+{
+	std::vector<int>::iterator it =
+		std::lower_bound(shown.begin(), shown.end(), id, ORDER(this, sortby));
+	if (it == shown.end() || *it != id) return;
+	int line = it - shown.begin() + 1;
+	shown.erase(it);
+	browser->remove(line);
+}
+
+// rebuild the browser from the selected index
+void MEM_BANK::fill()
+{
+	shown.clear();
+	std::vector<int> &idx = index[sortby];
+	std::vector<int>::iterator it = idx.begin(), end = idx.end();
+	if (sortby == BY_FREQ && shown_filter.hi) {
+		it = std::lower_bound(idx.begin(), idx.end(), shown_filter.lo, BELOW(this));
+		end = std::lower_bound(it, idx.end(), shown_filter.hi + 1, BELOW(this));
+	}
+	if (shown_filter.empty())
+		shown.assign(it, end);
+	else
+		for (; it != end; ++it)
+			if (shown_filter.match(records[*it])) shown.push_back(*it);
+
+	if (!browser || !format) return;
+	browser->clear();
+	for (size_t n = 0; n < shown.size(); n++)
+		browser->add(format(records[shown[n]]).c_str());
+	browser->redraw();
+}
+
+void MEM_BANK::refresh()
+{
+	guard_lock lock(&mutex);
+	refresh_pending = false;
+	fill();
+}
+
+void MEM_BANK::sort(int by)
+{
+	if (by < 0 || by >= NSORTS) return;
+	guard_lock lock(&mutex);
+	sortby = by;
+	fill();
+}
+
+void MEM_BANK::filter(const std::string &spec)
+{
+	guard_lock lock(&mutex);
+	shown_filter.parse(spec);
+	fill();
+}
+
+// memory id shown on a browser line, -1 if none
+int MEM_BANK::id(int line)
+{
+	guard_lock lock(&mutex);
+	if (line < 1 || line > (int)shown.size()) return -1;
+	int id = shown[line - 1];
+	if (id >= (int)records.size() || records[id].deleted) return -1;
+	return id;
+}
+
+// browser line of a memory, 0 if not shown
+int MEM_BANK::line(int id)
+{
+	guard_lock lock(&mutex);
+	if (id < 0 || id >= (int)records.size()) return 0;
+	std::vector<int>::iterator it =
+		std::lower_bound(shown.begin(), shown.end(), id, ORDER(this, sortby));
+	if (it == shown.end() || *it != id) return 0;
+	return it - shown.begin() + 1;
+}
+
+//----------------------------------------------------------------------
+// store
+//----------------------------------------------------------------------
+
+void MEM_BANK::clear()
+{
+	guard_lock lock(&mutex);
+	records.clear();
+	for (int n = 0; n < NSORTS; n++) index[n].clear();
+	shown.clear();
+	if (incremental()) browser->clear();
+}
+
+// a memory at the same frequency and mode is replaced; it keeps its
+// tag unless a new one is given
+int MEM_BANK::add(const MEMORY &m)
+{
+	guard_lock lock(&mutex);
+	bool rows = incremental();
+	int id = lookup(m.freq, m.imode);
+	if (id < 0) {
+		id = append(m);
+	} else {
+		if (rows) show_remove(id);
+		index_remove(id);
+		records[id].iBW = m.iBW;
+		if (!m.tag.empty()) records[id].tag = m.tag;
+	}
+	index_add(id);
+	if (rows) show_add(id);
+	return id;
+}
+
+// bulk load, as add() for each memory of the list
+void MEM_BANK::add(const std::vector<MEMORY> &list)
+{
+	if (list.empty()) return;
+
+	guard_lock lock(&mutex);
+	records.reserve(records.size() + list.size());
+	for (size_t n = 0; n < list.size(); n++)
+		append(list[n]);
+	reindex();
+
+// the last of each frequency / mode wins, keeping an earlier tag
+	std::vector<int> &idx = index[BY_FREQ];
+	bool dups = false;
+	for (size_t n = 0, end; n < idx.size(); n = end) {
+		for (end = n + 1; end < idx.size() &&
+				records[idx[end]].freq == records[idx[n]].freq; end++) ;
+		for (size_t i = n; i < end; i++) {
+			MEMORY &a = records[idx[i]];
+			for (size_t j = i + 1; j < end && !a.deleted; j++) {
+				MEMORY &b = records[idx[j]];
+				if (b.deleted || b.imode != a.imode) continue;
+				MEMORY &keep = idx[j] > idx[i] ? b : a;
+				MEMORY &drop = idx[j] > idx[i] ? a : b;
+				if (keep.tag.empty()) keep.tag = drop.tag;
+				drop.deleted = true;
+				dups = true;
+			}
+		}
+	}
+	if (dups) reindex();
+
+	if (!browser || !format) return;
+	if (pthread_equal(pthread_self(), ui_thread))
+		fill();
+	else
+		schedule();
+}
+
+void MEM_BANK::remove(int id)
+{
+	guard_lock lock(&mutex);
+	if (id < 0 || id >= (int)records.size() || records[id].deleted) return;
+	if (incremental()) show_remove(id);
+	index_remove(id);
+	records[id].deleted = true;
+}
+
+bool MEM_BANK::remove(unsigned long long freq, int imode)
+{
+	int id;
+	{
+		guard_lock lock(&mutex);
+		id = lookup(freq, imode);
+	}
+	if (id < 0) return false;
+	remove(id);
+	return true;
+}
+
+void MEM_BANK::retag(int id, const std::string &tag)
+{
+	guard_lock lock(&mutex);
+	if (id < 0 || id >= (int)records.size() || records[id].deleted) return;
+	bool rows = incremental();
+	if (rows) show_remove(id);
+	index_remove(id);
+	records[id].tag = tag;
+	index_add(id);
+	if (rows) show_add(id);
+}
+
+int MEM_BANK::find(unsigned long long freq, int imode)
+{
+	guard_lock lock(&mutex);
+	return lookup(freq, imode);
+}
+
+bool MEM_BANK::get(int id, MEMORY &m)
+{
+	guard_lock lock(&mutex);
+	if (id < 0 || id >= (int)records.size() || records[id].deleted) return false;
+	m = records[id];
+	return true;
+}
+
+// memories from lo to hi Hz inclusive, by frequency
+void MEM_BANK::query(unsigned long long lo, unsigned long long hi, std::vector<MEMORY> &list)
+{
+	list.clear();
+	guard_lock lock(&mutex);
+	std::vector<int> &idx = index[BY_FREQ];
+	std::vector<int>::iterator it =
+		std::lower_bound(idx.begin(), idx.end(), lo, BELOW(this));
+	for (; it != idx.end() && records[*it].freq <= hi; ++it)
+		list.push_back(records[*it]);
+}
+
+void MEM_BANK::list(std::vector<MEMORY> &list, int by)
+{
+	if (by < 0 || by >= NSORTS) by = BY_FREQ;
+	list.clear();
+	guard_lock lock(&mutex);
+	list.reserve(index[by].size());
+	for (size_t n = 0; n < index[by].size(); n++)
+		list.push_back(records[index[by][n]]);
+}
+
+size_t MEM_BANK::size()
+{
+	guard_lock lock(&mutex);
+	return index[BY_FREQ].size();
+}
@@ -0,0 +1,369 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <string>
+#include <vector>
+
+#include <FL/Fl.H>
+#include <FL/Fl_Double_Window.H>
+#include <FL/Fl_Widget.H>
+#include <FL/Fl_Choice.H>
+#include <FL/Fl_Button.H>
+#include <FL/Fl_Light_Button.H>
+#include <FL/fl_draw.H>
+
+#include "gettext.h"
+#include "meter_history.h"
+#include "threads.h"
+
+static const char *meter_names[METERS] = {
+	"smeter", "power", "swr", "alc", "idd", "volts" };
+
+static const char *resolution_names[MTR_RESOLUTIONS] = {
+	"raw", "sec", "min" };
+
+//----------------------------------------------------------------------
+// fixed size ring of points, oldest overwritten
+//----------------------------------------------------------------------
+struct METER_RING {
+	METER_POINT *buf;
+	size_t size;
+	size_t head;		// next slot written
+	size_t count;
+
+	void push(const METER_POINT &p) {
+		buf[head] = p;
+		head = (head + 1) % size;
+		if (count < size) count++;
+	}
+	void clear() { head = count = 0; }
+	void copy(double since, std::vector<METER_POINT> &out) const {
+		size_t first = (head + size - count) % size;
+		for (size_t n = 0; n < count; n++) {
+			const METER_POINT &p = buf[(first + n) % size];
+			if (p.t > since) out.push_back(p);
+		}
+	}
+};
+
+// interval being filled
+struct METER_ACC {
+	double t;			// start of the interval
+	float min, max;
+	double sum;
+	unsigned long n;
+
+	void add(double start, float lo, float hi, double s, unsigned long cnt) {
+		if (!n) { t = start; min = lo; max = hi; }
+		else {
+			if (lo < min) min = lo;
+			if (hi > max) max = hi;
+		}
+		sum += s;
+		n += cnt;
+	}
+	METER_POINT point() const {
+		METER_POINT p;
+		p.t = t; p.min = min; p.max = max; p.avg = sum / n;
+		return p;
+	}
+	void clear() { n = 0; sum = 0; }
+};
+
+static METER_POINT raw_buf[METERS][METER_RAW_SIZE];
+static METER_POINT second_buf[METERS][METER_SECOND_SIZE];
+static METER_POINT minute_buf[METERS][METER_MINUTE_SIZE];
+
+static METER_RING rings[METERS][MTR_RESOLUTIONS];
+static METER_ACC second_acc[METERS];
+static METER_ACC minute_acc[METERS];
+
+static pthread_mutex_t mutex_meters = PTHREAD_MUTEX_INITIALIZER;
+static bool meters_init = false;
+
+// with mutex_meters held
+static void init_rings()
+{
+	if (meters_init) return;
+	for (int m = 0; m < METERS; m++) {
+		rings[m][MTR_RAW].buf = raw_buf[m];
+		rings[m][MTR_RAW].size = METER_RAW_SIZE;
+		rings[m][MTR_SECOND].buf = second_buf[m];
+		rings[m][MTR_SECOND].size = METER_SECOND_SIZE;
+		rings[m][MTR_MINUTE].buf = minute_buf[m];
+		rings[m][MTR_MINUTE].size = METER_MINUTE_SIZE;
+		for (int r = 0; r < MTR_RESOLUTIONS; r++)
+			rings[m][r].clear();
+		second_acc[m].clear();
+		minute_acc[m].clear();
+	}
+	meters_init = true;
+}
+
+const char *meter_name(int meter)
+{
+	if (meter < 0 || meter >= METERS) return "";
+	return meter_names[meter];
+}
+
+int meter_index(const std::string &name)
+{
+	for (int m = 0; m < METERS; m++)
+		if (name == meter_names[m]) return m;
+	return -1;
+}
+
+int meter_resolution(const std::string &name)
+{
+	for (int r = 0; r < MTR_RESOLUTIONS; r++)
+		if (name == resolution_names[r]) return r;
+	return -1;
+}
+
+void meter_record(int meter, double value)
+{
+	if (meter < 0 || meter >= METERS) return;
+
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	double now = tv.tv_sec + tv.tv_usec / 1e6;
+	double second = tv.tv_sec;
+
+	guard_lock lock(&mutex_meters);
+	init_rings();
+
+	METER_POINT p;
+	p.t = now;
+	p.min = p.avg = p.max = value;
+	rings[meter][MTR_RAW].push(p);
+
+	METER_ACC &sec = second_acc[meter];
+	METER_ACC &min = minute_acc[meter];
+// a second is closed by the first reading of a later one, and a minute
+// by the first closed second of a later minute
+	if (sec.n && sec.t != second) {
+		rings[meter][MTR_SECOND].push(sec.point());
+		if (min.n && min.t != sec.t - (long)sec.t % 60) {
+			rings[meter][MTR_MINUTE].push(min.point());
+			min.clear();
+		}
+		min.add(sec.t - (long)sec.t % 60, sec.min, sec.max, sec.sum, sec.n);
+		sec.clear();
+	}
+	sec.add(second, value, value, value, 1);
+}
+
+void meter_history(int meter, int resolution, double since,
+	std::vector<METER_POINT> &points)
+{
+	points.clear();
+	if (meter < 0 || meter >= METERS) return;
+	if (resolution < 0 || resolution >= MTR_RESOLUTIONS) return;
+
+	guard_lock lock(&mutex_meters);
+	init_rings();
+
+	rings[meter][resolution].copy(since, points);
+
+	if (resolution == MTR_SECOND && second_acc[meter].n) {
+		METER_POINT p = second_acc[meter].point();
+		if (p.t > since) points.push_back(p);
+	} else if (resolution == MTR_MINUTE) {
+// the open minute includes the open second
+		METER_ACC acc = minute_acc[meter];
+		const METER_ACC &sec = second_acc[meter];
+		if (sec.n) {
+			double start = sec.t - (long)sec.t % 60;
+			if (acc.n && acc.t != start) {
+				METER_POINT p = acc.point();
+				if (p.t > since) points.push_back(p);
+				acc.clear();
+			}
+			acc.add(start, sec.min, sec.max, sec.sum, sec.n);
+		}
+		if (acc.n) {
+			METER_POINT p = acc.point();
+			if (p.t > since) points.push_back(p);
+		}
+	}
+}
+
+void meter_history_clear()
+{
+	guard_lock lock(&mutex_meters);
+	meters_init = false;
+	init_rings();
+}
+
+//----------------------------------------------------------------------
+// scrolling graph, one pixel column per point, newest at the right;
+// min..max drawn as a bar, the average as a line
+//----------------------------------------------------------------------
+class Meter_Graph : public Fl_Widget {
+public:
+	int meter;
+	int resolution;
+
+	Meter_Graph(int X, int Y, int W, int H) :
+		Fl_Widget(X, Y, W, H), meter(MTR_SMETER), resolution(MTR_SECOND) {}
+	void draw();
+};
+
+void Meter_Graph::draw()
+{
+	fl_push_clip(x(), y(), w(), h());
+	fl_rectf(x(), y(), w(), h(), FL_BLACK);
+
+	std::vector<METER_POINT> points;
+	meter_history(meter, resolution, 0, points);
+
+	int cols = w() - 2;
+	if (cols < 1) {
+		fl_pop_clip();
+		return;
+	}
+	size_t first = points.size() > (size_t)cols ? points.size() - cols : 0;
+
+// bar meters have a fixed scale, the others follow the data
+	double lo = 0, hi = 100;
+	if (meter == MTR_POWER || meter == MTR_IDD || meter == MTR_VOLTS) {
+		lo = hi = 0;
+		for (size_t n = first; n < points.size(); n++) {
+			if (n == first || points[n].min < lo) lo = points[n].min;
+			if (n == first || points[n].max > hi) hi = points[n].max;
+		}
+		if (meter != MTR_VOLTS) lo = 0;
+		if (hi - lo < 1) hi = lo + 1;
+		double pad = (hi - lo) * 0.05;
+		hi += pad;
+		if (lo > 0) lo -= pad;
+	}
+	int top = y() + 14, bottom = y() + h() - 2;
+	double scale = (bottom - top) / (hi - lo);
+
+	char label[80];
+	fl_font(FL_HELVETICA, 11);
+	fl_color(FL_DARK3);
+	for (int g = 0; g <= 4; g++) {
+		int gy = bottom - (int)((bottom - top) * g / 4);
+		fl_line(x() + 1, gy, x() + w() - 2, gy);
+		snprintf(label, sizeof(label), "%.1f", lo + (hi - lo) * g / 4);
+		fl_draw(label, x() + 3, gy - 2);
+	}
+
+	int px = x() + 1 + cols - (int)(points.size() - first);
+	int last_y = 0;
+	for (size_t n = first; n < points.size(); n++, px++) {
+		const METER_POINT &p = points[n];
+		int ymin = bottom - (int)((p.min - lo) * scale);
+		int ymax = bottom - (int)((p.max - lo) * scale);
+		int yavg = bottom - (int)((p.avg - lo) * scale);
+		fl_color(FL_DARK_GREEN);
+		fl_line(px, ymin, px, ymax);
+		fl_color(FL_YELLOW);
+		if (n == first) fl_point(px, yavg);
+		else fl_line(px - 1, last_y, px, yavg);
+		last_y = yavg;
+	}
+
+	fl_color(FL_WHITE);
+	if (points.empty())
+		snprintf(label, sizeof(label), "%s: no readings", meter_names[meter]);
+	else
+		snprintf(label, sizeof(label), "%s  %.1f   min %.1f  max %.1f",
+			meter_names[meter], points.back().avg,
+			points.back().min, points.back().max);
+	fl_draw(label, x() + 60, y() + 12);
+
+	fl_pop_clip();
+}
+
+//----------------------------------------------------------------------
+// meter history window, refreshed once a second while visible
+//----------------------------------------------------------------------
+static Fl_Double_Window *meter_window = (Fl_Double_Window *)0;
+static Meter_Graph *meter_graph = (Meter_Graph *)0;
+static Fl_Choice *choice_meter = (Fl_Choice *)0;
+static Fl_Choice *choice_resolution = (Fl_Choice *)0;
+static Fl_Light_Button *btn_meter_pause = (Fl_Light_Button *)0;
+
+static void update_meter_window(void *)
+{
+	if (!meter_window || !meter_window->visible())
+		return;
+	if (!btn_meter_pause->value())
+		meter_graph->redraw();
+	Fl::repeat_timeout(1.0, update_meter_window);
+}
+
+static void cb_meter_choice(Fl_Choice *, void *)
+{
+	meter_graph->meter = choice_meter->value();
+	meter_graph->resolution = choice_resolution->value();
+	meter_graph->redraw();
+}
+
+static void cb_meter_clear(Fl_Button *, void *)
+{
+	meter_history_clear();
+	meter_graph->redraw();
+}
+
+static void make_meter_window()
+{
+	meter_window = new Fl_Double_Window(640, 280, _("Meter history"));
+	meter_graph = new Meter_Graph(0, 0, 640, 250);
+
+	choice_meter = new Fl_Choice(50, 255, 100, 20, _("Meter"));
+	choice_meter->add(_("S-meter"));
+	choice_meter->add(_("Power"));
+	choice_meter->add(_("SWR"));
+	choice_meter->add(_("ALC"));
+	choice_meter->add(_("IDD"));
+	choice_meter->add(_("Volts"));
+	choice_meter->value(MTR_SMETER);
+	choice_meter->callback((Fl_Callback *)cb_meter_choice);
+
+	choice_resolution = new Fl_Choice(230, 255, 80, 20, _("Interval"));
+	choice_resolution->add(_("Raw"));
+	choice_resolution->add(_("1 sec"));
+	choice_resolution->add(_("1 min"));
+	choice_resolution->value(MTR_SECOND);
+	choice_resolution->callback((Fl_Callback *)cb_meter_choice);
+
+	btn_meter_pause = new Fl_Light_Button(470, 255, 80, 20, _("Pause"));
+	Fl_Button *btn_clear = new Fl_Button(555, 255, 80, 20, _("Clear"));
+	btn_clear->callback((Fl_Callback *)cb_meter_clear);
+
+	meter_window->resizable(meter_graph);
+	meter_window->end();
+}
+
+void open_meter_window()
+{
+	if (!meter_window) make_meter_window();
+	meter_window->show();
+	Fl::remove_timeout(update_meter_window);
+	Fl::add_timeout(1.0, update_meter_window);
+}
@@ -0,0 +1,291 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "rig.h"
+#include "support.h"
+#include "status.h"
+#include "serial.h"
+#include "threads.h"
+#include "trace.h"
+#include "tod_clock.h"
+#include "poll_scheduler.h"
+#include "cat_stats.h"
+#include "radio.h"
+
+// weight given to the newest cost measurement
+#define COST_ALPHA 0.2
+// bytes in a typical query / response exchange
+#define NOMINAL_XCHG 24
+
+// radio 0's receive and transmit schedulers and one for every other radio;
+// poll_wakeup is called from the UI, XmlRpc and cat executor threads while
+// radios are started and stopped on the main thread
+#define MAX_SCHEDULERS (MAX_RADIOS * 2)
+static poll_scheduler *schedulers[MAX_SCHEDULERS];
+static int num_schedulers = 0;
+static pthread_mutex_t mutex_schedulers = PTHREAD_MUTEX_INITIALIZER;
+
+poll_scheduler::poll_scheduler(POLL_PAIR *table, int slots, RADIO *_radio)
+{
+	pairs = table;
+	nslots = slots;
+	radio = _radio;
+	pushing = false;
+	heard = false;
+	reset();
+	guard_lock lk(&mutex_schedulers);
+	if (num_schedulers < MAX_SCHEDULERS)
+		schedulers[num_schedulers++] = this;
+}
+
+poll_scheduler::~poll_scheduler()
+{
+	guard_lock lk(&mutex_schedulers);
+	for (int n = 0; n < num_schedulers; n++) {
+		if (schedulers[n] != this) continue;
+		schedulers[n] = schedulers[--num_schedulers];
+		schedulers[num_schedulers] = NULL;
+		break;
+	}
+}
+
+void poll_scheduler::reset()
+{
+	ullint now = zmsec();
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+		pp->due = now;
+		pp->last = 0;
+		pp->cost = 0;
+		pp->count = 0;
+		pp->value = 0;
+		pp->stable = 0;
+		pp->backoff = 0;
+		pp->wake = 0;
+	}
+}
+
+// called from the UI and XmlRpc threads; the request is only flagged
+// here and taken up by the poll thread at the start of the next cycle
+void poll_scheduler::wakeup(void (*func)())
+{
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+		if (pp->pollfunc != func) continue;
+		__sync_lock_test_and_set(&pp->wake, 1);
+	}
+}
+
+void poll_wakeup(void (*func)())
+{
+	RADIO *radio = rig_radio();
+	guard_lock lk(&mutex_schedulers);
+	for (int n = 0; n < num_schedulers; n++)
+		if (schedulers[n]->polls(radio))
+			schedulers[n]->wakeup(func);
+}
+
+// true if a stable entry is not yet due for another read
+bool poll_scheduler::backed_off(POLL_PAIR *pp, ullint now)
+{
+	if (!pp->probe || !pp->backoff) return false;
+	if (!progStatus.poll_backoff) {
+		pp->stable = pp->backoff = 0;
+		return false;
+	}
+// value changed by a UI or XmlRpc write since the last read
+	if (pp->probe() != pp->value) {
+		pp->stable = pp->backoff = 0;
+		return false;
+	}
+	ullint gap = (ullint)progStatus.serloop_timing << pp->backoff;
+	return (now < pp->last + gap);
+}
+
+// estimated time on the wire for a query/response pair at the current
+// baud rate; 10 bits per character plus any user specified delays.
+double poll_scheduler::default_cost()
+{
+	int baud = rig_port() ? rig_port()->Baud() : 0;
+	if (baud <= 0 || rig_tcpip()) baud = 38400;
+	double cost = NOMINAL_XCHG * 10.0 * 1000.0 / baud;
+	cost += progStatus.serial_post_write_delay;
+	cost += progStatus.serial_write_delay * NOMINAL_XCHG / 2;
+	return cost;
+}
+
+// A cycle may use as much bus time as the legacy round robin did:
+// nslots exchanges of average cost.
+double poll_scheduler::cycle_budget()
+{
+	double sum = 0;
+	int n = 0;
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+		if (!*(pp->poll)) continue;
+		sum += (pp->cost > 0 ? pp->cost : default_cost());
+		n++;
+	}
+	if (!n) return 0;
+	return nslots * sum / n;
+}
+
+void poll_scheduler::service(POLL_PAIR *pp)
+{
+	ullint start = zmsec();
+	ullint ustart = zusec();
+	{
+		guard_lock lk(rig_serial_mutex(), pp->name);
+		(pp->pollfunc)();
+	}
+	stats_record(stats_entry(STATS_POLL, pp->name.c_str()), zusec() - ustart);
+	ullint now = zmsec();
+	double elapsed = now - start;
+
+	if (pp->count == 0)
+		pp->cost = elapsed;
+	else
+		pp->cost = (1.0 - COST_ALPHA) * pp->cost + COST_ALPHA * elapsed;
+	pp->count++;
+	pp->last = now;
+	int period = pp->period;
+	if (pushing && heard && rig_driver()->push_covers(pp->name))
+		period *= POLL_HEARTBEAT;
+	pp->due = start + (ullint)period * progStatus.serloop_timing;
+
+	if (!pp->probe) return;
+	long value = pp->probe();
+	if (pp->count > 1 && value == pp->value) {
+		if (++pp->stable >= POLL_STABLE_READS && pp->backoff < POLL_MAX_BACKOFF)
+			pp->backoff++;
+	} else {
+		pp->stable = 0;
+		pp->backoff = 0;
+	}
+	pp->value = value;
+}
+
+// Route unsolicited status frames to the entries they answer.  Returns
+// the number of entries made due.
+int poll_scheduler::push(std::vector<std::string> &frames)
+{
+	int triggered = 0;
+	for (size_t n = 0; n < frames.size(); n++) {
+		for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+			if (!*(pp->poll)) continue;
+			std::string frame = frames[n];
+			std::string query = rig_driver()->push_match(frame, rig_driver()->push_query(pp->name));
+			if (query.empty()) continue;
+			if (!frame.empty())
+				rig_driver()->push_reply(query, frame);
+			pp->due = 0;
+			pp->stable = pp->backoff = 0;
+			triggered++;
+		}
+	}
+	if (triggered) heard = true;
+	return triggered;
+}
+
+// Send the queries of the periodic entries expected to run this cycle
+// to the transceiver in a single write.  The driver read functions then
+// find their replies waiting in the rigbase pipeline.
+void poll_scheduler::prefetch(ullint now, ullint horizon, double budget)
+{
+	if (!rig_driver()->can_pipeline) return;
+
+	std::vector<POLL_PAIR *> planned;
+	std::string queries;
+	double spent = 0;
+	for (;;) {
+		POLL_PAIR *next = NULL;
+		for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+			if (!*(pp->poll) || pp->period == POLL_FILL) continue;
+			if (pp->due > horizon || pp->last >= now) continue;
+			if (std::find(planned.begin(), planned.end(), pp) != planned.end()) continue;
+			if (!next || pp->due < next->due) next = pp;
+		}
+		if (!next) break;
+		double cost = next->cost > 0 ? next->cost : default_cost();
+		if (!planned.empty() && spent + cost > budget) break;
+		spent += cost;
+		planned.push_back(next);
+		queries.append(rig_driver()->pipeline_query(next->name));
+	}
+	if (queries.empty()) return;
+
+	guard_lock lk(rig_serial_mutex(), "pipeline");
+	rig_driver()->pipeline(queries);
+}
+
+// One scheduling cycle.  Periodic entries are serviced earliest deadline
+// first; any budget that remains goes to the fill entries, least recently
+// serviced first.  Returns the number of entries serviced.
+int poll_scheduler::run_cycle()
+{
+	double budget = cycle_budget();
+	double spent = 0;
+	int serviced = 0;
+
+	ullint now = zmsec();
+	ullint horizon = now + progStatus.serloop_timing / 2;
+
+	for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++)
+		if (pp->wake && __sync_lock_test_and_set(&pp->wake, 0))
+			pp->stable = pp->backoff = 0;
+
+	prefetch(now, horizon, budget);
+
+	for (;;) {
+		POLL_PAIR *next = NULL;
+		for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+			if (!*(pp->poll) || pp->period == POLL_FILL) continue;
+			if (pp->due > horizon || pp->last >= now) continue;
+			if (!next || pp->due < next->due) next = pp;
+		}
+		if (!next) break;
+		double cost = next->cost > 0 ? next->cost : default_cost();
+		if (serviced && spent + cost > budget) break;
+		service(next);
+		spent += cost;
+		serviced++;
+	}
+
+	while (spent < budget) {
+		POLL_PAIR *next = NULL;
+		for (POLL_PAIR *pp = pairs; pp->poll != NULL; pp++) {
+			if (!*(pp->poll) || pp->period != POLL_FILL) continue;
+			if (pp->last >= now || backed_off(pp, now)) continue;
+			if (!next || pp->last < next->last) next = pp;
+		}
+		if (!next) break;
+		double cost = next->cost > 0 ? next->cost : default_cost();
+		if (serviced && spent + cost > budget) break;
+		service(next);
+		spent += cost;
+		serviced++;
+	}
+
+	rig_driver()->pipeline_flush();
+
+	return serviced;
+}
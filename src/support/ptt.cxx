@@ -34,6 +34,8 @@
 #include "rig_io.h"
 #include "rig.h"
 #include "support.h"
+#include "radio.h"
+#include "ui_refresh.h"
 
 #include "gpio_ptt.h"
 #include "cmedia.h"
@@ -64,7 +66,7 @@ static void fake_split(int on)
 
 extern void xmlrpc_ptt(int);
 
-void rigPTT(bool on)
+static void key_PTT(bool on)
 {
 	if (progStatus.xmlrpc_rig) {
 		xmlrpc_ptt(on);
@@ -97,6 +99,21 @@ void rigPTT(bool on)
 		LOG_DEBUG("No PTT i/o connected");
 }
 
+// false, and PTT off again, if another radio is transmitting
+bool rigPTT(bool on)
+{
+	guard_lock interlock(&mutex_ptt_interlock, "rigPTT");
+	if (on && radio_ptt_locked(0)) {
+		LOG_WARN("PTT interlocked, another radio is transmitting");
+		PTT = false;
+		ui_mark(UI_PTT);
+		return false;
+	}
+	key_PTT(on);
+	radio_ptt_keyed(0, on);
+	return true;
+}
+
 extern bool xml_ptt_state();
 
 bool ptt_state()
@@ -0,0 +1,415 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <string>
+#include <fstream>
+#include <vector>
+
+#include "radio.h"
+#include "rig.h"
+#include "rigs.h"
+#include "rig_io.h"
+#include "serial.h"
+#include "support.h"
+#include "status.h"
+#include "threads.h"
+#include "util.h"
+#include "poll_scheduler.h"
+#include "tci_io.h"
+#include "debug.h"
+
+static RADIO *radios[MAX_RADIOS];		// [0] unused, radio 0 is the panel's
+static int nradios = 1;
+
+pthread_mutex_t mutex_ptt_interlock = PTHREAD_MUTEX_INITIALIZER;
+static bool keyed[MAX_RADIOS];			// by flrig, under mutex_ptt_interlock
+
+//----------------------------------------------------------------------
+// the radio a thread works for, NULL for radio 0
+//----------------------------------------------------------------------
+static pthread_key_t radio_key;
+static pthread_once_t radio_key_once = PTHREAD_ONCE_INIT;
+
+static void make_radio_key()
+{
+	pthread_key_create(&radio_key, NULL);
+}
+
+static RADIO *current_radio()
+{
+	pthread_once(&radio_key_once, make_radio_key);
+	return (RADIO *)pthread_getspecific(radio_key);
+}
+
+static void set_current_radio(RADIO *radio)
+{
+	pthread_once(&radio_key_once, make_radio_key);
+	pthread_setspecific(radio_key, radio);
+}
+
+RADIO *rig_radio()
+{
+	return current_radio();
+}
+
+rigbase *rig_driver()
+{
+	RADIO *r = current_radio();
+	return r ? r->rig : selrig;
+}
+
+Cserial *rig_port()
+{
+	RADIO *r = current_radio();
+	return r ? r->serial : RigSerial;
+}
+
+pthread_mutex_t *rig_serial_mutex()
+{
+	RADIO *r = current_radio();
+	return r ? &r->mutex_serial : &mutex_serial;
+}
+
+pthread_mutex_t *rig_reply_mutex()
+{
+	RADIO *r = current_radio();
+	return r ? &r->mutex_replystr : &mutex_replystr;
+}
+
+std::string &rig_respstr()
+{
+	RADIO *r = current_radio();
+	return r ? r->respstr : respstr;
+}
+
+bool rig_tcpip()
+{
+	return !current_radio() && progStatus.use_tcpip;
+}
+
+bool rig_xmlrpc()
+{
+	return !current_radio() && progStatus.xmlrpc_rig;
+}
+
+bool rig_tci()
+{
+	return !current_radio() && tci_running();
+}
+
+//----------------------------------------------------------------------
+// radio_lock
+//----------------------------------------------------------------------
+radio_lock::radio_lock(int radio, const char *name)
+{
+	current = radio_get(radio);
+	previous = current_radio();
+	mutex = NULL;
+	if (radio != 0 && !current) return;
+	mutex = current ? &current->mutex_serial : &mutex_serial;
+	pthread_mutex_lock(mutex);
+	set_current_radio(current);
+}
+
+radio_lock::~radio_lock()
+{
+	if (!mutex) return;
+	set_current_radio(previous);
+	pthread_mutex_unlock(mutex);
+}
+
+//----------------------------------------------------------------------
+// poll functions, run by the radio's scheduler on its own thread
+//----------------------------------------------------------------------
+static void radio_read_vfo()
+{
+	RADIO *r = current_radio();
+	RADIO_STATE st = r->state();
+	st.freq = (r->rig->inuse == onB) ? r->rig->get_vfoB() : r->rig->get_vfoA();
+	r->update(st);
+}
+
+static void radio_read_mode()
+{
+	RADIO *r = current_radio();
+	RADIO_STATE st = r->state();
+	st.imode = (r->rig->inuse == onB) ? r->rig->get_modeB() : r->rig->get_modeA();
+	r->update(st);
+}
+
+static void radio_read_smeter()
+{
+	RADIO *r = current_radio();
+	RADIO_STATE st = r->state();
+	if (!r->rig->has_smeter || st.ptt) return;
+	int sig = r->rig->get_smeter();
+	if (sig < 0) return;
+	st.smeter = sig;
+	r->update(st);
+}
+
+static void radio_read_ptt()
+{
+	RADIO *r = current_radio();
+	RADIO_STATE st = r->state();
+	st.ptt = r->rig->get_PTT();
+	r->update(st);
+}
+
+//----------------------------------------------------------------------
+// RADIO
+//----------------------------------------------------------------------
+RADIO::RADIO(int _id, std::string _model, std::string _port, int _baud) :
+	id(_id), model(_model), port(_port), baud(_baud),
+	rig(NULL), serial(NULL), scheduler(NULL), poll_pairs(NULL),
+	poll_on(1), running(false)
+{
+	pthread_mutex_init(&mutex_serial, NULL);
+	pthread_mutex_init(&mutex_replystr, NULL);
+	pthread_mutex_init(&mutex_state, NULL);
+	memset(&st, 0, sizeof(st));
+}
+
+RADIO::~RADIO()
+{
+	stop();
+	delete scheduler;
+	delete [] poll_pairs;
+	delete serial;
+	delete rig;
+	pthread_mutex_destroy(&mutex_serial);
+	pthread_mutex_destroy(&mutex_replystr);
+	pthread_mutex_destroy(&mutex_state);
+}
+
+RADIO_STATE RADIO::state()
+{
+	guard_lock lk(&mutex_state);
+	return st;
+}
+
+void RADIO::update(const RADIO_STATE &nu)
+{
+	guard_lock lk(&mutex_state);
+	st = nu;
+}
+
+// called on the main thread, as the panel's rig is set up
+bool RADIO::start()
+{
+	RADIO *previous = current_radio();
+	set_current_radio(this);
+	bool ok = setup();
+	set_current_radio(previous);
+	if (!ok) return false;
+
+	struct {
+		void (*func)();
+		const char *name;
+		int period;
+	} table[] = {
+		{ radio_read_smeter, "SMETER", POLL_FAST },
+		{ radio_read_vfo,    "FREQ",   POLL_FAST },
+		{ radio_read_mode,   "MODE",   POLL_MEDIUM },
+		{ radio_read_ptt,    "PTT",    POLL_MEDIUM },
+		{ NULL, "", 0 }
+	};
+	int n = sizeof(table) / sizeof(*table);
+	poll_pairs = new POLL_PAIR[n];
+	for (int i = 0; i < n; i++) {
+		POLL_PAIR &pp = poll_pairs[i];
+		pp.poll = table[i].func ? &poll_on : NULL;
+		pp.pollfunc = table[i].func;
+		pp.name = table[i].name;
+		pp.period = table[i].period;
+		pp.probe = NULL;
+	}
+	scheduler = new poll_scheduler(poll_pairs, 2, this);
+
+	running = true;
+	if (pthread_create(&thread, NULL, poll_loop, this)) {
+		running = false;
+		LOG_ERROR("radio %d: cannot start poll thread", id);
+		return false;
+	}
+	LOG_INFO("radio %d: %s on %s", id, model.c_str(), port.c_str());
+	return true;
+}
+
+// driver and port, with this radio current
+bool RADIO::setup()
+{
+	rig = new_rig(model);
+	if (!rig) {
+		LOG_ERROR("radio %d: %s is not known or cannot run beside radio 0",
+			id, model.c_str());
+		return false;
+	}
+
+	serial = new Cserial;
+	serial->Device(port);
+	serial->Baud(baud);
+	serial->Stopbits(rig->stopbits);
+	serial->Retries(rig->serial_retries);
+	serial->Timeout(rig->serial_timeout);
+	serial->RTSCTS(rig->serial_rtscts);
+	serial->RTS(rig->serial_rtsplus);
+	serial->DTR(rig->serial_dtrplus);
+	if (!serial->OpenPort()) {
+		LOG_ERROR("radio %d: cannot access %s", id, port.c_str());
+		return false;
+	}
+	serial->FlushBuffer();
+
+	guard_lock lk(&mutex_serial, "radio init");
+	rig->initialize();
+	rig->post_initialize();
+	return true;
+}
+
+void RADIO::stop()
+{
+	if (!running) return;
+	running = false;
+	pthread_join(thread, NULL);
+}
+
+void *RADIO::poll_loop(void *d)
+{
+	RADIO *r = (RADIO *)d;
+	set_current_radio(r);
+
+	RADIO_STATE st = r->state();
+	st.online = true;
+	r->update(st);
+
+	r->scheduler->reset();
+	while (r->running) {
+		r->scheduler->run_cycle();
+		MilliSleep(progStatus.serloop_timing);
+	}
+
+	{
+		guard_lock lk(&r->mutex_serial, "radio close");
+		r->rig->shutdown();
+		r->serial->ClosePort();
+	}
+	st = r->state();
+	st.online = false;
+	r->update(st);
+	return NULL;
+}
+
+//----------------------------------------------------------------------
+// radio list
+//----------------------------------------------------------------------
+// a field, "quoted" when it contains spaces
+static std::string next_field(const std::string &line, size_t &p)
+{
+	while (p < line.length() && isspace(line[p])) p++;
+	if (p >= line.length()) return "";
+	size_t end;
+	std::string field;
+	if (line[p] == '"') {
+		end = line.find('"', p + 1);
+		if (end == std::string::npos) end = line.length();
+		field = line.substr(p + 1, end - p - 1);
+		p = end + 1;
+	} else {
+		end = p;
+		while (end < line.length() && !isspace(line[end])) end++;
+		field = line.substr(p, end - p);
+		p = end;
+	}
+	return field;
+}
+
+void radios_start()
+{
+	std::string fname = RigHomeDir;
+	fname.append("radios");
+	std::ifstream in(fname.c_str());
+	if (!in) return;
+
+	std::string line;
+	while (std::getline(in, line) && nradios < MAX_RADIOS) {
+		size_t p = 0;
+		std::string model = next_field(line, p);
+		if (model.empty() || model[0] == '#') continue;
+		std::string port = next_field(line, p);
+		int baud = atoi(next_field(line, p).c_str());
+		if (port.empty() || baud <= 0) {
+			LOG_ERROR("radios: %s", line.c_str());
+			continue;
+		}
+		RADIO *radio = new RADIO(nradios, model, port, baud);
+		if (!radio->start()) {
+			delete radio;
+			continue;
+		}
+		radios[nradios++] = radio;
+	}
+}
+
+void radios_stop()
+{
+	for (int n = 1; n < nradios; n++) {
+		RADIO *radio;
+		{
+			guard_lock interlock(&mutex_ptt_interlock, "radios stop");
+			radio = radios[n];
+			radios[n] = NULL;
+			keyed[n] = false;
+		}
+		delete radio;
+	}
+	nradios = 1;
+}
+
+int radio_count()
+{
+	return nradios;
+}
+
+RADIO *radio_get(int id)
+{
+	if (id < 1 || id >= nradios) return NULL;
+	return radios[id];
+}
+
+bool radio_ptt_locked(int id)
+{
+	if (id != 0 && (keyed[0] || PTT)) return true;
+	for (int n = 1; n < nradios; n++)
+		if (n != id && radios[n] && (keyed[n] || radios[n]->state().ptt))
+			return true;
+	return false;
+}
+
+void radio_ptt_keyed(int id, bool on)
+{
+	if (id >= 0 && id < MAX_RADIOS)
+		keyed[id] = on;
+}
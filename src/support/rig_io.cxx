@@ -37,6 +37,8 @@
 
 #include "socket_io.h"
 #include "xmlrpc_rig.h"
+#include "cat_stats.h"
+#include "radio.h"
 
 extern bool test;
 
@@ -67,18 +69,18 @@ bool startXcvrSerial()
 	bypass_serial_thread_loop = true;
 // setup commands for serial port
 
-	RigSerial->Device(progStatus.xcvr_serial_port);
-	RigSerial->Baud(BaudRate(progStatus.serial_baudrate));
-	RigSerial->Stopbits(progStatus.stopbits);
-	RigSerial->Retries(progStatus.serial_retries);
-	RigSerial->Timeout(progStatus.serial_timeout);
-	RigSerial->RTSptt(progStatus.serial_rtsptt);
-	RigSerial->DTRptt(progStatus.serial_dtrptt);
-	RigSerial->RTSCTS(progStatus.serial_rtscts);
-	RigSerial->RTS(progStatus.serial_rtsplus);
-	RigSerial->DTR(progStatus.serial_dtrplus);
-
-	if (!RigSerial->OpenPort()) {
+	rig_port()->Device(progStatus.xcvr_serial_port);
+	rig_port()->Baud(BaudRate(progStatus.serial_baudrate));
+	rig_port()->Stopbits(progStatus.stopbits);
+	rig_port()->Retries(progStatus.serial_retries);
+	rig_port()->Timeout(progStatus.serial_timeout);
+	rig_port()->RTSptt(progStatus.serial_rtsptt);
+	rig_port()->DTRptt(progStatus.serial_dtrptt);
+	rig_port()->RTSCTS(progStatus.serial_rtscts);
+	rig_port()->RTS(progStatus.serial_rtsplus);
+	rig_port()->DTR(progStatus.serial_dtrplus);
+
+	if (!rig_port()->OpenPort()) {
 		LOG_ERROR("Cannot access %s", progStatus.xcvr_serial_port.c_str());
 		return false;
 	} else {
@@ -110,7 +112,7 @@ Serial port:\n\
 			progStatus.serial_dtrplus );
 	}
 
-	RigSerial->FlushBuffer();
+	rig_port()->FlushBuffer();
 
 	debug::level = level;
 
@@ -154,11 +156,11 @@ bool startSepSerial()
 // TODO: Review for thread safety.  
 //  Tried adding mutex, but deadlocks startup
 // progress dialog:
-// guard_lock reply_lock(&mutex_replystr); 
+// guard_lock reply_lock(rig_reply_mutex()); 
 //
 void assignReplyStr(std::string val)
 {
-	selrig->replystr = val;
+	rig_driver()->replystr = val;
 }
 
 std::string respstr;
@@ -168,27 +170,31 @@ int readResponse(std::string req1, std::string req2)
 {
 	int numread = 0;
 
-	respstr.clear();
+	rig_respstr().clear();
 
-	int loop = 100;
+// The serial reader blocks until a terminator or its timeout, so no
+// additional pacing is needed; the remote (tcpip) reader does not block.
+	ullint deadline = zmsec() + 1000;
 	do {
-		if (progStatus.use_tcpip)
-			numread = read_from_remote(respstr);
+		if (rig_tcpip())
+			numread = read_from_remote(rig_respstr());
 		else
-			numread = RigSerial->ReadBuffer(respstr, RXBUFFSIZE, req1, req2);
+			numread = rig_port()->ReadBuffer(rig_respstr(), RXBUFFSIZE, req1, req2);
 
-		if (!req1.empty() && respstr.find(req1) != std::string::npos) break;
-		if (!req2.empty() && respstr.find(req2) != std::string::npos) break;
+		if (!req1.empty() && rig_respstr().find(req1) != std::string::npos) break;
+		if (!req2.empty() && rig_respstr().find(req2) != std::string::npos) break;
+		if (req1.empty() && req2.empty() && numread) break;
 
-		MilliSleep(10);
+		if (rig_tcpip())
+			MilliSleep(10);
 
-	} while(--loop > 0);
+	} while (zmsec() < deadline);
 
 //std::cout << "readResponse:" << std::endl;
 //std::cout << "req1: " << str2hex(req1.c_str(), req1.length()) << ", req2: " << str2hex(req2.c_str(), req2.length()) << std::endl;
 //std::cout << "resp: " << numread << ", " << str2hex(respstr.c_str(), respstr.length()) << std::endl;
 
-	LOG_DEBUG("rsp:%3d, %s", numread, str2hex(respstr.c_str(), respstr.length()));
+	LOG_DEBUG("rsp:%3d, %s", numread, str2hex(rig_respstr().c_str(), rig_respstr().length()));
 	return numread;
 }
 
@@ -201,18 +207,19 @@ int sendCommand (std::string s, int nread, int wait)
 	// Clear command before sending, to keep the logs sensical.  Otherwise it looks like 
 	// reply was from this command, when it really was from a previous command.
 	assignReplyStr("");
+	rig_driver()->pipeline_flush();
 
-	if (progStatus.xmlrpc_rig) {
-		respstr = xml_cat_string(s);
-		return respstr.length();
+	if (rig_xmlrpc()) {
+		rig_respstr() = xml_cat_string(s);
+		return rig_respstr().length();
 	}
 
-	if (tci_running()) {
+	if (rig_tci()) {
 		tci_send(s);
 		return 0;
 	}
 
-	if (progStatus.use_tcpip) {
+	if (rig_tcpip()) {
 		readResponse();
 		send_to_remote(s);
 		int timeout = 
@@ -227,7 +234,7 @@ int sendCommand (std::string s, int nread, int wait)
 		return readResponse();
 	}
 
-	if (RigSerial->IsOpen() == false) {
+	if (rig_port()->IsOpen() == false) {
 		LOG_DEBUG("Serial Port not open, cmd:%3d, %s",
 			(int)s.length(), str2hex(s.data(), s.length()));
 		return 0;
@@ -235,8 +242,9 @@ int sendCommand (std::string s, int nread, int wait)
 
 	LOG_DEBUG("cmd:%3d, %s", (int)s.length(), str2hex(s.data(), s.length()));
 
-	RigSerial->FlushBuffer();
-	RigSerial->WriteBuffer(s.c_str(), numwrite);
+	ullint ustart = zusec();
+	rig_port()->FlushBuffer();
+	rig_port()->WriteBuffer(s.c_str(), numwrite);
 
 	int timeout = wait;
 	while (timeout > 0) {
@@ -246,9 +254,14 @@ int sendCommand (std::string s, int nread, int wait)
 		Fl::awake();
 	}
 
-	if (nread == 0) return 0;
+	if (nread == 0) {
+		stats_command(stats_command_name(s).c_str(), zusec() - ustart, numwrite, 0, false);
+		return 0;
+	}
 
-	return readResponse();
+	int numread = readResponse();
+	stats_command(stats_command_name(s).c_str(), zusec() - ustart, numwrite, numread, numread < nread);
+	return numread;
 }
 
 static int waitcount = 0;
@@ -269,31 +282,34 @@ bool waitCommand(
 				int how,
 				int level )
 {
-	guard_lock reply_lock(&mutex_replystr);
+	rig_driver()->pipeline_flush();
+
+	guard_lock reply_lock(rig_reply_mutex());
 
 	int numwrite = (int)command.length();
+	ullint ustart = zusec();
 	if (nread == 0)
 		LOG_DEBUG("cmd:%3d, %s", numwrite, how == ASC ? command.c_str() : str2hex(command.data(), numwrite));
 
-	if (progStatus.xmlrpc_rig) {
-		respstr = xml_cat_string(command);
-		return respstr.length();
+	if (rig_xmlrpc()) {
+		rig_respstr() = xml_cat_string(command);
+		return rig_respstr().length();
 	}
 
-	if (progStatus.use_tcpip) {
+	if (rig_tcpip()) {
 		send_to_remote(command);
 		if (nread == 0) return 0;
 	} else {
-		if (RigSerial->IsOpen() == false) {
+		if (rig_port()->IsOpen() == false) {
 			LOG_DEBUG("cmd: %s", how == ASC ? command.c_str() : str2hex(command.data(), command.length()));
 			waitcount = 0;
 			return 0;
 		}
 
-		RigSerial->FlushBuffer();
+		rig_port()->FlushBuffer();
 //		replystr.clear();
 
-		RigSerial->WriteBuffer(command.c_str(), numwrite);
+		rig_port()->WriteBuffer(command.c_str(), numwrite);
 		if (nread == 0) {
 			waitcount = 0;
 			return 0;
@@ -303,8 +319,8 @@ bool waitCommand(
 	ullint tod_start = zmsec();
 
 // minimimum time to wait for a response
-	int timeout = (int)((nread * 2)*11000.0/RigSerial->Baud()
-		+ progStatus.use_tcpip ? progStatus.tcpip_ping_delay : 0);
+	int timeout = (int)((nread * 2)*11000.0/rig_port()->Baud()
+		+ rig_tcpip() ? progStatus.tcpip_ping_delay : 0);
 	while (timeout > 0) {
 		if (timeout > 10) MilliSleep(10);
 		else MilliSleep(timeout);
@@ -313,19 +329,20 @@ bool waitCommand(
 	}
 // additional wait for xcvr processing
 	std::string returned = "";
-	static char sztemp[100];
+	char sztemp[100];
 	int waited = 0;
 	while (waited < msec) {
 		if (readResponse())
-			returned.append(respstr);
+			returned.append(rig_respstr());
 		if (	((int)returned.length() >= nread) || 
 				(returned.find(term) != std::string::npos) ) {
 			assignReplyStr(returned);
+			stats_command(info.c_str(), zusec() - ustart, numwrite, returned.length(), false);
 			waited = zmsec() - tod_start;
 			snprintf(sztemp, sizeof(sztemp), "%s rcvd in %d msec", info.c_str(), waited);
 			showresp(level, how, sztemp, command, returned);
 			waitcount = 0;
-			RigSerial->failed(-1);
+			rig_port()->failed(-1);
 			return true;
 		}
 		waited += 10;
@@ -334,6 +351,7 @@ bool waitCommand(
 	}
 	waitcount++;
 	assignReplyStr(returned);
+	stats_command(info.c_str(), zusec() - ustart, numwrite, returned.length(), true);
 	waited = zmsec() - tod_start;
 	snprintf(sztemp, sizeof(sztemp), "%s TIMED OUT in %d ms", command.c_str(), waited);
 	showresp(ERR, how, sztemp, command, returned);
@@ -342,7 +360,7 @@ bool waitCommand(
 		snprintf(sztimeout_alert, sizeof(sztimeout_alert), 
 			"Serial i/o failure\n%s TIMED OUT in %d ms",
 			command.c_str(), waited);
-			RigSerial->failed(1);
+			rig_port()->failed(1);
 			Fl::awake(show_timeout);
 	}
 	return false;
@@ -352,7 +370,7 @@ int waitResponse(int timeout)
 {
 	int n = 0;
 
-	if (!progStatus.xmlrpc_rig && !progStatus.use_tcpip && !RigSerial->IsOpen())
+	if (!rig_xmlrpc() && !rig_tcpip() && !rig_port()->IsOpen())
 		return 0;
 
 	MilliSleep(10);
@@ -411,7 +429,7 @@ void showresp(int level, int how, std::string s, std::string tx, std::string rx)
 
 std::string to_hex(std::string fm)
 {
-	static std::string to;
+	std::string to;
 	to.clear();
 	char szHEX[8];
 	for (size_t n = 0; n < fm.length(); n++) {
@@ -424,7 +442,7 @@ std::string to_hex(std::string fm)
 
 std::string fm_hex(std::string fm)
 {
-	static std::string to;
+	std::string to;
 	to.clear();
 
 	if (fm.find("x") != std::string::npos) {
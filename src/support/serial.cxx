@@ -29,6 +29,7 @@
 #include "status.h"
 #include "trace.h"
 #include "tod_clock.h"
+#include "cat_capture.h"
 
 LOG_FILE_SOURCE(debug::LOG_RIGCONTROL);
 
@@ -45,6 +46,18 @@ bool check_hex(const void *s, size_t len)
     return false;
 }
 
+extern Cserial *RigSerial;
+extern Cserial *AuxSerial;
+extern Cserial *SepSerial;
+
+static int capture_port(Cserial *port)
+{
+	if (port == RigSerial) return CAP_CAT;
+	if (port == AuxSerial) return CAP_AUX;
+	if (port == SepSerial) return CAP_SEP;
+	return CAP_OTHER;
+}
+
 #ifndef __WIN32__
 #include <cstdio>
 #include <unistd.h>
@@ -53,6 +66,8 @@ bool check_hex(const void *s, size_t len)
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/time.h>
+#include <poll.h>
+#include <string.h>
 
 #include <memory>
 
@@ -298,13 +313,9 @@ void Cserial::setRTS(bool b)
 		return;
 	}
 
-	ioctl(fd, TIOCMGET, &state);
-	if (b == true)
-		state |= TIOCM_RTS;  // toggle high
-	else
-		state &= ~TIOCM_RTS; // toggle low
-
-	if (ioctl(fd, TIOCMSET, &state) == -1) {
+	// a single ioctl, changing only the RTS line
+	int bits = TIOCM_RTS;
+	if (ioctl(fd, b ? TIOCMBIS : TIOCMBIC, &bits) == -1) {
 		char errstr[50];
 		snprintf(errstr, sizeof(errstr), "set RTS ioctl error: %d", errno);
 		LOG_ERROR("%s", errstr);
@@ -317,12 +328,9 @@ void Cserial::setDTR(bool b)
 	if (fd < 0)
 		return;
 
-	ioctl(fd, TIOCMGET, &state);
-	if (b == true)
-		state |= TIOCM_DTR;	  // toggle high
-	else
-		state &= ~TIOCM_DTR;	 // toggle low
-	if (ioctl(fd, TIOCMSET, &state) == -1) {
+	// a single ioctl, changing only the DTR line
+	int bits = TIOCM_DTR;
+	if (ioctl(fd, b ? TIOCMBIS : TIOCMBIC, &bits) == -1) {
 		char errstr[50];
 		snprintf(errstr, sizeof(errstr), "set DTR ioctl error: %d", errno);
 		LOG_ERROR("%s", errstr);
@@ -385,10 +393,35 @@ bool  Cserial::IOselect ()
 	return true;
 }
 
+// wait up to msec for received data without reading it
+bool Cserial::InputWaiting(int msec)
+{
+	if (fd < 0) return false;
+
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+
+	int ret;
+	do {
+		ret = poll(&pfd, 1, msec);
+	} while (ret < 0 && errno == EINTR);
+
+	return (ret > 0 && (pfd.revents & POLLIN));
+}
+
+// true if buf is terminated by the std::string find
+static bool ends_with(const std::string &buf, const std::string &find)
+{
+	if (find.empty() || buf.length() < find.length()) return false;
+	return buf.compare(buf.length() - find.length(), find.length(), find) == 0;
+}
 
 ///////////////////////////////////////////////////////
-// Function name	: Cserial::ls dx
+// Function name	: Cserial::ReadBuffer
 // Description	  : Reads upto nchars from the selected port
+//                  blocks in poll() until data arrives, a terminator
+//                  is received, or the serial timeout expires
 // Return type	  : # characters received
 // Argument		 : pointer to buffer; # chars to read; std::string terminator
 ///////////////////////////////////////////////////////
@@ -402,32 +435,51 @@ int  Cserial::ReadBuffer (std::string &buf, int nchars, std::string find1, std::
 
 	bool hex = false;
 
-	fd_set rfds;
-
-	FD_ZERO (&rfds);
-	FD_SET (fd, &rfds);
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = POLLIN;
 
 	bool     timedout = false;
 
 	int      bytes = 0;
-	ullint   retval = 0,
-			 start = 0,
+	ssize_t  retval = 0;
+	ullint   start = 0,
+			 elapsed = 0,
 			 tout = progStatus.serial_timeout * 1000;
 
 	buf.clear();
 
 	start = zusec();
 
-	while ( (zusec() - start) < tout ) {
-		memset(uctemp, 0, sizeof(uctemp));
+	while ( (elapsed = zusec() - start) < tout ) {
+		int wait = (int)((tout - elapsed + 999) / 1000);
+		int ret = poll(&pfd, 1, wait);
+		if (ret < 0) {
+			if (errno == EINTR) continue;
+			snprintf(traceinfo, sizeof(traceinfo), "ReadBuffer poll(): %s", strerror(errno));
+			ser_trace(1, traceinfo);
+			break;
+		}
+		if (ret == 0)
+			break;
+		if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			ser_trace(1, "ReadBuffer: port error / hangup");
+			break;
+		}
+
+		bytes = 0;
 		ioctl( fd, FIONREAD, &bytes);
-		if (bytes) {
-			if ( (retval = read (fd, uctemp, bytes)) > 0) {
-				for (size_t nc = 0; nc < retval && nc < sizeof(uctemp); nc++) {
-					buf += uctemp[nc];
-				}
-			}
+		if (bytes <= 0) bytes = 1;
+		if (bytes > (int)sizeof(uctemp)) bytes = sizeof(uctemp);
+		retval = read (fd, uctemp, bytes);
+		if (retval < 0) {
+			if (errno == EINTR || errno == EAGAIN) continue;
+			break;
 		}
+		if (retval == 0)
+			continue;
+		buf.append((const char *)uctemp, retval);
+		cat_capture(capture_port(this), CAP_RX, (const char *)uctemp, retval);
 
 // This block only for CI-V strings
 		if (buf.length() >= 4) {
@@ -470,16 +522,10 @@ int  Cserial::ReadBuffer (std::string &buf, int nchars, std::string find1, std::
 
 		if ( buf.length() >= (size_t)nchars) break;
 
-		if ( !find1.empty() && 
-			(buf.find(find1) != std::string::npos) &&
-			(buf.find(find1) == (buf.length() - find1.length()) ) ) break;
+		if ( ends_with(buf, find1) ) break;
 
 		// This covers the Icom case of either 0xFA or 0xFD
-        if ( !find2.empty() &&
-			( buf.find(find2) != std::string::npos ) &&
-			(buf.find(find2) == (buf.length() - find2.length()) ) ) break;
-
-		MilliSleep(1);
+		if ( ends_with(buf, find2) ) break;
 	}
 
 	ullint readtime = zusec() - start;
@@ -525,8 +571,8 @@ int Cserial::WriteBuffer(const char *buff, int n)
 		return 0;
 	}
 
-	std::string sw = std::string(buff, (std::size_t) n);
 	if (progStatus.serialtrace || SERIALDEBUG) {
+		std::string sw = std::string(buff, (std::size_t) n);
 		size_t p = sw.rfind("\r\n");
 		if (p == (sw.length() - 2) ) {
 			sw.replace(p, 2, "<cr><lf>");
@@ -539,6 +585,8 @@ int Cserial::WriteBuffer(const char *buff, int n)
 
 	FlushBuffer();
 
+	cat_capture(capture_port(this), CAP_TX, buff, n);
+
 	if (progStatus.serial_write_delay) {
 		size_t ret = 0;
 		for (int i = 0; i < n; i++) {
@@ -566,7 +614,7 @@ int Cserial::WriteBuffer(const char *buff, int n)
 bool Cserial::WriteByte(char by)
 {
 	if (fd < 0) return false;
-	static char buff[2];
+	char buff[2];
 	buff[0] = by; buff[1] = 0;
 	return (write(fd, buff, 1) == 1);
 }
@@ -793,6 +841,7 @@ int  Cserial::ReadBuffer (std::string &buf, int nchars, std::string find1, std::
 	while ( (zusec() - start) < tout ) {
 		memset(uctemp, 0, sizeof(uctemp));
 		if ( (retval = ReadFile (hComm, uctemp, maxchars, &thisread, NULL)) ) {
+			cat_capture(capture_port(this), CAP_RX, (const char *)uctemp, thisread);
 			for (size_t n = 0; n < thisread && n < sizeof(uctemp); n++) {
 				buf += uctemp[n];
 				++nread;
@@ -886,6 +935,22 @@ int  Cserial::ReadBuffer (std::string &buf, int nchars, std::string find1, std::
 	return nread;
 }
 
+// wait up to msec for received data without reading it
+bool Cserial::InputWaiting(int msec)
+{
+	if (hComm == INVALID_HANDLE_VALUE) return false;
+
+	COMSTAT cs;
+	DWORD errors;
+	ullint tout = zmsec() + msec;
+	for (;;) {
+		if (ClearCommError(hComm, &errors, &cs) && cs.cbInQue > 0)
+			return true;
+		if (zmsec() >= tout) return false;
+		MilliSleep(1);
+	}
+}
+
 void Cserial::FlushBuffer()
 {
 #define TX_CLEAR 0x0004L
@@ -936,6 +1001,8 @@ int Cserial::WriteBuffer(const char *buff, int n)
 
 	FlushBuffer();
 
+	cat_capture(capture_port(this), CAP_TX, buff, n);
+
 	if (progStatus.serial_write_delay) {
 		int total = 0;
 		for (int i = 0; i < n; i++) {
@@ -61,6 +61,7 @@
 #include "socket_io.h"
 #include "socket.h"
 #include "support.h"
+#include "cat_capture.h"
 
 #ifdef WIN32
 #  include <winsock2.h>
@@ -237,6 +238,7 @@ void send_to_remote(std::string cmd_string)
 
 	try {
 		tcpip->send(cmd_string);
+		cat_capture(CAP_REMOTE, CAP_TX, cmd_string.c_str(), cmd_string.length());
 
 		LOG_WARN("send to remote: %s", cmd_string.c_str());
 
@@ -260,6 +262,7 @@ int read_from_remote(std::string &str)
 		str = rxbuffer;
 		rxbuffer.clear();
 	}
+	cat_capture(CAP_REMOTE, CAP_RX, str.c_str(), str.length());
 	char szc[200];
 	snprintf(szc, sizeof(szc), "read_from_remote() : %s", str.c_str());
 
@@ -0,0 +1,129 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <sys/time.h>
+#include <errno.h>
+
+#include "support.h"
+#include "status.h"
+#include "threads.h"
+#include "util.h"
+#include "state_snapshot.h"
+
+static RIG_SNAPSHOT snapshot;
+
+// odd while a publish is in progress
+static volatile unsigned long sequence = 0;
+
+// serializes publishers only; readers take no lock
+static pthread_mutex_t mutex_publish = PTHREAD_MUTEX_INITIALIZER;
+
+// signalled under mutex_publish when the version changes
+static pthread_cond_t version_changed = PTHREAD_COND_INITIALIZER;
+
+static bool same_vfo(const XCVR_STATE &a, const XCVR_STATE &b)
+{
+	return a.freq == b.freq && a.imode == b.imode && a.iBW == b.iBW;
+}
+
+void publish_state()
+{
+	RIG_SNAPSHOT snap;
+
+	snap.online = xcvr_online;
+	snap.A      = vfoA;
+	snap.B      = vfoB;
+	snap.inuse  = selrig ? selrig->inuse : onA;
+	snap.split  = progStatus.split;
+	snap.ptt    = PTT;
+	snap.smeter = smtrval;
+	snap.pout   = pwrval;
+	snap.swr    = swrval;
+	snap.alc    = alcval;
+
+	guard_lock lk(&mutex_publish);
+
+	snap.version = snapshot.version;
+	bool changed =
+		snap.online != snapshot.online ||
+		!same_vfo(snap.A, snapshot.A) ||
+		!same_vfo(snap.B, snapshot.B) ||
+		snap.inuse != snapshot.inuse ||
+		snap.split != snapshot.split ||
+		snap.ptt != snapshot.ptt;
+	if (changed)
+		snap.version++;
+
+	sequence++;
+	write_memory_barrier();
+	snapshot = snap;
+	write_memory_barrier();
+	sequence++;
+
+	if (changed)
+		pthread_cond_broadcast(&version_changed);
+}
+
+void read_state(RIG_SNAPSHOT &snap)
+{
+	unsigned long seq1, seq2;
+	do {
+		seq1 = sequence;
+		read_memory_barrier();
+		snap = snapshot;
+		read_memory_barrier();
+		seq2 = sequence;
+	} while (seq1 != seq2 || (seq1 & 1));
+}
+
+unsigned long state_version()
+{
+	RIG_SNAPSHOT snap;
+	read_state(snap);
+	return snap.version;
+}
+
+// Block until the version differs from 'since' or msec elapses.  Returns
+// true if the state changed; snap holds the latest state either way.
+bool wait_state(unsigned long since, RIG_SNAPSHOT &snap, int msec)
+{
+	read_state(snap);
+	if (snap.version != since || msec <= 0)
+		return snap.version != since;
+
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	struct timespec until;
+	long usec = now.tv_usec + (msec % 1000) * 1000L;
+	until.tv_sec = now.tv_sec + msec / 1000 + usec / 1000000L;
+	until.tv_nsec = (usec % 1000000L) * 1000L;
+
+	{
+		guard_lock lk(&mutex_publish);
+		while (snapshot.version == since) {
+			if (pthread_cond_timedwait(&version_changed, &mutex_publish, &until) == ETIMEDOUT)
+				break;
+		}
+	}
+
+	read_state(snap);
+	return snap.version != since;
+}
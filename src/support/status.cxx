@@ -142,6 +142,8 @@ status progStatus = {
 	1,			// poll_ptt;
 	1,			// poll_break_in;
 	1,			// int	poll_all;
+	0,			// int	poll_backoff;
+	0,			// int	poll_push;
 
 	-1,			// int  iBW_A;
 	1,			// int  imode_A;
@@ -484,6 +486,8 @@ status progStatus = {
 	false,		// bool tcitrace;
 	false,		// bool	start_stop_trace;
 	0,			// int	rpc_level;
+	false,		// bool	cat_capture;
+	16,			// int	cat_capture_size;
 
 // bands; defaults for FT857 / FT897 / Xiegu-G90
 // frequency, mode, txCTCSS, rxCTCSS, offset, offset_freq;
@@ -579,6 +583,7 @@ status progStatus = {
 	0,			// int fsk_log_nbr
 
 	0,			// int	display_voltmeter;
+	25,			// int	ui_refresh_rate;
 
 //----------------------------------------------------------------------
 // UI scheme items
@@ -1037,6 +1042,8 @@ void status::saveLastState()
 	spref.set("poll_ptt", poll_ptt);
 	spref.set("poll_break_in", poll_break_in);
 	spref.set("poll_all", poll_all);
+	spref.set("poll_backoff", poll_backoff);
+	spref.set("poll_push", poll_push);
 
 	spref.set("bw_A", iBW_A);
 	spref.set("mode_A", imode_A);
@@ -1375,6 +1382,7 @@ void status::saveLastState()
 	spref.set("ex_cmd4", cmd_on_exit4.c_str());
 
 	spref.set("display_voltmeter", display_voltmeter);
+	spref.set("ui_refresh_rate", ui_refresh_rate);
 	spref.set("fontnbr", fontnbr);
 
 	spref.set("tooltips", tooltips);
@@ -1414,6 +1422,8 @@ void status::saveLastState()
 	spref.set("tcitrace", tcitrace);
 
 	spref.set("rpc_level", rpc_level);
+	spref.set("cat_capture", cat_capture);
+	spref.set("cat_capture_size", cat_capture_size);
 
 	spref.set("f160", f160); spref.set("m160", m160);
 	spref.set("txT160", txT_160); spref.set("rxT160", rxT_160);
@@ -1703,6 +1713,8 @@ bool status::loadXcvrState(std::string xcvr)
 		spref.get("poll_ptt", poll_ptt, poll_ptt);
 		spref.get("poll_break_in", poll_break_in, poll_break_in);
 		spref.get("poll_all", poll_all, poll_all);
+		spref.get("poll_backoff", poll_backoff, poll_backoff);
+		spref.get("poll_push", poll_push, poll_push);
 
 		spref.get("bw_A", iBW_A, iBW_A);
 		spref.get("mode_A", imode_A, imode_A);
@@ -2135,6 +2147,7 @@ bool status::loadXcvrState(std::string xcvr)
 		cmd_on_exit4 = defbuffer;
 
 		spref.get("display_voltmeter", display_voltmeter, display_voltmeter);
+		spref.get("ui_refresh_rate", ui_refresh_rate, ui_refresh_rate);
 
 		i = 0;
 		if (spref.get("tooltips", i, i)) tooltips = i;
@@ -2190,6 +2203,8 @@ bool status::loadXcvrState(std::string xcvr)
 #endif
 
 		spref.get("rpc_level", rpc_level, rpc_level);
+		if (spref.get("cat_capture", i, cat_capture)) cat_capture = i;
+		spref.get("cat_capture_size", cat_capture_size, cat_capture_size);
 
 		spref.get("f160", f160, f160); spref.get("m160", m160, m160);
 		spref.get("txT160", txT_160, txT_160); spref.get("rxT160", rxT_160, rxT_160);
@@ -2626,6 +2641,8 @@ std::string status::info()
 	info << "poll_ptt           : " << poll_ptt << "\n";
 	info << "poll_break_in      : " << poll_break_in << "\n";
 	info << "poll_all           : " << poll_all << "\n";
+	info << "poll_backoff       : " << poll_backoff << "\n";
+	info << "poll_push          : " << poll_push << "\n";
 	info << "\n";
 	info << "freq_A             : " << freq_A << "\n";
 	info << "mode_A             : " << imode_A << "\n";
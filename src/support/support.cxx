@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <math.h>
 #include <fcntl.h>
 
 #include <FL/Fl_Text_Display.H>
@@ -65,6 +66,15 @@
 #include "gpio_ptt.h"
 #include "cmedia.h"
 #include "tmate2.h"
+#include "poll_scheduler.h"
+#include "state_snapshot.h"
+#include "cat_capture.h"
+#include "mem_bank.h"
+#include "cat_executor.h"
+#include "ui_refresh.h"
+#include "meter_history.h"
+#include "band_sweep.h"
+#include "radio.h"
 
 //void initTabs();
 
@@ -87,17 +97,6 @@ enum {VOL, MIC, PWR, SQL, IFSH, NOTCH, RFGAIN, NR, NB };
 
 //std::queue<VFOQUEUE> srvc_reqs;
 
-// Add alpha-tag to XCVR_STATE;
-struct ATAG_XCVR_STATE {
-	unsigned long long freq;
-	int  imode;
-	int  iBW;
-	int  src;
-	char alpha_tag[ATAGSIZE];
-};
-ATAG_XCVR_STATE oplist[LISTSIZE];
-
-int  numinlist = 0;
 std::vector<std::string> rigmodes_;
 
 Cserial *RigSerial;
@@ -292,18 +291,23 @@ void TRACED(update_vfoAorB, void *d)
 	trace(1,"update_vfoAorB()");
 	if (selrig->inuse == onB) {
 		vfoB.src = RIG;
-		vfoB.freq = selrig->get_vfoB();
+		if (!sweep_running())
+			vfoB.freq = selrig->get_vfoB();
 		vfoB.imode = selrig->get_modeB();
 		vfoB.iBW = selrig->get_bwB();
 	} else {
 		vfoA.src = RIG;
-		vfoA.freq = selrig->get_vfoA();
+		if (!sweep_running())
+			vfoA.freq = selrig->get_vfoA();
 		vfoA.imode = selrig->get_modeA();
 		vfoA.iBW = selrig->get_bwA();
 	}
 	updateUI((void*)0);
 }
 
+static void exec_movFreqA(long long freq);
+static void exec_movFreqB(long long freq);
+
 void read_vfo()
 {
 	if (xcvr_name == rig_K3.name_) {
@@ -327,29 +331,41 @@ void read_vfo()
 	if (selrig->has_get_info)
 		selrig->get_info();
 
+// a frequency the UI has queued or is sending is newer than the one read back,
+// and a band sweep moves the vfo away from the operating frequency
+	bool keepA = cat_pending(exec_movFreqA) || sweep_running();
+	bool keepB = cat_pending(exec_movFreqB) || sweep_running();
 	if (selrig->inuse == onA) { // vfo-A
 		trace(2, "vfoA active", "get vfo A");
 		freq = selrig->get_vfoA();
-		vfoA.freq = freq;
-		Fl::awake(setFreqDispA);
+		if (!keepA) {
+			vfoA.freq = freq;
+			ui_mark(UI_FREQ_A);
+		}
 		vfo = &vfoA;
 		if ( selrig->twovfos() ) {
 			trace(2, "vfoA active", "get vfo B");
 			freq = selrig->get_vfoB();
-			vfoB.freq = freq;
-			Fl::awake(setFreqDispB);
+			if (!keepB) {
+				vfoB.freq = freq;
+				ui_mark(UI_FREQ_B);
+			}
 		}
 	} else { // vfo-B
 		trace(2, "vfoB active", "get vfo B");
 		freq = selrig->get_vfoB();
-		vfoB.freq = freq;
-		Fl::awake(setFreqDispB);
+		if (!keepB) {
+			vfoB.freq = freq;
+			ui_mark(UI_FREQ_B);
+		}
 		vfo = &vfoB;
 		if ( selrig->twovfos() ) {
 			trace(2, "vfoB active", "get vfo A");
 			freq = selrig->get_vfoA();
-			vfoA.freq = freq;
-			Fl::awake(setFreqDispA);
+			if (!keepA) {
+				vfoA.freq = freq;
+				ui_mark(UI_FREQ_A);
+			}
 		}
 	}
 	Fl::awake(updateTCI);
@@ -443,7 +459,7 @@ void read_mode()
 char resp[50];
 snprintf(resp, sizeof(resp), "read: %d", nu_mode);
 rig_trace(1, resp);
-		if (nu_mode != opMODE->index()) {
+		if (nu_mode != vfo->imode) {
 			vfoA.imode = vfo->imode = nu_mode;
 			selrig->adjust_bandwidth(vfo->imode);
 			Fl::awake(set_Mode_BW_control);
@@ -464,7 +480,7 @@ rig_trace(1, resp);
 	} else {
 		rig_trace(2, "read_mode", "vfoB active");
 		nu_mode = selrig->get_modeB();
-		if (nu_mode != opMODE->index()) {
+		if (nu_mode != vfo->imode) {
 			vfoB.imode = vfo->imode = nu_mode;
 			selrig->adjust_bandwidth(vfo->imode);
 			Fl::awake(set_Mode_BW_control);
@@ -580,7 +596,8 @@ void read_smeter()
 	}
 	if (sig == -1) return;
 	smtrval = sig;
-	Fl::awake(updateSmeter);
+	meter_record(MTR_SMETER, sig);
+	ui_mark(UI_SMETER);
 }
 
 void read_voltmeter()
@@ -592,7 +609,8 @@ void read_voltmeter()
 		sig = selrig->get_voltmeter();
 	}
 	vmtrval = sig;
-	Fl::awake(updateVmeter);
+	if (sig != -1) meter_record(MTR_VOLTS, sig);
+	ui_mark(UI_VMETER);
 }
 
 int tunerval = 0;
@@ -626,7 +644,8 @@ void read_power_out()
 	}
 	if (sig < 0) sig = 0;
 	pwrval = sig;
-	Fl::awake(updateFwdPwr);
+	meter_record(MTR_POWER, (double)sig / selrig->power_scale());
+	ui_mark(UI_PWR);
 }
 
 // read swr
@@ -640,7 +659,8 @@ void read_swr()
 	}
 	if (sig < 0) sig = 0;
 	swrval = sig;
-	Fl::awake(updateSWR);
+	meter_record(MTR_SWR, sig);
+	ui_mark(UI_SWR);
 }
 
 // alc
@@ -656,7 +676,8 @@ void read_alc()
 	}
 	if (sig < 0) sig = 0;
 	alcval = sig;
-	Fl::awake(updateALC);
+	meter_record(MTR_ALC, sig);
+	ui_mark(UI_ALC);
 }
 
 // IDD
@@ -672,7 +693,8 @@ void read_idd()
 	}
 	if (sig < 0) sig = 0;
 	iddval = sig;
-	Fl::awake(updateIDD);
+	meter_record(MTR_IDD, sig);
+	ui_mark(UI_IDD);
 }
 
 // notch
@@ -1287,7 +1309,7 @@ void serviceXCVR(VFOQUEUE nuvals)
 
 	if (nuvals.change == ON || nuvals.change == OFF) { // PTT processing
 		if (selrig->ICOMmainsub && selrig->inuse == onB) {  // disallowed operation
-			Fl::awake(update_UI_PTT);
+			ui_mark(UI_PTT);
 			return;
 		}
 		PTT = (nuvals.change == ON);
@@ -1304,7 +1326,7 @@ void serviceXCVR(VFOQUEUE nuvals)
 			std::stringstream s;
 			s << "ptt returned " << get << " in " << cnt * 10 << " msec";
 			trace(1, s.str().c_str());
-			Fl::awake(update_UI_PTT);
+			ui_mark(UI_PTT);
 		}
 		return;
 	}
@@ -1430,6 +1452,8 @@ void find_bandwidth(XCVR_STATE &nuvals)
 
 void serviceA(XCVR_STATE nuvals)
 {
+	state_publisher publish;
+
 	if (nuvals.freq == 0) nuvals.freq = vfoA.freq;
 	if (nuvals.imode == -1) nuvals.imode = vfoA.imode;
 	if (nuvals.iBW == 255) nuvals.iBW = vfoA.iBW;
@@ -1450,7 +1474,7 @@ void serviceA(XCVR_STATE nuvals)
 					selrig->get_bwA();
 					selrig->set_vfoA(nuvals.freq);
 					selrig->get_vfoA();
-					Fl::awake(setFreqDispA);
+					ui_mark(UI_FREQ_A);
 					return;
 				}
 			}
@@ -1483,7 +1507,7 @@ void serviceA(XCVR_STATE nuvals)
 			selrig->selectB();
 			vfoA = nuvals;
 		}
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 		return;
 	}
 
@@ -1504,7 +1528,7 @@ void serviceA(XCVR_STATE nuvals)
 			selrig->get_vfoA();
 			vfo = &vfoA;
 			Fl::awake(set_Mode_BW_control);
-			Fl::awake(setFreqDispA);
+			ui_mark(UI_FREQ_A);
 			return;
 		}
 	}
@@ -1519,11 +1543,13 @@ void serviceA(XCVR_STATE nuvals)
 	}
 	vfo = &vfoA;
 
-	Fl::awake(setFreqDispA);
+	ui_mark(UI_FREQ_A);
 }
 
 void serviceB(XCVR_STATE nuvals)
 {
+	state_publisher publish;
+
 	if (nuvals.freq == 0) nuvals.freq = vfoB.freq;
 	if (nuvals.imode == -1) nuvals.imode = vfoB.imode;
 	if (nuvals.iBW == 255) nuvals.iBW = vfoB.iBW;
@@ -1543,7 +1569,7 @@ void serviceB(XCVR_STATE nuvals)
 					selrig->get_bwB();
 					selrig->set_vfoB(nuvals.freq);
 					selrig->get_vfoB();
-					Fl::awake(setFreqDispB);
+					ui_mark(UI_FREQ_B);
 					return;
 				}
 			}
@@ -1574,7 +1600,7 @@ void serviceB(XCVR_STATE nuvals)
 			selrig->selectA();
 			vfoB = nuvals;
 		}
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 		return;
 	}
 
@@ -1604,7 +1630,7 @@ void serviceB(XCVR_STATE nuvals)
 			selrig->set_vfoB(nuvals.freq);
 			selrig->get_vfoB();
 			Fl::awake(set_Mode_BW_control);
-			Fl::awake(setFreqDispB);
+			ui_mark(UI_FREQ_B);
 			vfo = &vfoB;
 			return;
 		}
@@ -1621,7 +1647,7 @@ void serviceB(XCVR_STATE nuvals)
 
 	vfo = &vfoB;
 
-	Fl::awake(setFreqDispB);
+	ui_mark(UI_FREQ_B);
 
 }
 
@@ -1644,57 +1670,134 @@ Check that Baud matches transceiver baud\n\n\
 Press 'Init' button."));
 }
 
-struct POLL_PAIR {
-	int *poll;
-	void (*pollfunc)();
-	std::string name;
+// Control state probes used by the scheduler to back off stable controls
+
+static long probe_tuner() { return tunerval; }
+static long probe_volume() { return progStatus.volume ^ (progStatus.volume_A << 8) ^ (progStatus.volume_B << 16); }
+static long probe_auto_notch() { return progStatus.auto_notch; }
+static long probe_notch() { return (progStatus.notch << 24) ^ progStatus.notch_val; }
+static long probe_ifshift() { return (progStatus.shift << 24) ^ progStatus.shift_val; }
+static long probe_pbt() { return (progStatus.pbt_inner << 16) ^ progStatus.pbt_outer; }
+static long probe_power() { return (long)(progStatus.power_level * 10); }
+static long probe_preamp() { return progStatus.preamp; }
+static long probe_att() { return progStatus.attenuator; }
+static long probe_mic_gain() { return progStatus.mic_gain; }
+static long probe_squelch() { return progStatus.squelch; }
+static long probe_rfgain() { return (progStatus.agc_level << 24) ^ progStatus.rfgain; }
+static long probe_split() { return progStatus.split; }
+static long probe_nr() { return (progStatus.noise_reduction << 24) ^ progStatus.noise_reduction_val; }
+static long probe_noise() { return (progStatus.noise << 24) ^ progStatus.nb_level; }
+static long probe_compression() { return (progStatus.compON << 24) ^ progStatus.compression; }
+
+// Poll tables; period is the target refresh in poll intervals, POLL_FILL
+// entries share whatever bus time is left over in each cycle.
+
+POLL_PAIR RX_poll_pairs[] = {
+	{&progStatus.poll_smeter, read_smeter, "SMETER", POLL_FAST},
+	{&progStatus.poll_frequency, read_vfo, "FREQ", POLL_FAST},
+	{&progStatus.poll_mode, read_mode, "MODE", POLL_MEDIUM},
+	{&progStatus.poll_bandwidth, read_bandwidth, "BW", POLL_MEDIUM},
+	{&progStatus.poll_mode, read_voltmeter, "voltage", POLL_FILL},
+	{&progStatus.poll_tuner, read_tuner, "tuner", POLL_FILL, probe_tuner},
+	{&progStatus.poll_volume, read_volume, "volume", POLL_FILL, probe_volume},
+	{&progStatus.poll_auto_notch, read_auto_notch, "auto notch", POLL_FILL, probe_auto_notch},
+	{&progStatus.poll_notch, read_notch, "notch", POLL_FILL, probe_notch},
+	{&progStatus.poll_ifshift, read_ifshift, "if shift", POLL_FILL, probe_ifshift},
+	{&progStatus.poll_pbt, read_pbt, "pass band tunning", POLL_FILL, probe_pbt},
+	{&progStatus.poll_power_control, read_power_control, "power", POLL_FILL, probe_power},
+	{&progStatus.poll_pre_att, read_preamp, "preamp", POLL_FILL, probe_preamp},
+	{&progStatus.poll_pre_att, read_att, "atten", POLL_FILL, probe_att},
+	{&progStatus.poll_micgain, read_mic_gain, "mic gain", POLL_FILL, probe_mic_gain},
+	{&progStatus.poll_squelch, read_squelch, "squelch", POLL_FILL, probe_squelch},
+	{&progStatus.poll_rfgain, read_rfgain, "rfgain", POLL_FILL, probe_rfgain},
+	{&progStatus.poll_split, read_split, "split", POLL_FILL, probe_split},
+	{&progStatus.poll_nr, read_nr, "noise reduction", POLL_FILL, probe_nr},
+	{&progStatus.poll_noise, read_noise, "noise", POLL_FILL, probe_noise},
+	{&progStatus.poll_compression, read_compression, "compression", POLL_FILL, probe_compression},
+	{&progStatus.poll_break_in, check_break_in, "break-in", POLL_FILL},
+	{NULL, NULL, "", 0, NULL}
 };
 
-POLL_PAIR RX_poll_group_1[] = {
-	{&progStatus.poll_smeter, read_smeter, "SMETER"},
-	{&progStatus.poll_frequency, read_vfo, "FREQ"},
-	{NULL, NULL, ""}
+POLL_PAIR TX_poll_pairs[] = {
+	{&progStatus.poll_pout, read_power_out, "pout", POLL_FAST},
+	{&progStatus.poll_swr, read_swr, "swr", POLL_FAST},
+	{&progStatus.poll_frequency, read_vfo, "FREQ", POLL_MEDIUM},
+	{&progStatus.poll_alc, read_alc, "alc", 2},
+	{&progStatus.poll_alc, read_idd, "idd", 2},
+	{&progStatus.poll_power_control, read_power_control, "power", POLL_FILL, probe_power},
+	{&progStatus.poll_mode, read_voltmeter, "voltage", POLL_FILL},
+	{&progStatus.poll_split, read_split, "split", POLL_FILL, probe_split},
+	{NULL, NULL, "", 0, NULL}
 };
 
-POLL_PAIR RX_poll_group_2[] = {
-	{&progStatus.poll_mode, read_mode, "MODE"},
-	{&progStatus.poll_bandwidth, read_bandwidth, "BW"},
-//	{&progStatus.poll_vfoAorB, read_vfoAorB, "A/B"},
-	{NULL, NULL, ""}
-};
+// The legacy loop serviced one entry from each of the three receive groups,
+// and the vfo plus one entry while transmitting, in every poll interval.
+// Keep the same bus budget.
+poll_scheduler RX_scheduler(RX_poll_pairs, 3);
+poll_scheduler TX_scheduler(TX_poll_pairs, 2);
 
-POLL_PAIR RX_poll_group_3[] = {
-	{&progStatus.poll_mode, read_voltmeter, "voltage"},
-	{&progStatus.poll_tuner, read_tuner, "tuner"},
-	{&progStatus.poll_volume, read_volume, "volume"},
-	{&progStatus.poll_auto_notch, read_auto_notch, "auto notch"},
-	{&progStatus.poll_notch, read_notch, "notch"},
-	{&progStatus.poll_ifshift, read_ifshift, "if shift"},
-	{&progStatus.poll_pbt, read_pbt, "pass band tunning"},
-	{&progStatus.poll_power_control, read_power_control, "power"},
-	{&progStatus.poll_pre_att, read_preamp, "preamp"},
-	{&progStatus.poll_pre_att, read_att, "atten"},
-	{&progStatus.poll_micgain, read_mic_gain, "mic gain"},
-	{&progStatus.poll_squelch, read_squelch, "squelch"},
-	{&progStatus.poll_rfgain, read_rfgain, "rfgain"},
-	{&progStatus.poll_split, read_split, "split"},
-	{&progStatus.poll_nr, read_nr, "noise reduction"},
-	{&progStatus.poll_noise, read_noise, "noise"},
-	{&progStatus.poll_compression, read_compression, "compression"},
-	{&progStatus.poll_break_in, check_break_in, "break-in"},
-	{NULL, NULL}
-};
+//----------------------------------------------------------------------
+// Auto information / CI-V transceive
+//
+// When enabled the serial thread waits out the poll interval watching the
+// port; an unsolicited report ends the wait so that the entry answered by
+// the report is serviced at once from the reply already received.
+//----------------------------------------------------------------------
+static rigbase *push_rig = (rigbase *)0;
+static bool push_on = false;
 
-POLL_PAIR TX_poll_pairs[] = {
-	{&progStatus.poll_power_control, read_power_control, "power"},
-	{&progStatus.poll_pout, read_power_out, "pout"},
-	{&progStatus.poll_swr, read_swr, "swr"},
-	{&progStatus.poll_alc, read_alc, "alc"},
-	{&progStatus.poll_alc, read_idd, "idd"},
-	{&progStatus.poll_mode, read_voltmeter, "voltage"},
-	{&progStatus.poll_split, read_split, "split"},
-	{NULL, NULL, ""}
-};
+static void set_push(bool on)
+{
+	selrig->push_mode(on);
+	selrig->pushing = on;
+	push_on = on;
+	RX_scheduler.set_push(on);
+	TX_scheduler.set_push(on);
+}
+
+static void check_push_mode()
+{
+	if (selrig != push_rig) {
+		push_rig = selrig;
+		push_on = false;
+	}
+	bool want = progStatus.poll_push && selrig->can_push &&
+				!progStatus.use_tcpip && !progStatus.xmlrpc_rig &&
+				RigSerial->IsOpen();
+	if (want == push_on) return;
+
+	guard_lock lk(&mutex_serial, "push mode");
+	set_push(want);
+}
+
+static void serial_idle_wait()
+{
+	if (!push_on || bypass_serial_thread_loop) {
+		MilliSleep(progStatus.serloop_timing);
+		return;
+	}
+
+	ullint end = zmsec() + progStatus.serloop_timing;
+	ullint now;
+	while ((now = zmsec()) < end) {
+// reports set aside by a command exchange are routed before waiting
+		std::vector<std::string> frames;
+		{
+			guard_lock lk(&mutex_serial, "push");
+			selrig->push_read(frames);
+		}
+		if (frames.empty()) {
+			if (!RigSerial->InputWaiting((int)(end - now))) {
+				now = zmsec();
+				if (now < end) MilliSleep(end - now);
+				break;
+			}
+			continue;
+		}
+		if (RX_scheduler.push(frames) + TX_scheduler.push(frames))
+			break;
+	}
+}
 
 static int menu1 = 0, menu2 = 1;
 static FILE *qcx_menus = (FILE *)0;
@@ -1730,15 +1833,11 @@ void read_menus()
 
 void * serial_thread_loop(void *d)
 {
-	POLL_PAIR *rx_poll_group_1 = &RX_poll_group_1[0];
-	POLL_PAIR *rx_poll_group_2 = &RX_poll_group_2[0];
-	POLL_PAIR *rx_poll_group_3 = &RX_poll_group_3[0];
-	POLL_PAIR *tx_polling = &TX_poll_pairs[0];
 	bool isRX = false;
 
 	for(;;) {
 
-		MilliSleep(progStatus.serloop_timing);
+		serial_idle_wait();
 
 		if (!run_serial_thread) {
 			break;
@@ -1748,6 +1847,8 @@ void * serial_thread_loop(void *d)
 			goto serial_bypass_loop;
 		}
 
+		check_push_mode();
+
 		if (RigSerial->failed() >= MAX_FAILURES) {
 			Fl::awake(serial_failed);
 		}
@@ -1764,68 +1865,23 @@ void * serial_thread_loop(void *d)
 			if (isRX) {
 				isRX = false;
 				smtrval = 0;
-				Fl::awake(update_UI_PTT);
-				Fl::awake(updateSmeter);
-			}
-
-			if (progStatus.poll_frequency) {
-				guard_lock lk(&mutex_serial, "3");
-				read_vfo();
+				TX_scheduler.reset();
+				ui_mark(UI_PTT);
+				ui_mark(UI_SMETER);
 			}
 
-			if ( tx_polling->poll != NULL && *(tx_polling->poll) ) {
-				guard_lock lk(&mutex_serial, "4");
-				(tx_polling->pollfunc)();
-			}
-			if ((++tx_polling)->poll == NULL)
-				tx_polling = &TX_poll_pairs[0];
+			TX_scheduler.run_cycle();
 
 		} else {
 
 			if (!isRX) {
 				isRX = true;
-				Fl::awake(update_UI_PTT);
-				Fl::awake(zeroXmtMeters, 0);
+				RX_scheduler.reset();
+				ui_mark(UI_PTT);
+				ui_mark(UI_XMT_ZERO);
 			}
 
-			while ( rx_poll_group_1->poll != NULL ) {
-				if ( *(rx_poll_group_1->poll) ) {
-					guard_lock lk(&mutex_serial, "5");
-					(rx_poll_group_1->pollfunc)();
-					++rx_poll_group_1;
-					break;
-				}
-				MilliSleep(1);
-				++rx_poll_group_1;
-			}
-			if ((rx_poll_group_1)->poll == NULL)
-				rx_poll_group_1 = &RX_poll_group_1[0];
-
-			while ( rx_poll_group_2->poll != NULL ) {
-				if ( *(rx_poll_group_2->poll) ) {
-					guard_lock lk(&mutex_serial, "6");
-					(rx_poll_group_2->pollfunc)();
-					++rx_poll_group_2;
-					break;
-				}
-				MilliSleep(1);
-				++rx_poll_group_2;
-			}
-			if ((rx_poll_group_2)->poll == NULL)
-				rx_poll_group_2 = &RX_poll_group_2[0];
-
-			while ( rx_poll_group_3->poll != NULL ) {
-				if ( *(rx_poll_group_3->poll) ) {
-					guard_lock lk(&mutex_serial, "7");
-					(rx_poll_group_3->pollfunc)();
-					++rx_poll_group_3;
-					break;
-				}
-				MilliSleep(1);
-				++rx_poll_group_3;
-			}
-			if ((rx_poll_group_3)->poll == NULL)
-				rx_poll_group_3 = &RX_poll_group_3[0];
+			RX_scheduler.run_cycle();
 
 			if (menu1 < 9  && selrig->name_ == rig_QCXP.name_) {
 				guard_lock lk(&mutex_serial, "8");
@@ -1833,7 +1889,8 @@ void * serial_thread_loop(void *d)
 			}
 
 		}
-serial_bypass_loop: ;
+serial_bypass_loop:
+		publish_state();
 	}
 	return NULL;
 
@@ -1841,26 +1898,36 @@ serial_bypass_loop: ;
 
 //=============================================================================
 
-void setBW()
+static void exec_setBW(long long bw)
 {
 	guard_lock serlock( &mutex_serial );
 	if (selrig->inuse == onB) {
-		vfo->iBW = vfoB.iBW = opBW->index();
+		vfo->iBW = vfoB.iBW = bw;
 		selrig->set_bwB(vfo->iBW);
 	} else {
-		vfo->iBW = vfoA.iBW = opBW->index();
+		vfo->iBW = vfoA.iBW = bw;
 		selrig->set_bwA(vfo->iBW);
 	}
 }
 
-void setDSP()
+void setBW()
+{
+	cat_post(exec_setBW, opBW->index());
+}
+
+static void exec_setDSP(long long bw)
 {
 	XCVR_STATE fm = *vfo;
 	fm.src = UI;
-	fm.iBW = ((opDSP_hi->index() << 8) | 0x8000) | (opDSP_lo->index() & 0xFF) ;
+	fm.iBW = bw;
 	serviceXCVR( VFOQUEUE((selrig->inuse == onB ? vB : vA), fm) );
 }
 
+void setDSP()
+{
+	cat_post(exec_setDSP, ((opDSP_hi->index() << 8) | 0x8000) | (opDSP_lo->index() & 0xFF));
+}
+
 void selectDSP()
 {
 	if (btnDSP->label()[0] == selrig->SL_label[0]) {
@@ -1878,16 +1945,29 @@ void selectDSP()
 	}
 }
 
-void selectFILT()
+static const char *filt_label = "";
+
+static void show_FILT(void *)
 {
-	guard_lock lock(&mutex_serial, "9");
-	btnFILT->label(selrig->nextFILT());
+	btnFILT->label(filt_label);
 	btnFILT->redraw_label();
+	setBWControl(NULL);
+}
+
+static void exec_selectFILT(long long)
+{
+	guard_lock lock(&mutex_serial, "9");
+	filt_label = selrig->nextFILT();
 	if (selrig->inuse == onB)
 		vfoB.iBW = vfo->iBW = selrig->get_bwB();
 	else
 		vfoA.iBW = vfo->iBW = selrig->get_bwA();
-	setBWControl(NULL);
+	Fl::awake(show_FILT);
+}
+
+void selectFILT()
+{
+	cat_post(exec_selectFILT, 0, CAT_QUEUE);
 }
 
 void selectCENTER()
@@ -2176,120 +2256,46 @@ void TRACED ( updateBandwidthControl, void *d )
 //	}
 }
 
-void setMode()
+static void exec_setMode(long long imode)
 {
 	guard_lock serlock( &mutex_serial );
 	if (selrig->inuse == onB) {
-		vfo->imode = vfoB.imode = opMODE->index();
+		vfo->imode = vfoB.imode = imode;
 		selrig->set_modeB(vfo->imode);
 		vfo->iBW = vfoB.iBW = selrig->def_bandwidth(vfo->imode);
 		selrig->set_bwB(vfo->iBW);
 	} else {
-		vfo->imode = vfoA.imode = opMODE->index();
+		vfo->imode = vfoA.imode = imode;
 		selrig->set_modeA(vfo->imode);
 		vfo->iBW = vfoA.iBW = selrig->def_bandwidth(vfo->imode);
 		selrig->set_bwA(vfo->iBW);
 	}
-	set_Mode_BW_control(NULL);
+	Fl::awake(set_Mode_BW_control);
 }
 
-void sortList() {
-	if (numinlist < 2) return;
-	bool swap = false;
-	int comp = 0;
-	ATAG_XCVR_STATE temp, *A, *B;
-	for (int i = 0; i < numinlist - 1; i++) {
-		A = &oplist[i];
-		for (int j = i + 1; j < numinlist; j++) {
-			B = &oplist[j];
-			swap = false;
-			if (progStatus.mem_sortby == "FREQ") {
-				if (A->freq > B->freq) swap = true;
-				else if (A->freq == B->freq) {
-					if (A->imode > B->imode) swap = true;
-					else if (A->imode == B->imode) {
-						if (A->iBW > B->iBW) swap = true;
-						else {
-							comp = strcasecmp(A->alpha_tag, B->alpha_tag);
-							if (comp > 0) swap = true;
-						}
-					}
-				}
-			} else if (progStatus.mem_sortby == "BW") {
-				if (A->iBW > B->iBW) swap = true;
-				else if (A->iBW == B->iBW) {
-					if (A->freq > B->freq) swap = true;
-					else if (A->freq == B->freq) {
-						if (A->imode > B->imode) swap = true;
-						else if (A->imode == B->imode) {
-							comp = strcasecmp(A->alpha_tag, B->alpha_tag);
-							if (comp > 0) swap = true;
-						}
-					}
-				}
-			} else if (progStatus.mem_sortby == "MODE") {
-				if (A->imode > B->imode) swap = true;
-				else if (A->imode == B->imode) {
-					if (A->freq > B->freq) swap = true;
-					else if (A->freq == B->freq) {
-						if (A->iBW > B->iBW) swap = true;
-						else if (A->iBW == B->iBW) {
-							comp = strcasecmp(A->alpha_tag, B->alpha_tag);
-							if (comp > 0) swap = true;
-						}
-					}
-				}
-			} else {
-				comp = strcasecmp(A->alpha_tag, B->alpha_tag);
-				if (comp > 0) swap = true;
-				else if (comp == 0) {
-					if (A->freq > B->freq) swap = true;
-					else if (A->freq == B->freq) {
-					if (A->imode > B->imode) swap = true;
-						else if (A->imode == B->imode) {
-							if (A->iBW > B->imode) swap = true;
-						}
-					}
-				}
-			}
-			if (swap) {
-				temp = oplist[i];
-				oplist[i] = oplist[j];
-				oplist[j] = temp;
-			}
-		}
-	}
+void setMode()
+{
+	cat_post(exec_setMode, opMODE->index(), CAT_QUEUE);
 }
 
-void clearList() {
-	if (!numinlist) return;
-	for (int i = 0; i < LISTSIZE; i++) {
-		oplist[i].freq = 0;
-		oplist[i].imode = USB;
-		oplist[i].iBW = 0;
-		memset(oplist[i].alpha_tag, 0, ATAGSIZE);
-	}
-	FreqSelect->clear();
-	numinlist = 0;
-	inAlphaTag->value("");
+// memory list sort order from the column header
+static int mem_sort_column()
+{
+	if (progStatus.mem_sortby == "FREQ") return MEM_BANK::BY_FREQ;
+	if (progStatus.mem_sortby == "BW")   return MEM_BANK::BY_BW;
+	if (progStatus.mem_sortby == "MODE") return MEM_BANK::BY_MODE;
+	return MEM_BANK::BY_TAG;
 }
 
-void updateSelect() {
+// FreqSelect browser line of a memory
+static std::string memory_line(const MEMORY &m)
+{
+	std::string atag = m.tag;
+	for (size_t i = 0; i < atag.length(); i++)
+		if (atag[i] == '\n') atag[i] = ' ';
+
 	char szline[1000];
-	char szatag[ATAGSIZE];
-	int i;
-	FreqSelect->clear();
-	if (!numinlist) return;
-	sortList();
-
-	for (int n = 0; n < numinlist; n++) {
-		memset(szline, 0, sizeof(szline));
-		memset(szatag, 0, sizeof(szatag));
-		for (i = 0; i < ATAGSIZE; i++) {
-			szatag[i] = oplist[n].alpha_tag[i];
-			if (szatag[i] == '\n') szatag[i] = ' ';
-		}
-		snprintf(szline, sizeof(szline),
+	snprintf(szline, sizeof(szline),
 "@F%d@S%d@r%.3f\t\
 @F%d@S%d@.|\t\
 @F%d@S%d@r%s\t\
@@ -2297,27 +2303,44 @@ void updateSelect() {
 @F%d@S%d@r%s\t\
 @F%d@S%d@.|\t\
 @F%d@S%d@.%s",
-			progStatus.memfontnbr, progStatus.memfontsize, oplist[n].freq / 1000.0,
-			progStatus.memfontnbr, progStatus.memfontsize, 
-			progStatus.memfontnbr, progStatus.memfontsize, selrig->get_bwname_(oplist[n].iBW, oplist[n].imode),
-			progStatus.memfontnbr, progStatus.memfontsize, 
-			progStatus.memfontnbr, progStatus.memfontsize, selrig->get_modename_(oplist[n].imode),
-			progStatus.memfontnbr, progStatus.memfontsize, 
-			progStatus.memfontnbr, progStatus.memfontsize, szatag );
+		progStatus.memfontnbr, progStatus.memfontsize, m.freq / 1000.0,
+		progStatus.memfontnbr, progStatus.memfontsize, 
+		progStatus.memfontnbr, progStatus.memfontsize, selrig->get_bwname_(m.iBW, m.imode),
+		progStatus.memfontnbr, progStatus.memfontsize, 
+		progStatus.memfontnbr, progStatus.memfontsize, selrig->get_modename_(m.imode),
+		progStatus.memfontnbr, progStatus.memfontsize, 
+		progStatus.memfontnbr, progStatus.memfontsize, atag.c_str() );
+	return szline;
+}
+
+// show the tag of the memory on a FreqSelect line
+static void show_alpha_tag(int line)
+{
+	MEMORY m;
+	if (mem_bank.get(mem_bank.id(line), m))
+		inAlphaTag->value(m.tag.c_str());
+	else
+		inAlphaTag->value("");
+}
 
-		FreqSelect->add (szline);
-	}
+void clearList() {
+	mem_bank.clear();
 	inAlphaTag->value("");
 }
 
-void addtoList(unsigned long long val, int imode, int iBW) {
-	if (numinlist < LISTSIZE) {
-		oplist[numinlist].imode = imode;
-		oplist[numinlist].freq = val;
-		oplist[numinlist].iBW = iBW;
-		memset(oplist[numinlist].alpha_tag, 0, ATAGSIZE);
-		numinlist++;
-	}
+// rebuild the browser, after a change of sort order or font
+void updateSelect() {
+	mem_bank.sort(mem_sort_column());
+	inAlphaTag->value("");
+}
+
+void memory_filter() {
+	mem_bank.filter(inMemFilter->value());
+	inAlphaTag->value("");
+}
+
+int addtoList(unsigned long long val, int imode, int iBW) {
+	return mem_bank.add(MEMORY(val, imode, iBW));
 }
 
 void readFile() {
@@ -2326,23 +2349,19 @@ void readFile() {
 		fl_message ("Could not open %s", defFileName.c_str());
 		return;
 	}
-	clearList();
-	int i = 0, mode, bw;
+	std::vector<MEMORY> list;
+	int mode, bw;
 	unsigned long long freq;
 	while (!iList.eof()) {
 		freq = 0ULL; mode = -1;
 		iList >> freq >> mode >> bw;
-		if (freq && (mode > -1)) {
-			oplist[i].freq = freq;
-			oplist[i].imode = mode;
-			oplist[i].iBW = (bw == -1 ? 0 : bw);
-			memset(oplist[i].alpha_tag, 0, ATAGSIZE);
-			i++;
-		}
+		if (freq && (mode > -1))
+			list.push_back(MEMORY(freq, mode, (bw == -1 ? 0 : bw)));
 	}
 	iList.close();
-	numinlist = i;
-	updateSelect();
+	mem_bank.clear();
+	mem_bank.add(list);
+	inAlphaTag->value("");
 }
 
 void readTagFile() {
@@ -2351,35 +2370,30 @@ void readTagFile() {
 		fl_message ("Could not open %s", defFileName.c_str());
 		return;
 	}
-	clearList();
-	int i = 0, mode, bw;
+	std::vector<MEMORY> list;
+	int mode, bw;
 	unsigned long long freq;
 	std::string atag;
-	char ca[ATAGSIZE + 60];
 	while (!iList.eof()) {
 		freq = 0ULL; mode = -1;
 		atag.clear();
-		memset(ca, 0, sizeof(ca));
 		iList >> freq >> mode >> bw;
-		iList.getline(ca, sizeof(ca) - 1);
-		atag = ca;
+		std::getline(iList, atag);
 		if (freq && (mode > -1)) {
-			oplist[i].freq = freq;
-			oplist[i].imode = mode;
-			oplist[i].iBW = (bw == -1 ? 0 : bw);
 // trim leading, trailing spaces and double quotes
-			atag = lt_trim(atag);
-			snprintf(oplist[i].alpha_tag, ATAGSIZE, "%s", atag.c_str());
-			i++;
+			list.push_back(MEMORY(freq, mode, (bw == -1 ? 0 : bw), lt_trim(atag)));
 		}
 	}
 	iList.close();
-	numinlist = i;
-	updateSelect();
+	mem_bank.clear();
+	mem_bank.add(list);
+	inAlphaTag->value("");
 }
 
 void buildlist() {
 	std::string tmpFN, orgFN;
+	mem_bank.sort(mem_sort_column());
+	mem_bank.attach(FreqSelect, memory_line);
 // check for new Memory-Alpha-Tag file
 	defFileName = RigHomeDir;
 	defFileName.append(selrig->name_);
@@ -2408,32 +2422,44 @@ void buildlist() {
 
 // flrig front panel changed
 
-void movFreqA(Fl_Widget *, void *) {
+// each wheel or key step posts the display value; only the newest one
+// waiting is sent
+static void exec_movFreqA(long long freq)
+{
 	guard_lock serial(&mutex_serial, "10");
 	if (!selrig->can_change_alt_vfo  && selrig->inuse == onB) {
 		selrig->selectA();
-		vfoA.freq = FreqDispA->value();
+		vfoA.freq = freq;
 		selrig->set_vfoA(vfoA.freq);
 		selrig->selectB();
 	} else {
-		vfoA.freq = FreqDispA->value();
+		vfoA.freq = freq;
 		selrig->set_vfoA(vfoA.freq);
 	}
 }
 
-void movFreqB(Fl_Widget *, void *) {
+void movFreqA(Fl_Widget *, void *) {
+	cat_post(exec_movFreqA, FreqDispA->value());
+}
+
+static void exec_movFreqB(long long freq)
+{
 	guard_lock serial(&mutex_serial, "11");
 	if (!selrig->can_change_alt_vfo  && selrig->inuse == onA) {
 		selrig->selectB();
-		vfoB.freq = FreqDispB->value();
+		vfoB.freq = freq;
 		selrig->set_vfoB(vfoB.freq);
 		selrig->selectA();
 	} else {
-		vfoB.freq = FreqDispB->value();
+		vfoB.freq = freq;
 		selrig->set_vfoB(vfoB.freq);
 	}
 }
 
+void movFreqB(Fl_Widget *, void *) {
+	cat_post(exec_movFreqB, FreqDispB->value());
+}
+
 void execute_swapAB()
 {
 	if (selrig->canswap()) {
@@ -2532,6 +2558,21 @@ void execute_swapAB()
 	Fl::awake(updateUI);
 }
 
+// A/B select, split and the swap / copy buttons, vfo state as it is
+// when the command runs
+static void exec_serviceXCVR(long long change)
+{
+	switch (change) {
+		case sA: serviceXCVR(VFOQUEUE(sA, vfoA)); break;
+		case sB: serviceXCVR(VFOQUEUE(sB, vfoB)); break;
+		default: {
+			VFOQUEUE xcvr;
+			xcvr.change = change;
+			serviceXCVR(xcvr);
+		}
+	}
+}
+
 void cbAswapB()
 {
 	VFOQUEUE xcvr;
@@ -2549,7 +2590,7 @@ void cbAswapB()
 			xcvr.change = SWAP;
 			trace(1, "cb SWAP");
 		}
-		serviceXCVR(xcvr);
+		cat_post(exec_serviceXCVR, xcvr.change, CAT_QUEUE);
 	}
 }
 
@@ -2677,23 +2718,20 @@ void highlight_vfo(void *d)
 void cb_set_split(int val)
 {
 	progStatus.split = val;
-	VFOQUEUE xcvr_split;
-	if (val) xcvr_split.change = sON;
-	else       xcvr_split.change = sOFF;
-	serviceXCVR(xcvr_split);
+	cat_post(exec_serviceXCVR, (val ? sON : sOFF), CAT_QUEUE);
 	trace(1, (val ? "cb_set_split(ON)" : "cb_set_split(OFF)"));
 }
 
 void cb_selectA()
 {
-	serviceXCVR(VFOQUEUE(sA, vfoA));
+	cat_post(exec_serviceXCVR, sA, CAT_QUEUE);
 	xml_trace(2, "cb_selectA() ", printXCVR_STATE(vfoA).c_str());
 	return;
 }
 
 void cb_selectB()
 {
-	serviceXCVR(VFOQUEUE(sB, vfoB));
+	cat_post(exec_serviceXCVR, sB, CAT_QUEUE);
 	xml_trace(2, "cb_selectB() ", printXCVR_STATE(vfoB).c_str());
 	return;
 }
@@ -2706,14 +2744,15 @@ void setUpper()
 {
 }
 
-void selectFreq() {
-	int n = FreqSelect->value(); // This is the number of the selected line; not the line's value.
-	if (!n) return;
+static void exec_selectFreq(long long id)
+{
+	MEMORY m;
+	if (!mem_bank.get(id, m)) return;
 
 	XCVR_STATE fm;
-	fm.freq  = oplist[n-1].freq;
-	fm.imode = oplist[n-1].imode;
-	fm.iBW   = oplist[n-1].iBW;
+	fm.freq  = m.freq;
+	fm.imode = m.imode;
+	fm.iBW   = m.iBW;
 	fm.src   = UI;
 
 	guard_lock serial(&mutex_serial, "selectFreq");
@@ -2721,7 +2760,7 @@ void selectFreq() {
 
 		selrig->set_vfoB(fm.freq);
 		vfoB.freq = fm.freq;
-		Fl::awake(setFreqDispB);
+		ui_mark(UI_FREQ_B);
 
 		vfo->imode = vfoB.imode = fm.imode;
 		selrig->set_modeB(fm.imode);
@@ -2734,7 +2773,7 @@ void selectFreq() {
 
 		selrig->set_vfoA(fm.freq);
 		vfoA.freq = fm.freq;
-		Fl::awake(setFreqDispA);
+		ui_mark(UI_FREQ_A);
 
 		vfo->imode = vfoA.imode = fm.imode;
 		selrig->set_modeA(fm.imode);
@@ -2747,6 +2786,14 @@ void selectFreq() {
 
 }
 
+void selectFreq() {
+	int n = FreqSelect->value(); // This is the number of the selected line; not the line's value.
+	if (!n) return;
+	int id = mem_bank.id(n);
+	if (id < 0) return;
+	cat_post(exec_selectFreq, id);
+}
+
 #include <FL/names.h>
 void select_and_close()
 {
@@ -2759,22 +2806,21 @@ void select_and_close()
 		 btn == FL_RIGHT_MOUSE ||
 		 key == FL_Enter ||
 		 key == FL_Left) {
-		inAlphaTag->value(oplist[FreqSelect->value() - 1].alpha_tag);
+		show_alpha_tag(FreqSelect->value());
 		selectFreq();
 		Fl::focus(FreqSelect);
 		return;
 	}
 
 	if (btn == FL_LEFT_MOUSE || key == FL_Up || key == FL_Down) {
-		inAlphaTag->value(oplist[FreqSelect->value() - 1].alpha_tag);
+		show_alpha_tag(FreqSelect->value());
 		Fl::focus(FreqSelect);
 		return;
 	}
 
 	if (key == FL_Right) {
 		addFreq();
-		FreqSelect->select(1, 1);
-		inAlphaTag->value(oplist[0].alpha_tag);
+		show_alpha_tag(FreqSelect->value());
 		Fl::focus(FreqSelect);
 		return;
 	}
@@ -2782,27 +2828,17 @@ void select_and_close()
 	if (key == FL_Delete) {
 		long n = FreqSelect->value();
 		delFreq();
-		FreqSelect->select(n, 1);
-		inAlphaTag->value(oplist[n-1].alpha_tag);
+		if (n > FreqSelect->size()) n = FreqSelect->size();
+		if (n > 0) FreqSelect->select(n, 1);
+		show_alpha_tag(n);
 		Fl::focus(FreqSelect);
 		return;
 	}
 }
 
 void delFreq() {
-	if (FreqSelect->value()) {
-		long n = FreqSelect->value() - 1;
-		for (int i = n; i < numinlist; i ++)
-			oplist[i] = oplist[i+1];
-		if (numinlist) {
-			oplist[numinlist - 1].imode = USB;
-			oplist[numinlist - 1].freq = 0;
-			oplist[numinlist - 1].iBW = 0;
-			memset(oplist[numinlist - 1].alpha_tag, 0, ATAGSIZE);
-			numinlist--;
-		}
-		updateSelect();
-	}
+	if (FreqSelect->value())
+		mem_bank.remove(mem_bank.id(FreqSelect->value()));
 }
 
 void addFreq() {
@@ -2817,15 +2853,10 @@ void addFreq() {
 			bw = opBW_B->index();
 		else
 			bw = opBW->index();
-		for (int n = 0; n < numinlist; n++)
-			if (freq == oplist[n].freq && mode == oplist[n].imode) {
-				oplist[n].iBW = bw;
-				updateSelect();	// update list
-				return;
-			}
-		addtoList(freq, mode, bw);
-		updateSelect();
-		FreqDispB->visual_beep();
+		bool found = mem_bank.find(freq, mode) >= 0;
+		int line = mem_bank.line(addtoList(freq, mode, bw));
+		if (line) FreqSelect->select(line);
+		if (!found) FreqDispB->visual_beep();
 	} else {
 		unsigned long long freq = FreqDispA->value();
 		if (!freq) return;
@@ -2837,60 +2868,74 @@ void addFreq() {
 			bw = opBW_A->index();
 		else
 			bw = opBW->index();
-		for (int n = 0; n < numinlist; n++)
-			if (freq == oplist[n].freq && mode == oplist[n].imode) {
-				oplist[n].iBW = bw;
-				updateSelect();	// update list
-				return;
-			}
-		addtoList(freq, mode, bw);
-		updateSelect();
-		FreqDispA->visual_beep();
+		bool found = mem_bank.find(freq, mode) >= 0;
+		int line = mem_bank.line(addtoList(freq, mode, bw));
+		if (line) FreqSelect->select(line);
+		if (!found) FreqDispA->visual_beep();
 		}
 }
 
+static void exec_cbRIT(long long val)
+{
+	guard_lock serial_lock(&mutex_serial, "13");
+	selrig->setRit((int)val);
+}
+
 void cbRIT()
 {
 	trace(1, "cbRIT()");
-	if (selrig->has_rit  && cntRIT) {
-		guard_lock serial_lock(&mutex_serial, "13");
-		selrig->setRit((int)cntRIT->value());
-	}
+	if (selrig->has_rit  && cntRIT)
+		cat_post(exec_cbRIT, (int)cntRIT->value());
+}
+
+static void exec_cbXIT(long long val)
+{
+	guard_lock serial_lock(&mutex_serial, "14");
+	selrig->setXit((int)val);
 }
 
 void cbXIT()
 {
 	trace(1, "cbXIT()");
-	guard_lock serial_lock(&mutex_serial, "14");
-	selrig->setXit((int)cntXIT->value());
+	cat_post(exec_cbXIT, (int)cntXIT->value());
+}
+
+static void exec_cbBFO(long long val)
+{
+	guard_lock serial_lock(&mutex_serial, "15");
+	selrig->setBfo((int)val);
 }
 
 void cbBFO()
 {
 	if (selrig->has_bfo) {
 		trace(1, "cbBFO()");
-		guard_lock serial_lock(&mutex_serial, "15");
-		selrig->setBfo((int)cntBFO->value());
+		cat_post(exec_cbBFO, (int)cntBFO->value());
 	}
 }
 
-void cbAttenuator()
+static void show_attenuator(void *)
 {
-	trace(1, "cbAttenuator()");
-
-	{
-		guard_lock serial_lock(&mutex_serial, "16");
-		selrig->set_attenuator ( progStatus.attenuator = selrig->next_attenuator() );
-
-		if (xcvr_name == rig_K4.name_)
-			selrig->get_attenuator();
-	}
 	btnAttenuator->value( progStatus.attenuator > 0 ? 1 : 0);
 	btnAttenuator->label( selrig->att_label() );
 	btnAttenuator->redraw_label();
 	btnAttenuator->redraw();
+}
 
-	return;
+static void exec_cbAttenuator(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "16");
+	selrig->set_attenuator ( progStatus.attenuator = selrig->next_attenuator() );
+
+	if (xcvr_name == rig_K4.name_)
+		selrig->get_attenuator();
+	Fl::awake(show_attenuator);
+}
+
+void cbAttenuator()
+{
+	trace(1, "cbAttenuator()");
+	cat_post(exec_cbAttenuator, 0, CAT_QUEUE);
 }
 
 void setAttControl(void *d)
@@ -2899,6 +2944,23 @@ void setAttControl(void *d)
 	btnAttenuator->value(val);
 }
 
+static void show_preamp(void *)
+{
+	btnPreamp->value( progStatus.preamp > 0 ? 1 : 0);
+	btnPreamp->label( selrig->pre_label() );
+	btnPreamp->redraw_label();
+	btnPreamp->redraw();
+}
+
+static void exec_cbPreamp(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "17");
+	selrig->set_preamp ( progStatus.preamp = selrig->next_preamp() );
+	if (xcvr_name == rig_K4.name_)
+		selrig->get_preamp();
+	Fl::awake(show_preamp);
+}
+
 void cbPreamp()
 {
 	trace(1, "cbPreamp()");
@@ -2908,19 +2970,7 @@ void cbPreamp()
 		return;
 	}
 
-	{
-		guard_lock serial_lock(&mutex_serial, "17");
-		selrig->set_preamp ( progStatus.preamp = selrig->next_preamp() );
-		if (xcvr_name == rig_K4.name_)
-			selrig->get_preamp();
-	}
-
-	btnPreamp->value( progStatus.preamp > 0 ? 1 : 0);
-	btnPreamp->label( selrig->pre_label() );
-	btnPreamp->redraw_label();
-	btnPreamp->redraw();
-
-	return;
+	cat_post(exec_cbPreamp, 0, CAT_QUEUE);
 }
 
 void setPreampControl(void *d)
@@ -2929,22 +2979,24 @@ void setPreampControl(void *d)
 	btnPreamp->value(val);
 }
 
-void cbAN()
+static void exec_cbAN(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "18");
-	trace(1, "cbAN()");
-	progStatus.auto_notch = btnAutoNotch->value();
 	selrig->set_auto_notch(progStatus.auto_notch);
 }
 
-void cbbtnNotch()
+void cbAN()
 {
-	if (!selrig->has_notch_control) return;
+	trace(1, "cbAN()");
+	progStatus.auto_notch = btnAutoNotch->value();
+	cat_post(exec_cbAN);
+}
 
+static void exec_cbbtnNotch(long long)
+{
 	int val = 0, cnt = 0;
 	{
 		guard_lock serial_lock(&mutex_serial, "19");
-		progStatus.notch = btnNotch->value();
 		selrig->set_notch(progStatus.notch, progStatus.notch_val);
 	}
 
@@ -2956,6 +3008,19 @@ void cbbtnNotch()
 	}
 }
 
+void cbbtnNotch()
+{
+	if (!selrig->has_notch_control) return;
+	progStatus.notch = btnNotch->value();
+	cat_post(exec_cbbtnNotch);
+}
+
+static void exec_setNotch(long long)
+{
+	guard_lock lock( &mutex_serial, "20");
+	selrig->set_notch(progStatus.notch, progStatus.notch_val);
+}
+
 void setNotch()
 {
 	if (!selrig->has_notch_control) return;
@@ -2965,15 +3030,13 @@ void setNotch()
 	int ev = Fl::event();
 	if (ev == FL_LEAVE || ev == FL_ENTER) return;
 
-	guard_lock lock( &mutex_serial, "20");
-
 	if (sldrNOTCH) {
 		progStatus.notch_val = sldrNOTCH->value();
 	} else {
 		progStatus.notch_val = spnrNOTCH->value();
 	}
 
-	selrig->set_notch(progStatus.notch, progStatus.notch_val);
+	cat_post(exec_setNotch);
 }
 
 // called from xml_io thread
@@ -3030,6 +3093,18 @@ void setIFshiftControl(void *d)
 	btnIFsh->value( val != selrig->if_shift_mid );
 }
 
+static void exec_setIFshift(long long)
+{
+	guard_lock lock(&mutex_serial, "21");
+	if (xcvr_name == rig_TS990.name_) {
+		if (progStatus.shift)
+			selrig->set_monitor(1);
+		else
+			selrig->set_monitor(0);
+	}
+	selrig->set_if_shift(progStatus.shift_val);
+}
+
 void setIFshift()
 {
 	trace(1, "setIFshift()");
@@ -3053,31 +3128,15 @@ void setIFshift()
 	}
 	progStatus.shift_val = set;
 
-
-	guard_lock lock(&mutex_serial, "21");
-	if (xcvr_name == rig_TS990.name_) {
-		if (progStatus.shift)
-			selrig->set_monitor(1);
-		else
-			selrig->set_monitor(0);
-	}
-	selrig->set_if_shift(progStatus.shift_val);
+	cat_post(exec_setIFshift);
 }
 
-void cbIFsh()
+// arg is set * 2 + btn
+static void exec_cbIFsh(long long arg)
 {
 	guard_lock serial_lock(&mutex_serial, "22");
-	trace(1, "setIFsh()");
 
-	int btn, set, cnt = 0;
-	if (sldrIFSHIFT) {
-		set = sldrIFSHIFT->value();
-		btn = btnIFsh->value();
-	} else {
-		set = spnrIFSHIFT->value();
-		btn = btnIFsh->value();
-	}
-	if (btn == 0) set = 0;
+	int btn = (int)(arg & 1), set = (int)((arg - btn) / 2), cnt = 0;
 
 	selrig->set_if_shift(set);
 	MilliSleep(50);
@@ -3090,15 +3149,48 @@ void cbIFsh()
 	}
 }
 
-void setLOCK()
+void cbIFsh()
+{
+	trace(1, "setIFsh()");
+
+	int btn, set;
+	if (sldrIFSHIFT) {
+		set = sldrIFSHIFT->value();
+		btn = btnIFsh->value();
+	} else {
+		set = spnrIFSHIFT->value();
+		btn = btnIFsh->value();
+	}
+	if (btn == 0) set = 0;
+
+	cat_post(exec_cbIFsh, set * 2LL + (btn ? 1 : 0));
+}
+
+static void exec_setLOCK(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "23");
+	selrig->set_pbt_outer(progStatus.pbt_outer);
+}
+
+void setLOCK()
 {
 	progStatus.pbt_lock = btnLOCK->value();
 	if (progStatus.pbt_lock) {
-		guard_lock serial_lock(&mutex_serial, "23");
 		progStatus.pbt_outer = progStatus.pbt_inner;
 		sldrOUTER->value(progStatus.pbt_outer);
-		selrig->set_pbt_outer(progStatus.pbt_outer);
 		sldrOUTER->redraw();
+		cat_post(exec_setLOCK);
+	}
+}
+
+static void exec_setINNER(long long)
+{
+	guard_lock lock(&mutex_serial, "24");
+	selrig->set_pbt_inner(progStatus.pbt_inner);
+	selrig->get_pbt_inner();
+	if (progStatus.pbt_lock) {
+		selrig->set_pbt_outer(progStatus.pbt_outer);
+		selrig->get_pbt_outer();
 	}
 }
 
@@ -3132,12 +3224,17 @@ void setINNER()
 		return;
 	}
 
-	guard_lock lock(&mutex_serial, "24");
-	selrig->set_pbt_inner(progStatus.pbt_inner);
-	selrig->get_pbt_inner();
+	cat_post(exec_setINNER);
+}
+
+static void exec_setOUTER(long long)
+{
+	guard_lock lock(&mutex_serial, "25");
+	selrig->set_pbt_outer(progStatus.pbt_outer);
+	selrig->get_pbt_outer();
 	if (progStatus.pbt_lock) {
-		selrig->set_pbt_outer(progStatus.pbt_outer);
-		selrig->get_pbt_outer();
+		selrig->set_pbt_inner(progStatus.pbt_inner);
+		selrig->get_pbt_inner();
 	}
 }
 
@@ -3171,13 +3268,14 @@ void setOUTER()
 		return;
 	}
 
-	guard_lock lock(&mutex_serial, "25");
+	cat_post(exec_setOUTER);
+}
+
+static void exec_setCLRPBT(long long)
+{
+	guard_lock lock(&mutex_serial, "26");
 	selrig->set_pbt_outer(progStatus.pbt_outer);
-	selrig->get_pbt_outer();
-	if (progStatus.pbt_lock) {
-		selrig->set_pbt_inner(progStatus.pbt_inner);
-		selrig->get_pbt_inner();
-	}
+	selrig->set_pbt_inner(progStatus.pbt_inner);
 }
 
 void setCLRPBT()
@@ -3193,9 +3291,7 @@ void setCLRPBT()
 	sldrINNER->value(0);
 	sldrINNER->redraw();
 
-	guard_lock lock(&mutex_serial, "26");
-	selrig->set_pbt_outer(progStatus.pbt_outer);
-	selrig->set_pbt_inner(progStatus.pbt_inner);
+	cat_post(exec_setCLRPBT);
 }
 
 //----------------------------------------------------------------------
@@ -3253,6 +3349,12 @@ void cbEventLog()
 	debug::show();
 }
 
+static void exec_setVolume(long long set)
+{
+	guard_lock serial_lock(&mutex_serial, "27");
+	selrig->set_volume_control(set);
+}
+
 void setVolume() // UI call
 {
 	trace(1, "setVolume()");
@@ -3269,8 +3371,7 @@ void setVolume() // UI call
 
 	if (btnVol->value() == 0) return;
 
-	guard_lock serial_lock(&mutex_serial, "27");
-	selrig->set_volume_control(set);
+	cat_post(exec_setVolume, set);
 }
 
 void setVolumeControl(void* d) // called by xml_server
@@ -3280,12 +3381,27 @@ void setVolumeControl(void* d) // called by xml_server
 	if (spnrVOLUME) spnrVOLUME->value(progStatus.volume);
 }
 
-void cbMute()
+static void exec_cbMute(long long set)
 {
 	guard_lock serial_lock(&mutex_serial, "28");
+
+	int get, cnt = 0;
+	selrig->set_volume_control(set);
+	MilliSleep(50);
+	get = selrig->get_volume_control();
+	while (get != set && cnt++ < 10) {
+		MilliSleep(progStatus.serial_post_write_delay);
+		get = selrig->get_volume_control();
+		Fl::awake();
+	}
+	poll_wakeup(read_volume);
+}
+
+void cbMute()
+{
 	trace(1, "cbMute()");
 
-	int set = 0, get, cnt = 0;
+	int set = 0;
 	if (btnVol->value() == 0) {
 		if (spnrVOLUME) spnrVOLUME->deactivate();
 		if (sldrVOLUME) sldrVOLUME->deactivate();
@@ -3299,15 +3415,14 @@ void cbMute()
 			set = sldrVOLUME->value();
 		}
 	}
-	selrig->set_volume_control(set);
-	MilliSleep(50);
-	get = selrig->get_volume_control();
-	while (get != set && cnt++ < 10) {
-		MilliSleep(progStatus.serial_post_write_delay);
-		get = selrig->get_volume_control();
-		Fl::awake();
-	}
 	progStatus.volume = set;
+	cat_post(exec_cbMute, set, CAT_QUEUE);
+}
+
+static void exec_setMicGain(long long set)
+{
+	guard_lock lock(&mutex_serial, "29");
+	selrig->set_mic_gain(set);
 }
 
 void setMicGain()
@@ -3330,8 +3445,7 @@ void setMicGain()
 
 	progStatus.mic_gain = set;
 
-	guard_lock lock(&mutex_serial, "29");
-	selrig->set_mic_gain(set);
+	cat_post(exec_setMicGain, set);
 }
 
 void setMicGainControl(void* d)
@@ -3485,6 +3599,19 @@ void set_power_controlImage(double pwr)
 
 void set_init_power_control();
 
+static void init_power_control(void *)
+{
+	set_init_power_control();
+}
+
+// val is watts * 1000
+static void exec_setPower(long long val)
+{
+	guard_lock lock(&mutex_serial, "30");
+	selrig->set_power_control(val / 1000.0);
+	Fl::awake(init_power_control);
+}
+
 void execute_setPower()
 {
 	double set = 0;
@@ -3514,9 +3641,7 @@ void execute_setPower()
 		if (sldrPOWER) sldrPOWER->value(set);
 	}
 
-	guard_lock lock(&mutex_serial, "30");
-	selrig->set_power_control(set);
-	set_init_power_control();
+	cat_post(exec_setPower, llround(set * 1000.0));
 }
 
 void setPower()
@@ -3533,18 +3658,23 @@ void setPower()
 	execute_setPower();
 }
 
-void cbTune()
+static void exec_tune(long long how)
 {
 	guard_lock serial_lock(&mutex_serial, "31");
+	selrig->tune_rig(how);
+	poll_wakeup(read_tuner);
+}
+
+void cbTune()
+{
 	trace(1, "cbTune()");
-	selrig->tune_rig(2);
+	cat_post(exec_tune, 2, CAT_QUEUE);
 }
 
 void cb_tune_on_off()
 {
-	guard_lock serial_lock(&mutex_serial, "32");
 	trace(1, "cb_tune_on_off()");
-	selrig->tune_rig(btn_tune_on_off->value());
+	cat_post(exec_tune, btn_tune_on_off->value(), CAT_QUEUE);
 }
 
 int chkptt()
@@ -3575,7 +3705,8 @@ void doPTT(int on)
 //	if (chk == on) return;
 
 	PTT = on;
-	rigPTT(on);
+	if (!rigPTT(on))
+		return;
 	btnPTT->value(on);
 	MilliSleep(progStatus.serial_post_write_delay);
 	for (int n = 0; n < 100; n++) {
@@ -3586,6 +3717,12 @@ void doPTT(int on)
 	return;
 }
 
+static void exec_setSQUELCH(long long set)
+{
+	guard_lock lock(&mutex_serial, "34");
+	selrig->set_squelch(set);
+}
+
 void setSQUELCH()
 {
 	trace(1, "setSQUELCH()");
@@ -3601,8 +3738,7 @@ void setSQUELCH()
 	if (spnrSQUELCH) set = spnrSQUELCH->value();
 
 	progStatus.squelch = set;
-	guard_lock lock(&mutex_serial, "34");
-	selrig->set_squelch(set);
+	cat_post(exec_setSQUELCH, set);
 }
 
 int agcwas = 0;
@@ -3678,13 +3814,24 @@ void setAGC(void *)
 	redrawAGC();
 }
 
+static void exec_cbAGC(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "35");
+	progStatus.agc_level = selrig->incr_agc();
+	Fl::awake(setAGC);
+}
+
 void cbAGC()
 {
 	if (!selrig->has_agc_control) return;
-	guard_lock serial_lock(&mutex_serial, "35");
 	trace(1, "cbAGC()");
-	progStatus.agc_level = selrig->incr_agc();
-	redrawAGC();
+	cat_post(exec_cbAGC, 0, CAT_QUEUE);
+}
+
+static void exec_setRFGAIN(long long set)
+{
+	guard_lock lock(&mutex_serial, "36");
+	selrig->set_rf_gain(set);
 }
 
 void setRFGAIN()
@@ -3705,8 +3852,7 @@ void setRFGAIN()
 
 	progStatus.rfgain = set;
 
-	guard_lock lock(&mutex_serial, "36");
-	selrig->set_rf_gain(set);
+	cat_post(exec_setRFGAIN, set);
 }
 
 void setRFGAINControl(void* d)
@@ -3920,9 +4066,9 @@ void updateVmeter(void *)
 
 void TRACED(saveFreqList)
 
-	std::string atag;
-
-	if (!numinlist) return;
+	std::vector<MEMORY> list;
+	mem_bank.list(list, mem_sort_column());
+	if (list.empty()) return;
 
 	rotate_log(defFileName);
 
@@ -3931,11 +4077,9 @@ void TRACED(saveFreqList)
 		fl_message ("Could not write to %s", defFileName.c_str());
 		return;
 	}
-	for (int i = 0; i < numinlist; i++) {
-		atag = oplist[i].alpha_tag;
-		oList << oplist[i].freq << " " << oplist[i].imode << " " << oplist[i].iBW << " \"" << atag.c_str() << "\"" << std::endl;
+	for (size_t i = 0; i < list.size(); i++)
+		oList << list[i].freq << " " << list[i].imode << " " << list[i].iBW << " \"" << list[i].tag << "\"" << std::endl;
 
-	}
 	oList.close();
 }
 
@@ -4032,6 +4176,13 @@ void TRACED(exit_commands)
 
 void TRACED(close_UI)
 
+	sweep_stop();
+
+// the last settings made on the panel go to the transceiver; drained
+// before the radios, and their schedulers, are deleted
+	cat_executor_stop();
+	radios_stop();
+
 	{
 		guard_lock serial_lock(&mutex_serial, "39");
 		trace(1, "close_UI()");
@@ -4046,6 +4197,8 @@ void TRACED(close_UI)
 	// close down the serial port
 	RigSerial->ClosePort();
 
+	cat_capture_stop();
+
 	debug::stop();
 
 	Fl_Double_Window *widgets[] = {
@@ -4080,6 +4233,7 @@ void TRACED(closeRig)
 	}
 	else if (xcvr_online) {
 		restore_xcvr_vals();
+		if (push_on) set_push(false);
 		selrig->shutdown();
 	}
 	xcvr_online = false;
@@ -4155,6 +4309,26 @@ void TRACED(cbExit)
 
 }
 
+static void exec_select_meter(long long image)
+{
+	switch (image) {
+		case IDD_IMAGE: {
+			guard_lock serial_lock(&mutex_serial, "40");
+			selrig->select_idd();
+			break;
+		}
+		case SWR_IMAGE: {
+			guard_lock serial_lock(&mutex_serial, "41");
+			selrig->select_swr();
+			break;
+		}
+		default: {
+			guard_lock serial_lock(&mutex_serial, "42");
+			selrig->select_alc();
+		}
+	}
+}
+
 void cbALC_IDD_SWR()
 {
 	switch (meter_image) {
@@ -4163,11 +4337,8 @@ void cbALC_IDD_SWR()
 				btnALC_IDD_SWR->image(image_idd25);
 				meter_image = IDD_IMAGE;
 				sldrIDD->show();
-				{
-					guard_lock serial_lock(&mutex_serial, "40");
-					trace(1, "cbALC_IDD_SWR()  2");
-					selrig->select_idd();
-				}
+				trace(1, "cbALC_IDD_SWR()  2");
+				cat_post(exec_select_meter, IDD_IMAGE);
 				break;
 			}
 		case IDD_IMAGE:
@@ -4175,11 +4346,8 @@ void cbALC_IDD_SWR()
 				btnALC_IDD_SWR->image(image_swr);
 				meter_image = SWR_IMAGE;
 				sldrSWR->show();
-				{
-					guard_lock serial_lock(&mutex_serial, "41");
-					trace(1, "cbALC_IDD_SWR()  2");
-					selrig->select_swr();
-				}
+				trace(1, "cbALC_IDD_SWR()  2");
+				cat_post(exec_select_meter, SWR_IMAGE);
 				break;
 			}
 		case SWR_IMAGE:
@@ -4193,11 +4361,8 @@ void cbALC_IDD_SWR()
                 }
 				meter_image = ALC_IMAGE;
 				sldrALC->show();
-				{
-					guard_lock serial_lock(&mutex_serial, "42");
-					trace(1, "cbALC_IDD_SWR()  1");
-					selrig->select_alc();
-				}
+				trace(1, "cbALC_IDD_SWR()  1");
+				cat_post(exec_select_meter, ALC_IMAGE);
 			}
 	}
 	btnALC_IDD_SWR->redraw();
@@ -4217,22 +4382,22 @@ const std::string lt_trim(const std::string& pstring, const std::string& pWhites
 
 void editAlphaTag()
 {
-	int indx;
+	int id;
 	std::string atag;
 	if (FreqSelect->value() < 1) {
 		inAlphaTag->value("");
 		return;	// no memory selected
 	}
-	indx = FreqSelect->value() - 1;
+	id = mem_bank.id(FreqSelect->value());
+	if (id < 0) return;
 	atag = inAlphaTag->value();
 // delete leading, trailing spaces
 	atag = lt_trim(atag);
-	memset(oplist[indx].alpha_tag, 0, ATAGSIZE);
-	snprintf(oplist[indx].alpha_tag, ATAGSIZE, "%s", atag.c_str());
-// update browser list
-	updateSelect();
-	FreqSelect->value(indx + 1);
-	inAlphaTag->value(oplist[indx].alpha_tag);
+	mem_bank.retag(id, atag);
+// the memory moves when sorted by tag
+	int line = mem_bank.line(id);
+	if (line) FreqSelect->value(line);
+	show_alpha_tag(line);
 }
 
 //----------------------------------------------------------------------
@@ -4320,92 +4485,161 @@ void cbAuxPort()
 	AuxSerial->setDTR(progStatus.aux_dtr);
 }
 
-void cb_agc_level()
+static void exec_cb_agc_level(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "43");
 	trace(1, "cb_agc_level()");
 	selrig->set_agc_level();
 }
 
-void cb_cw_wpm()
+void cb_agc_level()
+{
+	cat_post(exec_cb_agc_level);
+}
+
+static void exec_cb_cw_wpm(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "44");
 	trace(1, "cb_cw_wpm()");
 	selrig->set_cw_wpm();
 }
 
-void cb_cw_vol()
+void cb_cw_wpm()
+{
+	cat_post(exec_cb_cw_wpm);
+}
+
+static void exec_cb_cw_vol(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "45");
 	trace(1, "cb_cw_vol()");
 	selrig->set_cw_vol();
 }
 
-void cb_cw_spot()
+void cb_cw_vol()
+{
+	cat_post(exec_cb_cw_vol);
+}
+
+static void spot_off(void *)
+{
+	btnSpot->value(0);
+}
+
+static void exec_cb_cw_spot(long long)
 {
-	int ret;
 	guard_lock serial_lock(&mutex_serial, "46");
+	if (!selrig->set_cw_spot()) Fl::awake(spot_off);
+}
+
+void cb_cw_spot()
+{
 	trace(1, "cb_cw_spot()");
-	ret = selrig->set_cw_spot();
-	if (!ret) btnSpot->value(0);
+	cat_post(exec_cb_cw_spot);
 }
 
-void cb_cw_spot_tone()
+static void exec_cb_cw_spot_tone(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "47");
 	trace(1, "cb_cw_spot_tone()");
 	selrig->set_cw_spot_tone();
 }
 
+void cb_cw_spot_tone()
+{
+	cat_post(exec_cb_cw_spot_tone);
+}
 
-void cb_vox_gain()
+
+static void exec_cb_vox_gain(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "48");
 	trace(1, "cb_vox_gain()");
 	selrig->set_vox_gain();
 }
 
-void cb_vox_anti()
+void cb_vox_gain()
+{
+	cat_post(exec_cb_vox_gain);
+}
+
+static void exec_cb_vox_anti(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "49");
 	trace(1, "cb_vox_anti()");
 	selrig->set_vox_anti();
 }
 
-void cb_vox_hang()
+void cb_vox_anti()
+{
+	cat_post(exec_cb_vox_anti);
+}
+
+static void exec_cb_vox_hang(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "50");
 	trace(1, "cb_vox_hang()");
 	selrig->set_vox_hang();
 }
 
-void cb_vox_onoff()
+void cb_vox_hang()
+{
+	cat_post(exec_cb_vox_hang);
+}
+
+static void exec_cb_vox_onoff(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "51");
 	trace(1, "cb_vox_onoff()");
 	selrig->set_vox_onoff();
 }
 
-void cb_vox_on_dataport()
+void cb_vox_onoff()
+{
+	cat_post(exec_cb_vox_onoff);
+}
+
+static void exec_cb_vox_on_dataport(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "52");
 	trace(1, "cb_dataport()");
 	selrig->set_vox_on_dataport();
 }
 
-void cb_compression()
+void cb_vox_on_dataport()
+{
+	cat_post(exec_cb_vox_on_dataport);
+}
+
+static void exec_cb_compression(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "53");
 	trace(1, "cb_compression");
 	selrig->set_compression(progStatus.compON, progStatus.compression);
 }
 
+void cb_compression()
+{
+	cat_post(exec_cb_compression);
+}
+
+static void exec_cb_auto_notch(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "54");
+	selrig->set_auto_notch(progStatus.auto_notch);
+}
+
 void cb_auto_notch()
 {
 	progStatus.auto_notch = btnAutoNotch->value();
-	guard_lock serial_lock(&mutex_serial, "54");
 	trace(1, "cb_autonotch()");
-	selrig->set_auto_notch(progStatus.auto_notch);
+	cat_post(exec_cb_auto_notch);
+}
+
+static void exec_cb_vfo_adj(long long)
+{
+	guard_lock serial_lock(&mutex_serial, "55");
+	selrig->setVfoAdj(progStatus.vfo_adj);
 }
 
 void cb_vfo_adj()
@@ -4414,37 +4648,43 @@ void cb_vfo_adj()
 		progStatus.vfo_adj = spnr_tt550_vfo_adj->value();
 	else
 		progStatus.vfo_adj = spnr_vfo_adj->value();
-	guard_lock serial_lock(&mutex_serial, "55");
 	trace(1, "cb_vfo_adj()");
-	selrig->setVfoAdj(progStatus.vfo_adj);
+	cat_post(exec_cb_vfo_adj);
 }
 
 void cb_line_out()
 {
 }
 
-void cb_bpf_center()
+static void exec_cb_bpf_center(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "56");
 	trace(1, "cb_bpf_center()");
 	selrig->set_if_shift(selrig->pbt);
 }
 
-void cb_special()
+void cb_bpf_center()
+{
+	cat_post(exec_cb_bpf_center);
+}
+
+static void exec_cb_special(long long on)
 {
 	guard_lock serial_lock(&mutex_serial, "57");
+	selrig->set_special(on);
+}
+
+void cb_special()
+{
 	trace(1, "cb_special()");
-	selrig->set_special(btnSpecial->value());
+	cat_post(exec_cb_special, btnSpecial->value());
 }
 
-void cbNoise()
+static void exec_cbNoise(long long btn)
 {
 	guard_lock serial_lock(&mutex_serial, "58");
-	trace(1, "cbNoise()");
 
-	int btn, get, cnt = 0;
-
-	btn = progStatus.noise = btnNOISE->value();
+	int get, cnt = 0;
 
 	selrig->set_noise(btn);
 
@@ -4458,7 +4698,20 @@ void cbNoise()
 
 	vfo->noise = progStatus.noise;
 	vfo->nb_level = progStatus.nb_level;
-	update_noise( (void*)0 );
+	Fl::awake(update_noise);
+}
+
+void cbNoise()
+{
+	trace(1, "cbNoise()");
+	progStatus.noise = btnNOISE->value();
+	cat_post(exec_cbNoise, progStatus.noise, CAT_QUEUE);
+}
+
+static void exec_cb_nb_level(long long set)
+{
+	guard_lock lock(&mutex_serial, "59");
+	selrig->set_nb_level(set);
 }
 
 void cb_nb_level()
@@ -4475,19 +4728,15 @@ void cb_nb_level()
 		return;
 	}
 	set = sldr_nb_level->value();
-	guard_lock lock(&mutex_serial, "59");
-	selrig->set_nb_level(set);
+	cat_post(exec_cb_nb_level, set);
 }
 
-void cbNR()
+// arg is set * 2 + btn
+static void exec_cbNR(long long arg)
 {
-	if (!selrig->has_noise_reduction_control) return;
 	guard_lock serial_lock(&mutex_serial, "60");
-	trace(1, "cbNR()");
 
-	int btn = 0, set = 0, get, cnt = 0;
-	btn = btnNR->value();
-	set = sldrNR ? sldrNR->value() : spnrNR->value();
+	int btn = (int)(arg & 1), set = (int)((arg - btn) / 2), get, cnt = 0;
 
 	if (xcvr_name == rig_TS2000.name_) {
 		if (btn != -1) { // pia
@@ -4536,6 +4785,26 @@ void cbNR()
 
 }
 
+void cbNR()
+{
+	if (!selrig->has_noise_reduction_control) return;
+	trace(1, "cbNR()");
+
+	int btn = btnNR->value();
+	int set = sldrNR ? sldrNR->value() : spnrNR->value();
+	cat_post(exec_cbNR, set * 2LL + (btn ? 1 : 0), CAT_QUEUE);
+}
+
+// arg is set * 4 + btn + 1, btn -1, 0 or 1
+static void exec_setNR(long long arg)
+{
+	int btn = (int)(arg & 3) - 1;
+	int set = (int)((arg - (btn + 1)) / 4);
+	guard_lock lock(&mutex_serial, "61");
+	selrig->set_noise_reduction_val(set);
+	selrig->set_noise_reduction(btn);
+}
+
 void setNR()
 {
 	if (!selrig->has_noise_reduction_control) return;
@@ -4574,54 +4843,81 @@ void setNR()
 		}
 	}
 
-	guard_lock lock(&mutex_serial, "61");
-	selrig->set_noise_reduction_val(set);
-	selrig->set_noise_reduction(btn);
-
+	cat_post(exec_setNR, set * 4LL + (btn + 1));
 }
 
-void cb_spot()
+static void exec_cb_spot(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "62");
 	trace(1, "cb_spot()");
 	selrig->set_cw_spot();
 }
 
-void cb_enable_keyer()
+void cb_spot()
+{
+	cat_post(exec_cb_spot);
+}
+
+static void exec_cb_enable_keyer(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "63");
 	trace(1, "cb_enable_keyer()");
 	selrig->enable_keyer();
 }
 
-void cb_set_break_in()
+void cb_enable_keyer()
+{
+	cat_post(exec_cb_enable_keyer);
+}
+
+static void exec_cb_set_break_in(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "64");
 	trace(1, "cb_set_break_in()");
 	selrig->set_break_in();
 }
 
-void cb_cw_weight()
+void cb_set_break_in()
+{
+	cat_post(exec_cb_set_break_in);
+}
+
+static void exec_cb_cw_weight(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "65");
 	trace(1, "cb_cw_weight()");
 	selrig->set_cw_weight();
 }
 
-void cb_cw_qsk()
+void cb_cw_weight()
+{
+	cat_post(exec_cb_cw_weight);
+}
+
+static void exec_cb_cw_qsk(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "66");
 	trace(1, "cb_cw_qsk()");
 	selrig->set_cw_qsk();
 }
 
-void cb_cw_delay()
+void cb_cw_qsk()
+{
+	cat_post(exec_cb_cw_qsk);
+}
+
+static void exec_cb_cw_delay(long long)
 {
 	guard_lock serial_lock(&mutex_serial, "67");
 	trace(1, "cb_cw_delay()");
 	selrig->set_cw_delay();
 }
 
+void cb_cw_delay()
+{
+	cat_post(exec_cb_cw_delay);
+}
+
 void set_band_label(int band)
 {
 	switch (band) {
@@ -26,6 +26,7 @@
 
 #include "threads.h"
 #include "support.h"
+#include "cat_stats.h"
 
 /// This ensures that a mutex is always unlocked when leaving a function or block.
 
@@ -35,6 +36,7 @@ extern pthread_mutex_t mutex_serial;
 extern pthread_mutex_t debug_mutex;
 extern pthread_mutex_t mutex_rcv_socket;
 extern pthread_mutex_t mutex_trace;
+extern pthread_mutex_t mutex_ptt_interlock;
 
 // Change to 1 to observe guard lock/unlock processing on stdout
 //#define DEBUG_GUARD_LOCK 0
@@ -59,8 +61,15 @@ extern pthread_mutex_t mutex_trace;
 //	pthread_mutex_unlock(mutex);
 //}
 
-guard_lock::guard_lock(pthread_mutex_t* m, std::string h) : mutex(m) {
+guard_lock::guard_lock(pthread_mutex_t* m, std::string h) : mutex(m), hold(0) {
+	const char *mname = name(mutex);
+	ullint waiting = *mname ? zusec() : 0;
 	pthread_mutex_lock(mutex);
+	if (*mname) {
+		locked = zusec();
+		stats_record(stats_entry(STATS_LOCK_WAIT, mname), locked - waiting);
+		hold = stats_entry(STATS_LOCK_HOLD, mname);
+	}
 	if (!h.empty()) {
 		how = h;
 		std::string szlock;
@@ -77,6 +86,8 @@ guard_lock::~guard_lock(void) {
 		snprintf(szlock, sizeof(szlock), "%s, %s locked for %lu msec", how.c_str(), name(mutex), (long)(zmsec() - start_time));
 		lock_trace(1, szlock);
 	}
+	if (hold)
+		stats_record(hold, zusec() - locked);
 	pthread_mutex_unlock(mutex);
 }
 
@@ -89,6 +100,7 @@ const char * guard_lock::name(pthread_mutex_t *m) {
 	if (m == &mutex_rcv_socket) return "mutex_rcv_socket";
 	if (m == &mutex_srvc_reqs) return "mutex_service_requests";
 	if (m == &mutex_trace) return "mutex_trace";
+	if (m == &mutex_ptt_interlock) return "mutex_ptt_interlock";
 	return "";
 }
 
@@ -44,6 +44,7 @@
 #include "ui.h"
 #include "tod_clock.h"
 #include "trace.h"
+#include "async_log.h"
 
 #include "rig.h"
 #include "rigs.h"
@@ -92,16 +93,6 @@ void make_trace_window() {
 	tracewindow->resizable(tracedisplay);
 }
 
-static void write_trace_file(std::string s)
-{
-	std::string trace_fname = RigHomeDir;
-	trace_fname.append("trace.txt");
-	std::fstream tfile(trace_fname.c_str(), std::ios::app);
-	if (tfile)
-		tfile << s;
-	tfile.close();
-}
-
 static void update_tracetext(void *)
 {
 	guard_lock tt(&mutex_trace);
@@ -126,26 +117,60 @@ void write_tracetext()
 	Fl::awake(update_tracetext);
 }
 
+#define TRACE_LINE_MAX 4096
+
+static void show_trace(const std::string &lines)
+{
+	guard_lock tt(&mutex_trace);
+	tracestring.append(lines);
+	write_tracetext();
+}
+
+static pthread_once_t trace_once = PTHREAD_ONCE_INIT;
+
+static void open_trace()
+{
+	std::string trace_fname = RigHomeDir;
+	trace_fname.append("trace.txt");
+	async_log_open(ASYNC_TRACE, trace_fname.c_str());
+	async_log_display(ASYNC_TRACE, show_trace);
+}
+
+static void post_text(const char *text, size_t len)
+{
+	pthread_once(&trace_once, open_trace);
+	async_log(ASYNC_TRACE, text, len);
+}
+
+static void post_trace(const char *tag, int n, va_list vl)
+{
+	char line[TRACE_LINE_MAX];
+	size_t len = 0;
+	const char *p;
+
+	len = snprintf(line, sizeof(line), tag ? "%s [%s] :" : "%s :", ztime(), tag);
+	for (int i = 0; i < n && len < sizeof(line) - 1; i++) {
+		line[len++] = ' ';
+		p = va_arg(vl, const char *);
+		while (p && *p && len < sizeof(line) - 1)
+			line[len++] = *p++;
+	}
+	if (len > sizeof(line) - 1) len = sizeof(line) - 1;
+	line[len++] = '\n';
+
+	post_text(line, len);
+}
+
 void trace(int n, ...) // all args of type const char *
 {
 	if (!progStatus.trace) return;
 	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 #include "XmlRpc.h"
@@ -156,24 +181,14 @@ void xml_trace(int n, ...) // all args of type const char *
 	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime();
 #ifdef HAS_XMLRPC_CLIENT_ID
-	s << " [" << XmlRpc::client_id << "]";
+	post_trace(XmlRpc::get_client_id().c_str(), n, vl);
+#else
+	post_trace(NULL, n, vl);
 #endif
-	s << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 void rig_trace(int n, ...) // all args of type const char *
@@ -182,20 +197,10 @@ void rig_trace(int n, ...) // all args of type const char *
 	if (!n) return;
 	if (!tracewindow) make_trace_window();
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 void set_trace(int n, ...) // all args of type const char *
@@ -204,20 +209,10 @@ void set_trace(int n, ...) // all args of type const char *
 	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 void get_trace(int n, ...) // all args of type const char *
@@ -226,24 +221,16 @@ void get_trace(int n, ...) // all args of type const char *
 	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 void rpc_trace(int n, ...) // all args of type const char *
 {
+	if (!progStatus.rpctrace) return;
+	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
 	std::stringstream s;
@@ -295,15 +282,7 @@ void rpc_trace(int n, ...) // all args of type const char *
 
 	if (str[str.length()-1] != '\n') str += '\n';
 
-	if (!tracewindow) make_trace_window();
-	if (!progStatus.rpctrace) return;
-	if (!n) return;
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
+	post_text(s.str().c_str(), s.str().length());
 }
 
 void ser_trace(int n, ...) // all args of type const char *
@@ -312,20 +291,10 @@ void ser_trace(int n, ...) // all args of type const char *
 	if (!tracewindow) make_trace_window();
 	if (!n) return;
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 void deb_trace(int n, ...) // all args of type const char *
@@ -382,11 +351,7 @@ void deb_trace(int n, ...) // all args of type const char *
 
 	if (str[str.length()-1] != '\n') str += '\n';
 
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
+	post_text(s.str().c_str(), s.str().length());
 }
 
 void tci_trace(int n, ...) // all args of type const char *
@@ -395,20 +360,10 @@ void tci_trace(int n, ...) // all args of type const char *
 	if (!n) return;
 	if (!tracewindow) make_trace_window();
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
 
 bool activate_lock_trace = false;
@@ -418,18 +373,8 @@ void lock_trace(int n, ...) // all args of type const char *
 	if (!n || !activate_lock_trace) return;
 	if (!tracewindow) make_trace_window();
 
-	std::stringstream s;
 	va_list vl;
 	va_start(vl, n);
-	s << ztime() << " : " << va_arg(vl, const char *);
-	for (int i = 1; i < n; i++)
-		s << " " << va_arg(vl, const char *);
+	post_trace(NULL, n, vl);
 	va_end(vl);
-	s << "\n";
-
-	write_trace_file(s.str());
-
-	guard_lock tt(&mutex_trace);
-	tracestring.append(s.str());
-	write_tracetext();
 }
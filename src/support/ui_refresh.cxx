@@ -0,0 +1,93 @@
+// ----------------------------------------------------------------------------
+// Copyright (C) 2026
+//              flrig developers
+//
+// This file is part of flrig.
+//
+// flrig is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+//
+// flrig is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// ----------------------------------------------------------------------------
+
+#include <FL/Fl.H>
+
+#include "ui_refresh.h"
+#include "support.h"
+#include "status.h"
+#include "cat_stats.h"
+#include "tod_clock.h"
+
+// items waiting for the next frame
+static volatile unsigned long dirty = 0;
+// a frame has been requested and not yet drawn
+static volatile int scheduled = 0;
+
+// UI thread only
+static ullint last_frame = 0;
+
+static void ui_frame(void *)
+{
+	static STATS_ENTRY *frame_time = stats_entry(STATS_TIMING, "ui frame");
+
+	last_frame = zusec();
+
+// marks made from here on request another frame
+	__sync_bool_compare_and_swap(&scheduled, 1, 0);
+	unsigned long what = __sync_fetch_and_and(&dirty, 0UL);
+	if (!what) return;
+
+	if (what & UI_PTT)		update_UI_PTT();
+	if (what & UI_XMT_ZERO)	zeroXmtMeters();
+	if (what & UI_SMETER)	updateSmeter();
+	if (what & UI_PWR)		updateFwdPwr();
+	if (what & UI_SWR)		updateSWR();
+	if (what & UI_ALC)		updateALC();
+	if (what & UI_IDD)		updateIDD();
+	if (what & UI_VMETER)	updateVmeter();
+	if (what & UI_FREQ_A)	setFreqDispA();
+	if (what & UI_FREQ_B)	setFreqDispB();
+
+	stats_record(frame_time, zusec() - last_frame);
+}
+
+// UI thread; draw now if a frame period has passed since the last one,
+// otherwise at the start of the next period
+static void ui_schedule(void *)
+{
+	int fps = progStatus.ui_refresh_rate;
+	if (fps < 1) fps = 1;
+	if (fps > 100) fps = 100;
+	ullint period = 1000000ULL / fps;
+
+	ullint now = zusec();
+	if (now >= last_frame + period)
+		ui_frame(0);
+	else
+		Fl::add_timeout((last_frame + period - now) / 1e6, ui_frame);
+}
+
+void ui_mark(unsigned long what)
+{
+	__sync_fetch_and_or(&dirty, what);
+	if (!__sync_bool_compare_and_swap(&scheduled, 0, 1))
+		return;
+// the awake queue is full; the items stay marked and the next mark
+// requests the frame again
+	if (Fl::awake(ui_schedule) != 0)
+		__sync_bool_compare_and_swap(&scheduled, 1, 0);
+}
+
+unsigned long ui_take()
+{
+	__sync_bool_compare_and_swap(&scheduled, 1, 0);
+	return __sync_fetch_and_and(&dirty, 0UL);
+}
@@ -98,6 +98,7 @@
 
 using WSclient::Callback_Imp;
 using WSclient::BytesCallback_Imp;
+using WSclient::FrameCallback_Imp;
 
 namespace { // private module-only namespace
 
@@ -144,6 +145,7 @@ class _DummyWebSocket : public WSclient::WebSocket
 	readyStateValues getReadyState() const { return CLOSED; }
 	void _dispatch(Callback_Imp & callable) { }
 	void _dispatchBinary(BytesCallback_Imp& callable) { }
+	void _dispatchFrame(FrameCallback_Imp& callable) { }
 };
 
 
@@ -187,8 +189,19 @@ class _RealWebSocket : public WSclient::WebSocket
 		uint8_t masking_key[4];
 	};
 
+	// The receive buffer is read at rxhead and filled at rxtail.  Frames
+	// are parsed and unmasked where they lie, and the unread bytes are
+	// moved back to the start of the buffer only when less than RX_CHUNK
+	// bytes are free behind them, so a frame is always contiguous and
+	// nothing is copied or reallocated per recv.  The transmit buffer is
+	// likewise sent from txhead and emptied when it has all gone.
+	enum { RX_SIZE = 16384, RX_CHUNK = 4096 };
+
 	std::vector<uint8_t> rxbuf;
+	size_t rxhead;
+	size_t rxtail;
 	std::vector<uint8_t> txbuf;
+	size_t txhead;
 	std::vector<uint8_t> receivedData;
 
 	socket_t sockfd;
@@ -197,12 +210,27 @@ class _RealWebSocket : public WSclient::WebSocket
 	bool isRxBad;
 
 	_RealWebSocket(socket_t sockfd, bool useMask)
-			: sockfd(sockfd)
+			: rxbuf(RX_SIZE)
+			, rxhead(0)
+			, rxtail(0)
+			, txhead(0)
+			, sockfd(sockfd)
 			, readyState(OPEN)
 			, useMask(useMask)
 			, isRxBad(false) {
 	}
 
+	void rx_compact() {
+		if (rxhead) {
+			if (rxtail > rxhead)
+				memmove(&rxbuf[0], &rxbuf[rxhead], rxtail - rxhead);
+			rxtail -= rxhead;
+			rxhead = 0;
+		}
+		if (rxbuf.size() - rxtail < RX_CHUNK)
+			rxbuf.resize(rxbuf.size() * 2);
+	}
+
 	readyStateValues getReadyState() const {
 	  return readyState;
 	}
@@ -222,33 +250,30 @@ class _RealWebSocket : public WSclient::WebSocket
 			FD_ZERO(&rfds);
 			FD_ZERO(&wfds);
 			FD_SET(sockfd, &rfds);
-			if (txbuf.size()) { FD_SET(sockfd, &wfds); }
+			if (txhead < txbuf.size()) { FD_SET(sockfd, &wfds); }
 			select(sockfd + 1, &rfds, &wfds, 0, timeout > 0 ? &tv : 0);
 		}
 		while (true) {
 			// FD_ISSET(0, &rfds) will be true
-			int N = rxbuf.size();
+			if (rxbuf.size() - rxtail < RX_CHUNK) rx_compact();
 			ssize_t ret;
-			rxbuf.resize(N + 1500);
-			ret = recv(sockfd, (char*)&rxbuf[0] + N, 1500, 0);
+			ret = recv(sockfd, (char*)&rxbuf[rxtail], rxbuf.size() - rxtail, 0);
 			if (false) { }
 			else if (ret < 0 && (socketerrno == SOCKET_EWOULDBLOCK || socketerrno == SOCKET_EAGAIN_EINPROGRESS)) {
-				rxbuf.resize(N);
 				break;
 			}
 			else if (ret <= 0) {
-				rxbuf.resize(N);
 				closesocket(sockfd);
 				readyState = CLOSED;
 				fputs(ret < 0 ? "Connection error!\n" : "Connection closed!\n", stderr);
 				break;
 			}
 			else {
-				rxbuf.resize(N + ret);
+				rxtail += ret;
 			}
 		}
-		while (txbuf.size()) {
-			int ret = ::send(sockfd, (char*)&txbuf[0], txbuf.size(), 0);
+		while (txhead < txbuf.size()) {
+			int ret = ::send(sockfd, (char*)&txbuf[txhead], txbuf.size() - txhead, 0);
 			if (false) { } // ??
 			else if (ret < 0 && (socketerrno == SOCKET_EWOULDBLOCK || socketerrno == SOCKET_EAGAIN_EINPROGRESS)) {
 				break;
@@ -260,10 +285,14 @@ class _RealWebSocket : public WSclient::WebSocket
 				break;
 			}
 			else {
-				txbuf.erase(txbuf.begin(), txbuf.begin() + ret);
+				txhead += ret;
+				if (txhead == txbuf.size()) {
+					txbuf.clear();
+					txhead = 0;
+				}
 			}
 		}
-		if (!txbuf.size() && readyState == CLOSING) {
+		if (txhead == txbuf.size() && readyState == CLOSING) {
 			closesocket(sockfd);
 			readyState = CLOSED;
 		}
@@ -290,20 +319,36 @@ class _RealWebSocket : public WSclient::WebSocket
 	}
 
 	virtual void _dispatchBinary(BytesCallback_Imp & callable) {
+		struct CallbackAdapter : public FrameCallback_Imp
+			// Adapt void(const std::vector<uint8_t>&) to void(const char *, size_t)
+		{
+			BytesCallback_Imp& callable;
+			CallbackAdapter(BytesCallback_Imp& callable) : callable(callable) { }
+			void operator()(const char *data, size_t len) {
+				std::vector<uint8_t> message(data, data + len);
+				callable(message);
+			}
+		};
+		CallbackAdapter frameCallback(callable);
+		_dispatchFrame(frameCallback);
+	}
+
+	virtual void _dispatchFrame(FrameCallback_Imp & callable) {
 		// TODO: consider acquiring a lock on rxbuf...
 		if (isRxBad) {
 			return;
 		}
 		while (true) {
 			wsheader_type ws;
-			if (rxbuf.size() < 2) { return; /* Need at least 2 */ }
-			const uint8_t * data = (uint8_t *) &rxbuf[0]; // peek, but don't consume
+			size_t avail = rxtail - rxhead;
+			if (avail < 2) { return; /* Need at least 2 */ }
+			uint8_t * data = &rxbuf[rxhead]; // peek, but don't consume
 			ws.fin = (data[0] & 0x80) == 0x80;
 			ws.opcode = (wsheader_type::opcode_type) (data[0] & 0x0f);
 			ws.mask = (data[1] & 0x80) == 0x80;
 			ws.N0 = (data[1] & 0x7f);
 			ws.header_size = 2 + (ws.N0 == 126? 2 : 0) + (ws.N0 == 127? 8 : 0) + (ws.mask? 4 : 0);
-			if (rxbuf.size() < ws.header_size) { return; /* Need: ws.header_size - rxbuf.size() */ }
+			if (avail < ws.header_size) { return; /* Need: ws.header_size - avail */ }
 			int i = 0;
 			if (ws.N0 < 126) {
 				ws.N = ws.N0;
@@ -356,7 +401,8 @@ class _RealWebSocket : public WSclient::WebSocket
 
 			// Note: The checks above should hopefully ensure this addition
 			//       cannot overflow:
-			if (rxbuf.size() < ws.header_size+ws.N) { return; /* Need: ws.header_size+ws.N - rxbuf.size() */ }
+			if (avail < ws.header_size+ws.N) { return; /* Need: ws.header_size+ws.N - avail */ }
+			uint8_t * payload = data + ws.header_size;
 
 			// We got a whole message, now do something with it:
 			if (false) { }
@@ -365,24 +411,29 @@ class _RealWebSocket : public WSclient::WebSocket
 				|| ws.opcode == wsheader_type::BINARY_FRAME
 				|| ws.opcode == wsheader_type::CONTINUATION
 			) {
-				if (ws.mask) { for (size_t i = 0; i != ws.N; ++i) { rxbuf[i+ws.header_size] ^= ws.masking_key[i&0x3]; } }
-				receivedData.insert(receivedData.end(), rxbuf.begin()+ws.header_size, rxbuf.begin()+ws.header_size+(size_t)ws.N);// just feed
-				if (ws.fin) {
-					callable((const std::vector<uint8_t>) receivedData);
-					receivedData.erase(receivedData.begin(), receivedData.end());
-					std::vector<uint8_t> ().swap(receivedData);// free memory
+				if (ws.mask) { for (size_t i = 0; i != ws.N; ++i) { payload[i] ^= ws.masking_key[i&0x3]; } }
+				if (ws.fin && receivedData.empty()) {
+					// unfragmented, pass it on from the receive buffer
+					callable((const char *)payload, (size_t)ws.N);
+				}
+				else {
+					receivedData.insert(receivedData.end(), payload, payload+(size_t)ws.N);// just feed
+					if (ws.fin) {
+						callable((const char *)&receivedData[0], receivedData.size());
+						receivedData.clear();
+					}
 				}
 			}
 			else if (ws.opcode == wsheader_type::PING) {
-				if (ws.mask) { for (size_t i = 0; i != ws.N; ++i) { rxbuf[i+ws.header_size] ^= ws.masking_key[i&0x3]; } }
-				std::string data(rxbuf.begin()+ws.header_size, rxbuf.begin()+ws.header_size+(size_t)ws.N);
-				sendData(wsheader_type::PONG, data.size(), data.begin(), data.end());
+				if (ws.mask) { for (size_t i = 0; i != ws.N; ++i) { payload[i] ^= ws.masking_key[i&0x3]; } }
+				sendData(wsheader_type::PONG, ws.N, payload, payload+(size_t)ws.N);
 			}
 			else if (ws.opcode == wsheader_type::PONG) { }
 			else if (ws.opcode == wsheader_type::CLOSE) { close(); }
 			else { fprintf(stderr, "ERROR: Got unexpected WebSocket message.\n"); close(); }
 
-			rxbuf.erase(rxbuf.begin(), rxbuf.begin() + ws.header_size+(size_t)ws.N);
+			rxhead += ws.header_size+(size_t)ws.N;
+			if (rxhead == rxtail) { rxhead = rxtail = 0; }
 		}
 	}
 
@@ -412,8 +463,8 @@ class _RealWebSocket : public WSclient::WebSocket
 		const uint8_t masking_key[4] = { 0x12, 0x34, 0x56, 0x78 };
 		// TODO: consider acquiring a lock on txbuf...
 		if (readyState == CLOSING || readyState == CLOSED) { return; }
-		std::vector<uint8_t> header;
-		header.assign(2 + (message_size >= 126 ? 2 : 0) + (message_size >= 65536 ? 6 : 0) + (useMask ? 4 : 0), 0);
+		uint8_t header[14];
+		size_t header_size = 2 + (message_size >= 126 ? 2 : 0) + (message_size >= 65536 ? 6 : 0) + (useMask ? 4 : 0);
 		header[0] = 0x80 | type;
 		if (false) { }
 		else if (message_size < 126) {
@@ -454,7 +505,7 @@ class _RealWebSocket : public WSclient::WebSocket
 			}
 		}
 		// N.B. - txbuf will keep growing until it can be transmitted over the socket:
-		txbuf.insert(txbuf.end(), header.begin(), header.end());
+		txbuf.insert(txbuf.end(), header, header + header_size);
 		txbuf.insert(txbuf.end(), message_begin, message_end);
 		if (useMask) {
 			size_t message_offset = txbuf.size() - message_size;
@@ -468,8 +519,7 @@ class _RealWebSocket : public WSclient::WebSocket
 		if(readyState == CLOSING || readyState == CLOSED) { return; }
 		readyState = CLOSING;
 		uint8_t closeFrame[6] = {0x88, 0x80, 0x00, 0x00, 0x00, 0x00}; // last 4 bytes are a masking key
-		std::vector<uint8_t> header(closeFrame, closeFrame+6);
-		txbuf.insert(txbuf.end(), header.begin(), header.end());
+		txbuf.insert(txbuf.end(), closeFrame, closeFrame+6);
 	}
 
 };
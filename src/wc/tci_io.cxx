@@ -32,6 +32,9 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
 
 //#define TCI_DEBUG
 /*
@@ -72,6 +75,7 @@ private:
 #include "util.h"
 #include "trace.h"
 #include "threads.h"
+#include "cat_capture.h"
 /*
 #endif
 */
@@ -89,126 +93,267 @@ void print_vals(TCI_VALS &slice)
 
 using WSclient::WebSocket;
 
-void handle_message(const std::string & message)
-{
-	int rxnbr, vfo, ival;
-	float fval;
-	char szstr[50];
-	std::string str;
-	std::string rx = message;
-	size_t p = 0;
+//----------------------------------------------------------------------
+// TCI message parsing
+//
+// A message is one or more "name:arg,arg,...;" commands.  The command
+// name is looked up, without regard to case, in a perfect hash of the
+// names which flrig handles, and the arguments are read in place from
+// the WebSocket receive buffer; rx_smeter reports arrive many times a
+// second and are handled without copying or allocating.
+//----------------------------------------------------------------------
 
-	for (size_t n = 0; n < rx.length(); n++)
-		rx[n] = toupper(rx[n] & 0xFF);
+// arguments of one command, the text between ':' and ';'
+struct TCI_ARGS {
+	const char *p;
+	const char *end;
 
-#ifdef TCI_DEBUG
-std::cout << "R: " << rx << std::endl;
-#endif
+	TCI_ARGS(const char *b, const char *e) : p(b), end(e) {}
 
-	if ((p = rx.find("RX_SMETER:")) != std::string::npos) { // smeter reading
-		sscanf(rx.substr(p).c_str(), "RX_SMETER:%d,%d,%d;", &rxnbr, &vfo, &ival);
-		if (rxnbr == 0) {
-			if (vfo == 0) slice_0.A.smeter = ival;
-			else          slice_0.B.smeter = ival;
-		} else {
-			if (vfo == 0) slice_1.A.smeter = ival;
-			else          slice_1.B.smeter = ival;
-		}
+	// step over the ',' which ends an argument
+	void next() {
+		while (p < end && *p != ',') p++;
+		if (p < end) p++;
 	}
-	else {
-		tci_trace(2, "PARSE:", rx.c_str());
-		if ((p = rx.find("VFO:")) != std::string::npos) { // vfo:0,0,7032050;
-			sscanf(rx.substr(p).c_str(), "VFO:%d,%d,%d", &rxnbr, &vfo, &ival);
-			if (rxnbr == 0) {
-				if (vfo == 0) slice_0.A.freq = ival;
-				else          slice_0.B.freq = ival;
-			} else {
-				if (vfo == 0) slice_1.A.freq = ival;
-				else          slice_1.B.freq = ival;
-			}
-		}
-		else if ((p = rx.find("DDS:")) != std::string::npos) { // dds:1,14070000;
-			sscanf(rx.substr(p).c_str(), "DDS:%d,%d", &rxnbr, &ival);
-			if (rxnbr == 0) {
-				slice_0.dds = ival;
-			} else {
-				slice_1.dds = ival;
-			}
-		}
-		else if ((p = rx.find("RX_FILTER_BAND:")) != std::string::npos) { // rx_filter_band:0,-600,600;
-			int slice;
-			sscanf(rx.substr(p).c_str(), "RX_FILTER_BAND:%d,%s", &slice, szstr);
-			if (slice == 0) {slice_0.A.bw = slice_0.B.bw = szstr; }
-			else            {slice_1.A.bw = slice_1.B.bw = szstr; }
-		}
-		else if ((p = rx.find("MODULATION:")) != std::string::npos) { // modulation:0,cw;
-			int slice = 0;
-			sscanf(rx.substr(p).c_str(), "MODULATION:%d,%s", &slice, szstr);
-			if (slice == 0) { slice_0.A.mod = slice_0.B.mod = szstr; }
-			else            { slice_1.A.mod = slice_1.B.mod = szstr; }
-		}
-		else if ((p = rx.find("TRX:")) != std::string::npos) {
-			sscanf(rx.substr(p).c_str(), "TRX:%d,%s", &rxnbr, szstr);
-			str = szstr;
-			if (rxnbr == 0) {
-				slice_0.ptt = (str == "TRUE;");
-			} else {
-				slice_1.ptt = (str == "TRUE;");
-			}
-		}
-		else if ((p = rx.find("SPLIT_ENABLE:")) != std::string::npos) { // split_enable:0,false;
-			sscanf(rx.substr(p).c_str(), "SPLIT_ENABLE:%d,%s", &rxnbr, szstr);
-			str = szstr;
-			if (rxnbr == 0) {
-				slice_0.split = (str == "TRUE;");
-			} else {
-				slice_1.split = (str == "TRUE;");
-			}
-		}
-		else if ((p = rx.find("VOLUME:")) != std::string::npos) { // volume:-16;
-			sscanf(rx.substr(p).c_str(), "VOLUME:%d", &ival);
-			slice_0.vol = ival;
-		}
-		else if ((p = rx.find("SQL_ENABLE:")) != std::string::npos) { // sql_enable:1,false;
-			sscanf(rx.substr(p).c_str(), "SQL_ENABLE:%d,%s", &rxnbr, szstr);
-			str = szstr;
-			if (rxnbr == 0) {
-				slice_0.sql = (str == "TRUE;");
-			} else
-				slice_1.sql = (str == "TRUE;");
-		}
-		else if ((p = rx.find("SQL_LEVEL:")) != std::string::npos) { // sql_level:0,-79;
-			sscanf(rx.substr(p).c_str(), "SQL_LEVEL:%d,%d", &rxnbr, &ival);
-			if (rxnbr == 0) {
-				slice_0.sql_level = ival;
-			} else {
-				slice_1.sql_level = ival;
+
+	int to_int() {
+		int val = 0;
+		bool neg = false;
+		if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+		while (p < end && *p >= '0' && *p <= '9')
+			val = val * 10 + (*p++ - '0');
+		next();
+		return neg ? -val : val;
+	}
+
+	float to_float() {
+		double val = 0, scale = 1;
+		bool neg = false;
+		if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+		while (p < end && *p >= '0' && *p <= '9')
+			val = val * 10 + (*p++ - '0');
+		if (p < end && *p == '.') {
+			p++;
+			while (p < end && *p >= '0' && *p <= '9') {
+				scale /= 10;
+				val += (*p++ - '0') * scale;
 			}
 		}
-		else if ((p = rx.find("DRIVE:")) != std::string::npos) { // drive:100;
-			sscanf(rx.substr(p).c_str(), "DRIVE:%d", &ival);
-			slice_0.pwr = ival;
+		next();
+		return neg ? -val : val;
+	}
+
+	bool to_bool() {
+		bool val = (end - p >= 4 && strncasecmp(p, "true", 4) == 0);
+		next();
+		return val;
+	}
+
+	// the rest of the arguments, upper case and ending in the ';' of the
+	// command; the drivers match it against tables such as "-25,25;"
+	std::string rest() {
+		std::string val(p, end - p);
+		for (size_t n = 0; n < val.length(); n++)
+			val[n] = toupper(val[n] & 0xFF);
+		val += ';';
+		p = end;
+		return val;
+	}
+};
+
+static inline TCI_VALS &tci_slice(int rxnbr)
+{
+	return rxnbr == 0 ? slice_0 : slice_1;
+}
+
+static void tci_rx_smeter(TCI_ARGS &args) // rx_smeter:0,0,-93;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	int vfo = args.to_int();
+	int ival = args.to_int();
+	if (vfo == 0) slice.A.smeter = ival;
+	else          slice.B.smeter = ival;
+}
+
+static void tci_vfo(TCI_ARGS &args) // vfo:0,0,7032050;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	int vfo = args.to_int();
+	int ival = args.to_int();
+	if (vfo == 0) slice.A.freq = ival;
+	else          slice.B.freq = ival;
+}
+
+static void tci_dds(TCI_ARGS &args) // dds:1,14070000;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.dds = args.to_int();
+}
+
+static void tci_rx_filter_band(TCI_ARGS &args) // rx_filter_band:0,-600,600;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.A.bw = slice.B.bw = args.rest();
+}
+
+static void tci_modulation(TCI_ARGS &args) // modulation:0,cw;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.A.mod = slice.B.mod = args.rest();
+}
+
+static void tci_trx(TCI_ARGS &args) // trx:0,true;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.ptt = args.to_bool();
+}
+
+static void tci_split_enable(TCI_ARGS &args) // split_enable:0,false;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.split = args.to_bool();
+}
+
+static void tci_volume(TCI_ARGS &args) // volume:-16;
+{
+	slice_0.vol = args.to_int();
+}
+
+static void tci_sql_enable(TCI_ARGS &args) // sql_enable:1,false;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.sql = args.to_bool();
+}
+
+static void tci_sql_level(TCI_ARGS &args) // sql_level:0,-79;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.sql_level = args.to_int();
+}
+
+static void tci_drive(TCI_ARGS &args) // drive:100;
+{
+	slice_0.pwr = args.to_int();
+}
+
+static void tci_tune(TCI_ARGS &args) // tune:0,false;
+{
+	TCI_VALS &slice = tci_slice(args.to_int());
+	slice.tune = args.to_bool();
+}
+
+static void tci_tx_power(TCI_ARGS &args) // tx_power:4.3;
+{
+	slice_0.tx_power = args.to_float();
+}
+
+static void tci_tx_swr(TCI_ARGS &args) // tx_swr:1.3;
+{
+	slice_0.tx_swr = args.to_float();
+}
+
+struct TCI_COMMAND {
+	const char *name;
+	void (*handler)(TCI_ARGS &);
+	bool trace;
+};
+
+static TCI_COMMAND tci_commands[] = {
+	{ "rx_smeter",      tci_rx_smeter,      false },
+	{ "vfo",            tci_vfo,            true },
+	{ "dds",            tci_dds,            true },
+	{ "rx_filter_band", tci_rx_filter_band, true },
+	{ "modulation",     tci_modulation,     true },
+	{ "trx",            tci_trx,            true },
+	{ "split_enable",   tci_split_enable,   true },
+	{ "volume",         tci_volume,         true },
+	{ "sql_enable",     tci_sql_enable,     true },
+	{ "sql_level",      tci_sql_level,      true },
+	{ "drive",          tci_drive,          true },
+	{ "tune",           tci_tune,           true },
+	{ "tx_power",       tci_tx_power,       true },
+	{ "tx_swr",         tci_tx_swr,         true },
+};
+
+static const size_t TCI_NCOMMANDS = sizeof(tci_commands) / sizeof(*tci_commands);
+
+// the hash table size, a power of two, and the seed for which the names
+// all hash to different slots; the seed is found by tci_hash_init
+#define TCI_HASH_SIZE 64
+static unsigned int tci_seed = 0;
+static TCI_COMMAND *tci_table[TCI_HASH_SIZE];
+
+static inline unsigned int tci_hash(unsigned int seed, const char *name, size_t len)
+{
+	unsigned int h = 2166136261u ^ seed;
+	for (size_t n = 0; n < len; n++)
+		h = (h ^ (unsigned char)tolower(name[n] & 0xFF)) * 16777619u;
+	return (h ^ (h >> 15)) & (TCI_HASH_SIZE - 1);
+}
+
+static void tci_hash_init()
+{
+	if (tci_table[tci_hash(tci_seed, tci_commands[0].name, strlen(tci_commands[0].name))])
+		return;
+	for (unsigned int seed = 0; ; seed++) {
+		memset(tci_table, 0, sizeof(tci_table));
+		size_t n = 0;
+		for (n = 0; n < TCI_NCOMMANDS; n++) {
+			unsigned int h = tci_hash(seed, tci_commands[n].name, strlen(tci_commands[n].name));
+			if (tci_table[h]) break;
+			tci_table[h] = &tci_commands[n];
 		}
-		else if ((p = rx.find("TUNE:")) != std::string::npos) { // tune:0,false;
-			sscanf(rx.substr(p).c_str(), "TUNE:%d,%s", &rxnbr, szstr);
-			str = szstr;
-			if (rxnbr == 0) {
-				slice_0.tune = (str == "TRUE;");
-			} else {
-				slice_1.tune = (str == "TRUE;");
-			}
+		if (n == TCI_NCOMMANDS) {
+			tci_seed = seed;
+			return;
 		}
-		else if ((p = rx.find("TX_POWER:")) != std::string::npos) { // tx_power:4.3;
-			sscanf(rx.substr(p).c_str(), "TX_POWER:%f", &fval);
-			slice_0.tx_power = fval;
+	}
+}
+
+static TCI_COMMAND *tci_lookup(const char *name, size_t len)
+{
+	TCI_COMMAND *cmd = tci_table[tci_hash(tci_seed, name, len)];
+	if (cmd && strlen(cmd->name) == len && strncasecmp(cmd->name, name, len) == 0)
+		return cmd;
+	return NULL;
+}
+
+void handle_frame(const char *msg, size_t len)
+{
+	cat_capture(CAP_TCI, CAP_RX, msg, len);
+
+#ifdef TCI_DEBUG
+std::cout << "R: " << std::string(msg, len) << std::endl;
+#endif
+
+	const char *end = msg + len;
+	const char *p = msg;
+	while (p < end) {
+		const char *colon = p;
+		while (colon < end && *colon != ':' && *colon != ';') colon++;
+		const char *semi = colon;
+		while (semi < end && *semi != ';') semi++;
+
+		TCI_COMMAND *cmd = tci_lookup(p, colon - p);
+		if (!cmd || cmd->trace) {
+			std::string trace(p, semi - p);
+			tci_trace(2, "PARSE:", trace.c_str());
 		}
-		else if ((p = rx.find("TX_SWR:")) != std::string::npos) { // tx_swr:1.3;
-			sscanf(rx.substr(p).c_str(), "TX_SWR:%f", &fval);
-			slice_0.tx_swr = fval;
+		if (cmd && colon < semi) {
+			TCI_ARGS args(colon + 1, semi);
+			cmd->handler(args);
 		}
+
+		p = semi + 1;
+		while (p < end && (*p == '\r' || *p == '\n' || *p == ' ')) p++;
 	}
 }
 
+void handle_message(const std::string & message)
+{
+	handle_frame(message.c_str(), message.length());
+}
+
 static WebSocket::pointer ws = (WebSocket::pointer)0;
 
 static bool tci_run = true;
@@ -231,11 +376,12 @@ void *tci_loop(void *)
 				if (send_txt.find("rx_smeter") == std::string::npos)
 					tci_trace(2, "SEND:", send_txt.c_str());
 				ws->send(send_txt);
+				cat_capture(CAP_TCI, CAP_TX, send_txt.c_str(), send_txt.length());
 				MilliSleep(1);
 			}
 		}
 		ws->poll();
-		ws->dispatch(handle_message);
+		ws->dispatchFrame(handle_frame);
 		MilliSleep(5);
 	}
 	return NULL;
@@ -248,6 +394,8 @@ void tci_open(std::string address, std::string port)
 
 	if (ws) tci_close();
 
+	tci_hash_init();
+
 	ws = WebSocket::from_url(url);
 
 	if (ws && (ws->getReadyState() != WebSocket::CLOSED)) {
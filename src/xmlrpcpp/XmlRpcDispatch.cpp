@@ -23,6 +23,7 @@
 
 #include <errno.h>
 #include <math.h>
+#include <string.h>
 
 #if defined(__FreeBSD__) || defined(__OpenBSD__)
 #	ifdef USE_FTIME
@@ -43,22 +44,113 @@
 # endif
 #else
 # include <sys/time.h>
+# include <unistd.h>
+# include <fcntl.h>
 #endif  // _WINDOWS
 
+#if defined(__linux__)
+# define USE_EPOLL
+# include <sys/epoll.h>
+#endif
+
 
 using namespace XmlRpc;
 
 
+#ifdef USE_EPOLL
+static unsigned epollEvents(unsigned mask)
+{
+  unsigned events = 0;
+  if (mask & XmlRpcDispatch::ReadableEvent) events |= EPOLLIN;
+  if (mask & XmlRpcDispatch::WritableEvent) events |= EPOLLOUT;
+  if (mask & XmlRpcDispatch::Exception)     events |= EPOLLPRI;
+  return events;
+}
+
+static void epollControl(int epfd, int op, int fd, unsigned mask)
+{
+  struct epoll_event ev;
+  ev.events = epollEvents(mask);
+  ev.data.fd = fd;
+  if (epoll_ctl(epfd, op, fd, &ev) == 0) return;
+  if (op == EPOLL_CTL_ADD && errno == EEXIST)
+    epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev);
+  else if (op == EPOLL_CTL_MOD && errno == ENOENT)
+    epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+}
+#endif
+
+
 XmlRpcDispatch::XmlRpcDispatch()
 {
   _endTime = -1.0;
   _doClear = false;
   _inWork = false;
+  _wakeFd[0] = _wakeFd[1] = -1;
+  _epollFd = -1;
+  pthread_mutex_init(&_resumeMutex, NULL);
+
+#ifndef _WINDOWS
+  if (pipe(_wakeFd) == 0)
+  {
+    fcntl(_wakeFd[0], F_SETFL, fcntl(_wakeFd[0], F_GETFL) | O_NONBLOCK);
+    fcntl(_wakeFd[1], F_SETFL, fcntl(_wakeFd[1], F_GETFL) | O_NONBLOCK);
+  }
+  else
+    _wakeFd[0] = _wakeFd[1] = -1;
+#endif
+
+#ifdef USE_EPOLL
+  _epollFd = epoll_create(16);
+  if (_epollFd >= 0 && _wakeFd[0] >= 0)
+    epollControl(_epollFd, EPOLL_CTL_ADD, _wakeFd[0], ReadableEvent);
+#endif
 }
 
 
 XmlRpcDispatch::~XmlRpcDispatch()
 {
+#ifndef _WINDOWS
+  if (_epollFd >= 0) ::close(_epollFd);
+  if (_wakeFd[0] >= 0) ::close(_wakeFd[0]);
+  if (_wakeFd[1] >= 0) ::close(_wakeFd[1]);
+#else
+  if (_wakeFd[0] >= 0) closesocket((SOCKET)_wakeFd[0]);
+#endif
+  pthread_mutex_destroy(&_resumeMutex);
+}
+
+
+// Windows has no pipe that select() accepts; a udp socket connected to
+// itself on the loopback interface serves as both ends.
+bool
+XmlRpcDispatch::enableResume()
+{
+#if defined(_WINDOWS)
+  if (_wakeFd[0] >= 0) return true;
+
+  SOCKET s = ::socket(AF_INET, SOCK_DGRAM, 0);
+  if (s == INVALID_SOCKET) return false;
+
+  struct sockaddr_in addr;
+  int len = sizeof(addr);
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  u_long nonblocking = 1;
+  if (::bind(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      getsockname(s, (struct sockaddr *)&addr, &len) != 0 ||
+      ::connect(s, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+      ioctlsocket(s, FIONBIO, &nonblocking) != 0)
+  {
+    XmlRpcUtil::error("XmlRpcDispatch::enableResume: no wake up socket (%d).", WSAGetLastError());
+    closesocket(s);
+    return false;
+  }
+  _wakeFd[0] = _wakeFd[1] = (int)s;
+#endif
+  return _wakeFd[1] >= 0;
 }
 
 // Monitor this source for the specified events and call its event handler
@@ -66,7 +158,12 @@ XmlRpcDispatch::~XmlRpcDispatch()
 void
 XmlRpcDispatch::addSource(XmlRpcSource* source, unsigned mask)
 {
-  _sources.push_back(MonitoredSource(source, mask));
+  int fd = (int)source->getfd();
+  _sources.push_back(MonitoredSource(source, mask, fd));
+#ifdef USE_EPOLL
+  if (_epollFd >= 0 && fd >= 0)
+    epollControl(_epollFd, EPOLL_CTL_ADD, fd, mask);
+#endif
 }
 
 // Stop monitoring this source. Does not close the source.
@@ -76,6 +173,10 @@ XmlRpcDispatch::removeSource(XmlRpcSource* source)
   for (SourceList::iterator it=_sources.begin(); it!=_sources.end(); ++it)
     if (it->getSource() == source)
     {
+#ifdef USE_EPOLL
+      if (_epollFd >= 0 && it->_fd >= 0)
+        epoll_ctl(_epollFd, EPOLL_CTL_DEL, it->_fd, NULL);
+#endif
       _sources.erase(it);
       break;
     }
@@ -90,11 +191,59 @@ XmlRpcDispatch::setSourceEvents(XmlRpcSource* source, unsigned eventMask)
     if (it->getSource() == source)
     {
       it->getMask() = eventMask;
+#ifdef USE_EPOLL
+      if (_epollFd >= 0 && it->_fd >= 0)
+        epollControl(_epollFd, EPOLL_CTL_MOD, it->_fd, eventMask);
+#endif
       break;
     }
 }
 
 
+// Queue a source for the work loop to monitor again and wake the loop.
+// Called from worker threads, so the source list itself is not touched.
+bool
+XmlRpcDispatch::resumeSource(XmlRpcSource* source, unsigned eventMask)
+{
+  if (_wakeFd[1] < 0) return false;
+
+  pthread_mutex_lock(&_resumeMutex);
+  _resumed.push_back(MonitoredSource(source, eventMask));
+  pthread_mutex_unlock(&_resumeMutex);
+
+  char c = 0;
+#ifndef _WINDOWS
+  if (write(_wakeFd[1], &c, 1) < 0 && errno != EAGAIN)
+    XmlRpcUtil::error("XmlRpcDispatch::resumeSource: wake up failed (%d).", errno);
+#else
+  if (send((SOCKET)_wakeFd[1], &c, 1, 0) == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK)
+    XmlRpcUtil::error("XmlRpcDispatch::resumeSource: wake up failed (%d).", WSAGetLastError());
+#endif
+  return true;
+}
+
+
+// Drain the wake up pipe and monitor the queued sources again
+void
+XmlRpcDispatch::addResumed()
+{
+  char buf[64];
+#ifndef _WINDOWS
+  while (read(_wakeFd[0], buf, sizeof(buf)) > 0) ;
+#else
+  while (recv((SOCKET)_wakeFd[0], buf, sizeof(buf), 0) > 0) ;
+#endif
+
+  SourceList resumed;
+  pthread_mutex_lock(&_resumeMutex);
+  _resumed.swap(resumed);
+  pthread_mutex_unlock(&_resumeMutex);
+
+  for (SourceList::iterator it=resumed.begin(); it!=resumed.end(); ++it)
+    addSource(it->getSource(), it->getMask());
+}
+
+
 
 // Watch current set of sources and process events
 void
@@ -202,6 +351,86 @@ XmlRpcDispatch::getTime()
 }
 
 
+// Call the event handler of a source once per event type signalled
+void
+XmlRpcDispatch::processEvents(XmlRpcSource* src, unsigned events)
+{
+  unsigned newMask = 0;
+  if (events & ReadableEvent) newMask |= src->handleEvent(ReadableEvent);
+  if (events & WritableEvent) newMask |= src->handleEvent(WritableEvent);
+  if (events & Exception)     newMask |= src->handleEvent(Exception);
+
+  if (newMask)
+  {
+    setSourceEvents(src, newMask);
+  }
+  else       // Stop monitoring this one
+  {
+    removeSource(src);
+
+    if ( ! src->getKeepOpen())
+      src->close();
+  }
+}
+
+
+#ifdef USE_EPOLL
+
+// Wait for I/O on any source, timeout, or interrupt signal.
+// epoll version; cost is independent of the number of idle connections.
+bool
+XmlRpcDispatch::waitForAndProcessEvents(double timeoutSeconds)
+{
+  struct epoll_event events[32];
+
+  int msec = (_endTime < 0.0) ? -1 : (int)floor(timeoutSeconds * 1000.0);
+  int nEvents = epoll_wait(_epollFd, events, 32, msec);
+
+  if (nEvents < 0 && errno != EINTR)
+  {
+    XmlRpcUtil::error("Error in XmlRpcDispatch::work: error in epoll_wait (%d).", errno);
+    return false;
+  }
+
+  bool wake = false;
+  for (int i = 0; i < nEvents; ++i)
+  {
+    int fd = events[i].data.fd;
+    if (fd == _wakeFd[0])
+    {
+      wake = true;
+      continue;
+    }
+
+    // Look the source up again, an earlier handler may have removed it
+    SourceList::iterator it;
+    for (it = _sources.begin(); it != _sources.end(); ++it)
+      if (it->_fd == fd) break;
+    if (it == _sources.end()) continue;
+
+    XmlRpcSource* src = it->getSource();
+    unsigned mask = it->getMask();
+    unsigned happened = 0;
+    if (events[i].events & EPOLLIN)  happened |= ReadableEvent;
+    if (events[i].events & EPOLLOUT) happened |= WritableEvent;
+    if (events[i].events & EPOLLPRI) happened |= Exception;
+    // select reports errors and hang ups as readable / writable
+    if (events[i].events & (EPOLLERR | EPOLLHUP))
+      happened |= mask & (ReadableEvent | WritableEvent);
+    happened &= mask;
+
+    if (happened)
+      processEvents(src, happened);
+  }
+
+  if (wake)
+    addResumed();
+
+  return true;
+}
+
+#else
+
 // Wait for I/O on any source, timeout, or interrupt signal.
 bool
 XmlRpcDispatch::waitForAndProcessEvents(double timeoutSeconds)
@@ -221,6 +450,11 @@ XmlRpcDispatch::waitForAndProcessEvents(double timeoutSeconds)
     if (it->getMask() & Exception)     FD_SET(fd, &excFd);
     if (it->getMask() && fd > maxFd)   maxFd = fd;
   }
+  if (_wakeFd[0] >= 0)
+  {
+    FD_SET(_wakeFd[0], &inFd);
+    if ((XmlRpcSocket::Socket)_wakeFd[0] > maxFd) maxFd = _wakeFd[0];
+  }
 
   // Check for events
   int nEvents;
@@ -251,43 +485,21 @@ XmlRpcDispatch::waitForAndProcessEvents(double timeoutSeconds)
 
     if (fd <= maxFd)
     {
-      // handleEvent is called once per event type signalled
-      unsigned newMask = 0;
-      int nset = 0;
-      if (FD_ISSET(fd, &inFd))
-      {
-        newMask |= src->handleEvent(ReadableEvent);
-        ++nset;
-      }
-      if (FD_ISSET(fd, &outFd))
-      {
-        newMask |= src->handleEvent(WritableEvent);
-        ++nset;
-      }
-      if (FD_ISSET(fd, &excFd))
-      {
-        newMask |= src->handleEvent(Exception);
-        ++nset;
-      }
+      unsigned happened = 0;
+      if (FD_ISSET(fd, &inFd))  happened |= ReadableEvent;
+      if (FD_ISSET(fd, &outFd)) happened |= WritableEvent;
+      if (FD_ISSET(fd, &excFd)) happened |= Exception;
 
       // Some event occurred
-      if (nset)
-      {
-        // This bit is not terribly efficient if many connections are active...
-        if (newMask)
-        {
-          setSourceEvents(src, newMask);
-        }
-        else       // Stop monitoring this one
-        {
-          removeSource(src);
-
-          if ( ! src->getKeepOpen())
-            src->close();
-        }
-      }
+      if (happened)
+        processEvents(src, happened);
     }
   }
 
+  if (_wakeFd[0] >= 0 && nEvents > 0 && FD_ISSET(_wakeFd[0], &inFd))
+    addResumed();
+
   return true;
 }
+
+#endif // USE_EPOLL
@@ -24,6 +24,8 @@
 
 #include <vector>
 
+#include "threads.h"
+
 namespace XmlRpc {
 
   // An RPC source represents a file descriptor to monitor
@@ -58,6 +60,19 @@ namespace XmlRpc {
     //! Modify the types of events to watch for on this source
     void setSourceEvents(XmlRpcSource* source, unsigned eventMask);
 
+    //! Return a source removed by its event handler (with keep open set)
+    //! to the monitored list.  May be called from any thread; the work
+    //! loop is woken and adds the source before it next waits for events.
+    //!  @param source The source to monitor again
+    //!  @param eventMask Which event types to watch for.
+    //! Returns false if the dispatcher cannot be woken.
+    bool resumeSource(XmlRpcSource* source, unsigned eventMask);
+
+    //! Open the wake up channel used by resumeSource if it is not open.
+    //! On Windows this is a loopback socket, made once winsock has been
+    //! initialized.  Returns false if sources cannot be resumed.
+    bool enableResume();
+
 
     //! Watch current set of sources and process events for the specified
     //! duration (in seconds, -1 implies wait forever, or until exit is called)
@@ -74,6 +89,12 @@ namespace XmlRpc {
     //! Wait for I/O on any source, timeout, or interrupt signal.
     bool waitForAndProcessEvents(double timeoutSeconds);
 
+    //! Call the event handler of a source and act on the returned mask
+    void processEvents(XmlRpcSource* src, unsigned events);
+
+    //! Add the sources queued by resumeSource
+    void addResumed();
+
 
     //! Returns current time in seconds since something
     double getTime();
@@ -81,11 +102,12 @@ namespace XmlRpc {
     // A source to monitor and what to monitor it for
     struct MonitoredSource
     {
-      MonitoredSource(XmlRpcSource* src, unsigned mask) : _src(src), _mask(mask) {}
+      MonitoredSource(XmlRpcSource* src, unsigned mask, int fd = -1) : _src(src), _mask(mask), _fd(fd) {}
       XmlRpcSource* getSource() const { return _src; }
       unsigned& getMask() { return _mask; }
       XmlRpcSource* _src;
       unsigned _mask;
+      int _fd;    // descriptor registered for this source
     };
 
     // A list of sources to monitor
@@ -100,6 +122,17 @@ namespace XmlRpc {
     bool _doClear;
     bool _inWork;
 
+    // Sources waiting to be returned to the monitored list
+    SourceList _resumed;
+    pthread_mutex_t _resumeMutex;
+
+    // Self pipe (a loopback udp socket on Windows) used to wake the
+    // work loop, -1 if not available
+    int _wakeFd[2];
+
+    // epoll instance (linux), -1 if select is used
+    int _epollFd;
+
   };
 } // namespace XmlRpc
 
@@ -29,8 +29,58 @@
 
 using namespace XmlRpc;
 
-std::string XmlRpc::request_str = "";
-std::string XmlRpc::client_id = "";
+// Client id of the request being executed, one per thread as requests
+// may execute on several worker threads at once
+static pthread_key_t client_id_key;
+static pthread_once_t client_id_once = PTHREAD_ONCE_INIT;
+
+static void free_thread_string(void *p)
+{
+  delete (std::string *)p;
+}
+
+static void make_client_id_key()
+{
+  pthread_key_create(&client_id_key, free_thread_string);
+}
+
+static std::string& thread_client_id()
+{
+  pthread_once(&client_id_once, make_client_id_key);
+  std::string *id = (std::string *)pthread_getspecific(client_id_key);
+  if (!id) {
+    id = new std::string("UNKNOWN");
+    pthread_setspecific(client_id_key, id);
+  }
+  return *id;
+}
+
+std::string XmlRpc::get_client_id()
+{
+  return thread_client_id();
+}
+
+// Scratch buffer for response bodies, one per thread; it is kept between
+// requests so that generating a response does not allocate.
+static pthread_key_t body_key;
+static pthread_once_t body_once = PTHREAD_ONCE_INIT;
+
+static void make_body_key()
+{
+  pthread_key_create(&body_key, free_thread_string);
+}
+
+static std::string& thread_body()
+{
+  pthread_once(&body_once, make_body_key);
+  std::string *body = (std::string *)pthread_getspecific(body_key);
+  if (!body) {
+    body = new std::string;
+    body->reserve(1024);
+    pthread_setspecific(body_key, body);
+  }
+  return *body;
+}
 
 // Static data
 const char XmlRpcServer::METHODNAME_TAG[] = "methodName";
@@ -50,15 +100,23 @@ XmlRpcServer::XmlRpcServer()
   _introspectionEnabled = false;
   _listMethods = 0;
   _methodHelp = 0;
+  _stopWorkers = false;
+  pthread_mutex_init(&_jobMutex, NULL);
+  pthread_cond_init(&_jobCond, NULL);
 }
 
 
 XmlRpcServer::~XmlRpcServer()
 {
+  stopWorkers();
+
   this->shutdown();
   _methods.clear();
   delete _listMethods;
   delete _methodHelp;
+
+  pthread_cond_destroy(&_jobCond);
+  pthread_mutex_destroy(&_jobMutex);
 }
 
 
@@ -251,6 +309,88 @@ XmlRpcServer::shutdown()
 }
 
 
+// Start the worker threads.  Call once the server socket is bound: the
+// dispatcher's wake up channel, which returns connections from the
+// workers, needs winsock to be initialized on Windows.
+void
+XmlRpcServer::setWorkers(int n)
+{
+  if ( ! _disp.enableResume())
+  {
+    XmlRpcUtil::error("XmlRpcServer::setWorkers: requests execute on the dispatcher thread.");
+    return;
+  }
+  while (int(_workers.size()) < n)
+  {
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, workerLoop, this) != 0)
+    {
+      XmlRpcUtil::error("XmlRpcServer::setWorkers: could not create worker thread.");
+      break;
+    }
+    _workers.push_back(tid);
+  }
+}
+
+
+// The workers finish the request in hand and exit.  The worker list is
+// kept, so that the dispatcher goes on queueing rather than executing.
+void
+XmlRpcServer::stopWorkers()
+{
+  pthread_mutex_lock(&_jobMutex);
+  bool stopped = _stopWorkers;
+  _stopWorkers = true;
+  pthread_cond_broadcast(&_jobCond);
+  pthread_mutex_unlock(&_jobMutex);
+  if (stopped) return;
+  for (size_t i = 0; i < _workers.size(); ++i)
+    pthread_join(_workers[i], NULL);
+}
+
+
+// Hand a connection to the workers.  The connection keeps its socket open
+// while it is out of the dispatcher.
+bool
+XmlRpcServer::queueRequest(XmlRpcServerConnection* sc)
+{
+  if (_workers.empty()) return false;
+
+  sc->setKeepOpen(true);
+  pthread_mutex_lock(&_jobMutex);
+  _jobs.push_back(sc);
+  pthread_cond_signal(&_jobCond);
+  pthread_mutex_unlock(&_jobMutex);
+  return true;
+}
+
+
+void *
+XmlRpcServer::workerLoop(void *arg)
+{
+  XmlRpcServer *server = (XmlRpcServer *)arg;
+
+  for (;;)
+  {
+    pthread_mutex_lock(&server->_jobMutex);
+    while (server->_jobs.empty() && !server->_stopWorkers)
+      pthread_cond_wait(&server->_jobCond, &server->_jobMutex);
+    if (server->_stopWorkers)
+    {
+      pthread_mutex_unlock(&server->_jobMutex);
+      break;
+    }
+    XmlRpcServerConnection *sc = server->_jobs.front();
+    server->_jobs.pop_front();
+    pthread_mutex_unlock(&server->_jobMutex);
+
+    sc->executeQueued();
+    server->_disp.resumeSource(sc, XmlRpcDispatch::WritableEvent);
+  }
+  return NULL;
+}
+
+
 // Introspection support
 static const std::string LIST_METHODS("system.listMethods");
 static const std::string METHOD_HELP("system.methodHelp");
@@ -339,28 +479,33 @@ XmlRpcServer::listMethods(XmlRpcValue& result)
 // Parse the request, run the method, generate a response string.
 std::string
 XmlRpcServer::executeRequest(std::string const& request)
+{
+  std::string response;
+  executeRequest(request, response);
+  return response;
+}
+
+void
+XmlRpcServer::executeRequest(std::string const& request, std::string& response)
 {
   XmlRpcValue params, resultValue;
   std::string methodName = parseRequest(request, params);
   XmlRpcUtil::log(2, "XmlRpcServer::executeRequest: server calling method '%s'", 
                     methodName.c_str());
 
-  std::string response;
   try {
 
     if ( ! executeMethod(methodName, params, resultValue) &&
          ! executeMulticall(methodName, params, resultValue))
       response = generateFaultResponse(methodName + ": unknown method name");
     else
-      response = generateResponse(resultValue.toXml());
+      generateResponse(resultValue, response);
 
   } catch (const XmlRpcException& fault) {
     XmlRpcUtil::log(2, "XmlRpcServer::executeRequest: fault %s.",
                     fault.getMessage().c_str()); 
     response = generateFaultResponse(fault.getMessage(), fault.getCode());
   }
-
-  return response;
 }
 
 // Parse the method name and the argument values from the request.
@@ -372,18 +517,17 @@ XmlRpcServer::parseRequest(std::string const& request, XmlRpcValue& params)
 {
   std::string methodName;
 
-  XmlRpc::request_str = request;
-
-  XmlRpc::client_id = "UNKNOWN";
-  size_t id_ptr = XmlRpc::request_str.find(id_str);
+  std::string& client_id = thread_client_id();
+  client_id = "UNKNOWN";
+  size_t id_ptr = request.find(id_str);
   if (id_ptr != std::string::npos) {
     id_ptr += id_str.length();
-    size_t end_id_ptr = XmlRpc::request_str.find("?", id_ptr);
+    size_t end_id_ptr = request.find("?", id_ptr);
     if (end_id_ptr != std::string::npos) {
-      XmlRpc::client_id = XmlRpc::request_str.substr(id_ptr, end_id_ptr - id_ptr);
-      if (XmlRpc::client_id[0] == '"') XmlRpc::client_id.erase(0,1);
-      if (XmlRpc::client_id[XmlRpc::client_id.length() -1] == '"')
-        XmlRpc::client_id.erase(XmlRpc::client_id.length() - 1);
+      client_id = request.substr(id_ptr, end_id_ptr - id_ptr);
+      if (!client_id.empty() && client_id[0] == '"') client_id.erase(0,1);
+      if (!client_id.empty() && client_id[client_id.length() -1] == '"')
+        client_id.erase(client_id.length() - 1);
     }
   }
 
@@ -403,7 +547,7 @@ XmlRpcServer::parseRequest(std::string const& request, XmlRpcValue& params)
       }
       else
       {
-        params[nArgs++] = XmlRpcValue(request, &offset);
+        params[nArgs++].fromXml(request, &offset);
         (void) XmlRpcUtil::nextTagIsEnd(PARAM_TAG, request, &offset);
       }
     }
@@ -424,6 +568,8 @@ XmlRpcServer::executeMethod(const std::string& methodName,
 
   if ( ! method) return false;
 
+  // Methods run on the worker threads side by side; a method that talks
+  // to the transceiver holds the serial port lock itself
   method->execute(params, result);
 
   // Ensure a valid result value
@@ -502,11 +648,44 @@ XmlRpcServer::generateResponse(std::string const& resultXml)
 }
 
 
+// Create the response in the caller's buffer.  The body is built in a
+// per thread scratch buffer as its length is needed for the header.
+void
+XmlRpcServer::generateResponse(XmlRpcValue const& result, std::string& response)
+{
+  static const char RESPONSE_1[] = 
+    "<?xml version=\"1.0\"?>\r\n"
+    "<methodResponse><params><param>\r\n\t";
+  static const char RESPONSE_2[] =
+    "\r\n</param></params></methodResponse>\r\n";
+
+  std::string& body = thread_body();
+  body.clear();
+  body.append(RESPONSE_1);
+  result.toXml(body);
+  body.append(RESPONSE_2);
+
+  response.clear();
+  generateHeader(body.size(), response);
+  response.append(body);
+
+  XmlRpcUtil::log(5, "XmlRpcServer::generateResponse:\n%s\n", response.c_str());
+}
+
+
 // Prepend http headers
 std::string
 XmlRpcServer::generateHeader(std::string const& body)
 {
-  std::string header = 
+  std::string header;
+  generateHeader(body.size(), header);
+  return header;
+}
+
+void
+XmlRpcServer::generateHeader(size_t length, std::string& header)
+{
+  header += 
     "HTTP/1.1 200 OK\r\n"
     "Server: ";
   header += XMLRPC_VERSION;
@@ -515,9 +694,8 @@ XmlRpcServer::generateHeader(std::string const& body)
     "Content-length: ";
 
   char buffLen[40];
-  sprintf(buffLen,"%d\r\n\r\n", static_cast<int>(body.size()));
-
-  return header + buffLen;
+  snprintf(buffLen, sizeof(buffLen), "%d\r\n\r\n", static_cast<int>(length));
+  header += buffLen;
 }
 
 
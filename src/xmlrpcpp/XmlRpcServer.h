@@ -23,6 +23,8 @@
 #endif
 
 #include <map>
+#include <deque>
+#include <vector>
 #include <string>
 
 
@@ -31,8 +33,8 @@
 
 namespace XmlRpc {
 
-	extern std::string request_str;
-	extern std::string client_id;
+	//! Client id of the request being executed by the calling thread
+	extern std::string get_client_id();
 
   // An abstract class supporting XML RPC methods
   class XmlRpcServerMethod;
@@ -84,6 +86,22 @@ namespace XmlRpc {
     //! Close all connections with clients and the socket file descriptor
     void shutdown();
 
+    //! Execute requests on n worker threads so that one slow method does
+    //! not stall every client.  Methods run side by side and do their own
+    //! locking.  Call after bindAndListen() and before work().
+    void setWorkers(int n);
+
+    //! Wait for the requests being executed and stop the worker threads.
+    //! Requests received later are not executed.
+    void stopWorkers();
+
+    //! Number of worker threads running
+    int getWorkers() const { return int(_workers.size()); }
+
+    //! Queue a connection with a complete request for a worker thread.
+    //! Returns false if there are no workers; the caller executes it.
+    bool queueRequest(XmlRpcServerConnection* sc);
+
     //! Introspection support
     void listMethods(XmlRpcValue& result);
 
@@ -92,6 +110,10 @@ namespace XmlRpc {
     //! Returns a fault response if an error occurs during method execution.
     virtual std::string executeRequest(std::string const& request);
 
+    //! As above, writing the response into the caller's buffer.  A buffer
+    //! kept by the connection is reused from request to request.
+    virtual void executeRequest(std::string const& request, std::string& response);
+
 
     // XmlRpcSource interface implementation
 
@@ -137,15 +159,25 @@ namespace XmlRpc {
     //! System.multicall implementation
     bool executeMulticall(const std::string& methodName, XmlRpcValue& params, XmlRpcValue& result);
 
+    //! Worker thread; executes queued requests and returns the connections
+    //! to the dispatcher.
+    static void *workerLoop(void *arg);
+
     //! Construct a response from the result XML.
     std::string generateResponse(std::string const& resultXml);
 
+    //! Construct a response from the result value in response.
+    void generateResponse(XmlRpcValue const& result, std::string& response);
+
     //! Construct a fault response.
     std::string generateFaultResponse(std::string const& msg, int errorCode = -1);
 
     //! Return the appropriate headers for the response.
     std::string generateHeader(std::string const& body);
 
+    //! Append the headers for a response body of length bytes.
+    void generateHeader(size_t length, std::string& header);
+
 
     
     //! Whether the introspection API is supported by this server
@@ -166,6 +198,13 @@ namespace XmlRpc {
     //! Return help string for a specified method (only available if introspection is enabled)
     XmlRpcServerMethod* _methodHelp;
 
+    //! Worker threads and the connections waiting for them
+    std::vector<pthread_t> _workers;
+    std::deque<XmlRpcServerConnection*> _jobs;
+    pthread_mutex_t _jobMutex;
+    pthread_cond_t _jobCond;
+    bool _stopWorkers;
+
   };
 } // namespace XmlRpc
 
@@ -63,12 +63,22 @@ XmlRpcServerConnection::~XmlRpcServerConnection()
 unsigned
 XmlRpcServerConnection::handleEvent(unsigned /*eventType*/)
 {
+  // back from a worker thread
+  if (getKeepOpen())
+    setKeepOpen(false);
+
   if (_connectionState == READ_HEADER)
     if ( ! readHeader()) return 0;
 
   if (_connectionState == READ_REQUEST)
     if ( ! readRequest()) return 0;
 
+  // Stop monitoring the socket while a worker executes the request
+  if (_connectionState == EXECUTE_REQUEST) {
+    if (_server->queueRequest(this)) return 0;
+    _connectionState = WRITE_RESPONSE;
+  }
+
   if (_connectionState == WRITE_RESPONSE)
     if ( ! writeResponse()) return 0;
 
@@ -192,7 +202,7 @@ XmlRpcServerConnection::readRequest()
   else
     XmlRpcUtil::log(3, "readRequest:\n%s\n", _request.c_str());
 
-  _connectionState = WRITE_RESPONSE;
+  _connectionState = EXECUTE_REQUEST;
 
   return true;    // Continue monitoring this source
 }
@@ -234,9 +244,10 @@ XmlRpcServerConnection::writeResponse()
   // Prepare to read the next request
   if (_bytesWritten == int(_response.length()))
   {
-    _header = "";
-    _request = "";
-    _response = "";
+    // clear() keeps the storage for the next request on this connection
+    _header.clear();
+    _request.clear();
+    _response.clear();
     _connectionState = READ_HEADER;
   }
 
@@ -247,6 +258,15 @@ XmlRpcServerConnection::writeResponse()
 //! Helper method to execute the client request
 void XmlRpcServerConnection::executeRequest()
 {
-  _response = _server->executeRequest(_request);
+  _server->executeRequest(_request, _response);
+}
+
+
+// Called on a worker thread while the dispatcher is not monitoring us
+void XmlRpcServerConnection::executeQueued()
+{
+  executeRequest();
+  _bytesWritten = 0;
+  _connectionState = WRITE_RESPONSE;
 }
 
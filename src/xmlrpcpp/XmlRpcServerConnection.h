@@ -48,6 +48,10 @@ namespace XmlRpc {
     //!   @param eventType Type of IO event that occurred. @see XmlRpcDispatch::EventType.
     virtual unsigned handleEvent(unsigned eventType);
 
+    //! Executes the request on a server worker thread.  The connection is
+    //! then ready to write the response when returned to the dispatcher.
+    void executeQueued();
+
   protected:
 
     //! Reads the http header
@@ -68,7 +72,7 @@ namespace XmlRpc {
     XmlRpcServer* _server;
 
     //! Possible IO states for the connection
-    enum ServerConnectionState { READ_HEADER, READ_REQUEST, WRITE_RESPONSE };
+    enum ServerConnectionState { READ_HEADER, READ_REQUEST, EXECUTE_REQUEST, WRITE_RESPONSE };
     //! Current IO state for the connection
     ServerConnectionState _connectionState;
 
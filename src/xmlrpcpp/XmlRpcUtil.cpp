@@ -112,6 +112,21 @@ void XmlRpcUtil::error(const char* fmt, ...)
   va_end(va);
 }
 
+// Find "<tag" at or after offset without building the search string.
+// Returns the index of the '<' or npos.
+static size_t findOpenTag(const char* tag, std::string const& xml, size_t offset)
+{
+  size_t len = strlen(tag);
+  size_t i = xml.find('<', offset);
+  while (i != std::string::npos)
+  {
+    if (xml.compare(i + 1, len, tag) == 0)
+      return i;
+    i = xml.find('<', i + 1);
+  }
+  return std::string::npos;
+}
+
 // Returns true if the tag is parsed. No attributes are parsed.
 // Sets val to the contents between <tag> and </tag>, or an empty string if <tag/> is found.
 // Updates offset to char after </tag>
@@ -122,12 +137,11 @@ XmlRpcUtil::parseTag(const char* tag, std::string const& xml, int* offset, std::
   if (*offset >= int(nxml)) return false;
 
   // Find <tag (skips over anything preceeding...)
-  std::string stag = "<";
-  stag += tag;
-  size_t istart = xml.find(stag, *offset);
+  size_t istart = findOpenTag(tag, xml, *offset);
   if (istart == std::string::npos) return false;
 
-  istart += stag.length();
+  size_t len = strlen(tag);
+  istart += len + 1;
 
   // Advance istart past > or />
   bool lastSlash = false;
@@ -146,16 +160,16 @@ XmlRpcUtil::parseTag(const char* tag, std::string const& xml, int* offset, std::
   }
   else            // Find </tag>
   {
-    std::string etag = "</";
-    etag += tag;
-    etag += ">";
-    size_t iend = xml.find(etag, istart);
+    ++ istart;
+    size_t iend = xml.find("</", istart);
+    while (iend != std::string::npos &&
+           (xml.compare(iend + 2, len, tag) != 0 || iend + 2 + len >= nxml || xml[iend + 2 + len] != '>'))
+      iend = xml.find("</", iend + 2);
 
     if (iend == std::string::npos) return false;
 
-    *offset = int(iend + etag.length());
-    ++ istart;
-    val = xml.substr(istart, iend-istart);
+    *offset = int(iend + len + 3);
+    val.assign(xml, istart, iend-istart);
   }
 
   return true;
@@ -168,13 +182,11 @@ XmlRpcUtil::findTag(const char* tag, std::string const& xml, int* offset, bool*
 {
   size_t nxml = xml.length();
   if (*offset >= int(nxml)) return false;
-  std::string stag = "<";
-  stag += tag;
-  size_t istart = xml.find(stag, *offset);
+  size_t istart = findOpenTag(tag, xml, *offset);
   if (istart == std::string::npos)
     return false;
 
-  istart += stag.length();
+  istart += strlen(tag) + 1;
 
   // Advance istart past > or />, skips attribs
   bool lastSlash = false;
@@ -272,35 +284,49 @@ static const int   xmlEntLen[] = { 3,     3,     4,      5,       5 };
 std::string 
 XmlRpcUtil::xmlDecode(const std::string& encoded)
 {
-  std::string::size_type iAmp = encoded.find(AMP);
-  if (iAmp == std::string::npos)
+  if (encoded.find(AMP) == std::string::npos)
     return encoded;
 
-  std::string decoded(encoded, 0, iAmp);
-  std::string::size_type iSize = encoded.size();
-  decoded.reserve(iSize);
+  std::string decoded;
+  xmlDecode(encoded, 0, encoded.size(), decoded);
+  return decoded;
+}
+
+
+// Decode in place from the request text; no intermediate substring
+void
+XmlRpcUtil::xmlDecode(const std::string& xml, size_t offset, size_t n, std::string& raw)
+{
+  size_t iEnd = offset + n;
+  size_t iAmp = xml.find(AMP, offset);
+  if (iAmp == std::string::npos || iAmp >= iEnd)
+  {
+    raw.assign(xml, offset, n);
+    return;
+  }
+
+  raw.assign(xml, offset, iAmp - offset);
+  raw.reserve(n);
 
-  const char* ens = encoded.c_str();
-  while (iAmp != iSize) {
-    if (encoded[iAmp] == AMP && iAmp+1 < iSize) {
+  const char* ens = xml.c_str();
+  while (iAmp != iEnd) {
+    if (xml[iAmp] == AMP && iAmp+1 < iEnd) {
       int iEntity;
       for (iEntity=0; xmlEntity[iEntity] != 0; ++iEntity)
-	//if (encoded.compare(iAmp+1, xmlEntLen[iEntity], xmlEntity[iEntity]) == 0)
-	if (strncmp(ens+iAmp+1, xmlEntity[iEntity], xmlEntLen[iEntity]) == 0)
+	if (iAmp + 1 + xmlEntLen[iEntity] <= iEnd &&
+	    strncmp(ens+iAmp+1, xmlEntity[iEntity], xmlEntLen[iEntity]) == 0)
         {
-          decoded += rawEntity[iEntity];
+          raw += rawEntity[iEntity];
           iAmp += xmlEntLen[iEntity]+1;
           break;
         }
       if (xmlEntity[iEntity] == 0)    // unrecognized sequence
-        decoded += encoded[iAmp++];
+        raw += xml[iAmp++];
 
     } else {
-      decoded += encoded[iAmp++];
+      raw += xml[iAmp++];
     }
   }
-    
-  return decoded;
 }
 
 
@@ -308,12 +334,28 @@ XmlRpcUtil::xmlDecode(const std::string& encoded)
 
 std::string 
 XmlRpcUtil::xmlEncode(const std::string& raw)
+{
+  if (raw.find_first_of(rawEntity) == std::string::npos)
+    return raw;
+
+  std::string encoded;
+  xmlEncode(raw, encoded);
+  return encoded;
+}
+
+
+// Append to the caller's buffer; no allocation once it has grown
+void
+XmlRpcUtil::xmlEncode(const std::string& raw, std::string& xml)
 {
   std::string::size_type iRep = raw.find_first_of(rawEntity);
   if (iRep == std::string::npos)
-    return raw;
+  {
+    xml.append(raw);
+    return;
+  }
 
-  std::string encoded(raw, 0, iRep);
+  xml.append(raw, 0, iRep);
   std::string::size_type iSize = raw.size();
 
   while (iRep != iSize) {
@@ -321,16 +363,12 @@ XmlRpcUtil::xmlEncode(const std::string& raw)
     for (iEntity=0; rawEntity[iEntity] != 0; ++iEntity)
       if (raw[iRep] == rawEntity[iEntity])
       {
-        encoded += AMP;
-        encoded += xmlEntity[iEntity];
+        xml += AMP;
+        xml += xmlEntity[iEntity];
         break;
       }
     if (rawEntity[iEntity] == 0)
-      encoded += raw[iRep];
+      xml += raw[iRep];
     ++iRep;
   }
-  return encoded;
 }
-
-
-
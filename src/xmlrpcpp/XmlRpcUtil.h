@@ -63,9 +63,15 @@ namespace XmlRpc {
     //! Convert raw text to encoded xml.
     static std::string xmlEncode(const std::string& raw);
 
+    //! Append raw text to xml, encoding it on the way
+    static void xmlEncode(const std::string& raw, std::string& xml);
+
     //! Convert encoded xml to raw text
     static std::string xmlDecode(const std::string& encoded);
 
+    //! Decode n chars of xml starting at offset into raw, replacing its contents
+    static void xmlDecode(const std::string& xml, size_t offset, size_t n, std::string& raw);
+
 
     //! Dump messages somewhere
     static void log(int level, const char* fmt, ...);
@@ -349,20 +349,26 @@ namespace XmlRpc {
 
   // Encode the Value in xml
   std::string XmlRpcValue::toXml() const
+  {
+    std::string xml;
+    toXml(xml);
+    return xml;   // empty for an invalid value
+  }
+
+  void XmlRpcValue::toXml(std::string& xml) const
   {
     switch (_type) {
-      case TypeNil:      return nilToXml();
-      case TypeBoolean:  return boolToXml();
-      case TypeInt:      return intToXml();
-      case TypeDouble:   return doubleToXml();
-      case TypeString:   return stringToXml();
-      case TypeDateTime: return timeToXml();
-      case TypeBase64:   return binaryToXml();
-      case TypeArray:    return arrayToXml();
-      case TypeStruct:   return structToXml();
+      case TypeNil:      nilToXml(xml); break;
+      case TypeBoolean:  boolToXml(xml); break;
+      case TypeInt:      intToXml(xml); break;
+      case TypeDouble:   doubleToXml(xml); break;
+      case TypeString:   stringToXml(xml); break;
+      case TypeDateTime: timeToXml(xml); break;
+      case TypeBase64:   binaryToXml(xml); break;
+      case TypeArray:    arrayToXml(xml); break;
+      case TypeStruct:   structToXml(xml); break;
       default: break;
     }
-    return std::string();   // Invalid value
   }
 
 
@@ -381,16 +387,16 @@ namespace XmlRpc {
     return true;
   }
 
-  std::string XmlRpcValue::nilToXml() const
+  void XmlRpcValue::nilToXml(std::string& xml) const
   {
-    return "<value><nil/></value>";
+    xml.append("<value><nil/></value>");
   }
 
-  std::string XmlRpcValue::boolToXml() const
+  void XmlRpcValue::boolToXml(std::string& xml) const
   {
-    static std::string booleanTrueXml("<value><boolean>1</boolean></value>");
-    static std::string booleanFalseXml("<value><boolean>0</boolean></value>");
-    return _value.asBool ? booleanTrueXml : booleanFalseXml;
+    xml.append(_value.asBool ?
+               "<value><boolean>1</boolean></value>" :
+               "<value><boolean>0</boolean></value>");
   }
 
   // Int
@@ -408,13 +414,13 @@ namespace XmlRpc {
     return true;
   }
 
-  std::string XmlRpcValue::intToXml() const
+  void XmlRpcValue::intToXml(std::string& xml) const
   {
     char buf[256];
     snprintf(buf, sizeof(buf)-1, "<value><i4>%d</i4></value>", _value.asInt);
     buf[sizeof(buf)-1] = 0;
 
-    return std::string(buf);
+    xml.append(buf);
   }
 
   // Double
@@ -432,7 +438,7 @@ namespace XmlRpc {
     return true;
   }
 
-  std::string XmlRpcValue::doubleToXml() const
+  void XmlRpcValue::doubleToXml(std::string& xml) const
   {
     char fmtbuf[256], buf[256];
     snprintf(fmtbuf, sizeof(fmtbuf)-1, "<value><double>%s</double></value>", getDoubleFormat().c_str());
@@ -440,7 +446,7 @@ namespace XmlRpc {
     snprintf(buf, sizeof(buf)-1, fmtbuf, _value.asDouble);
     buf[sizeof(buf)-1] = 0;
 
-    return std::string(buf);
+    xml.append(buf);
   }
 
   // String
@@ -451,14 +457,17 @@ namespace XmlRpc {
       return false;     // No end tag;
 
     _type = TypeString;
-    _value.asString = new std::string(XmlRpcUtil::xmlDecode(valueXml.substr(*offset, valueEnd-*offset)));
-    *offset += int(_value.asString->length());
+    _value.asString = new std::string;
+    XmlRpcUtil::xmlDecode(valueXml, *offset, valueEnd-*offset, *_value.asString);
+    *offset = int(valueEnd);
     return true;
   }
 
-  std::string XmlRpcValue::stringToXml() const
+  void XmlRpcValue::stringToXml(std::string& xml) const
   {
-    return std::string("<value>") + XmlRpcUtil::xmlEncode(*_value.asString) + std::string("</value>");
+    xml.append("<value>");
+    XmlRpcUtil::xmlEncode(*_value.asString, xml);
+    xml.append("</value>");
   }
 
   // DateTime (stored as a struct tm)
@@ -482,7 +491,7 @@ namespace XmlRpc {
     return true;
   }
 
-  std::string XmlRpcValue::timeToXml() const
+  void XmlRpcValue::timeToXml(std::string& xml) const
   {
     struct tm* t = _value.asTime;
     char buf[50];
@@ -490,7 +499,7 @@ namespace XmlRpc {
     snprintf(buf, sizeof(buf)-1, "%04d%02d%02dT%02d:%02d:%02d", 
       1900+t->tm_year,1+t->tm_mon,t->tm_mday,t->tm_hour,t->tm_min,t->tm_sec);
 
-    return std::string("<value><dateTime.iso8601>") + buf + std::string("</dateTime.iso8601></value>");
+    xml.append("<value><dateTime.iso8601>").append(buf).append("</dateTime.iso8601></value>");
   }
 
 
@@ -517,7 +526,7 @@ namespace XmlRpc {
   }
 
 
-  std::string XmlRpcValue::binaryToXml() const
+  void XmlRpcValue::binaryToXml(std::string& xml) const
   {
     // convert to base64
     std::vector<char> base64data;
@@ -527,10 +536,9 @@ namespace XmlRpc {
     encoder.put(_value.asBinary->begin(), _value.asBinary->end(), ins, iostatus, xmlrpc_base64<>::crlf());
 
     // Wrap with xml
-    std::string xml = "<value><base64>";
+    xml += "<value><base64>";
     xml.append(base64data.begin(), base64data.end());
     xml += "</base64></value>";
-    return xml;
   }
 
 
@@ -546,9 +554,16 @@ namespace XmlRpc {
 
     if ( ! emptyTag)
     {
-      XmlRpcValue v;
-      while (v.fromXml(valueXml, offset))
-        _value.asArray->push_back(v);       // copy...
+      // decode each element in place rather than copying it in
+      for (;;)
+      {
+        _value.asArray->push_back(XmlRpcValue());
+        if ( ! _value.asArray->back().fromXml(valueXml, offset))
+        {
+          _value.asArray->pop_back();
+          break;
+        }
+      }
 
       // Skip the trailing </data>
       (void) XmlRpcUtil::nextTagIsEnd(DATA_TAG, valueXml, offset);
@@ -559,16 +574,15 @@ namespace XmlRpc {
 
   // In general, its preferable to generate the xml of each element of the
   // array as it is needed rather than glomming up one big string.
-  std::string XmlRpcValue::arrayToXml() const
+  void XmlRpcValue::arrayToXml(std::string& xml) const
   {
-    std::string xml = "<value><array><data>";
+    xml += "<value><array><data>";
 
     int s = int(_value.asArray->size());
     for (int i=0; i<s; ++i)
-       xml += _value.asArray->at(i).toXml();
+       _value.asArray->at(i).toXml(xml);
 
     xml += "</data></array></value>";
-    return xml;
   }
 
 
@@ -586,14 +600,15 @@ namespace XmlRpc {
       {
         if (XmlRpcUtil::parseTag(NAME_TAG, valueXml, offset, name))
         {
-          // value
-          XmlRpcValue val(valueXml, offset);
-          if ( ! val.valid()) {
+          // value, decoded in place; a duplicate name keeps the first
+          std::pair<ValueStruct::iterator, bool> p =
+            _value.asStruct->insert(std::make_pair(name, XmlRpcValue()));
+          XmlRpcValue val;
+          XmlRpcValue& dest = p.second ? p.first->second : val;
+          if ( ! dest.fromXml(valueXml, offset)) {
             invalidate();
             return false;
           }
-          const std::pair<const std::string, XmlRpcValue> p(name, val);
-          _value.asStruct->insert(p);
 
           (void) XmlRpcUtil::nextTagIsEnd(MEMBER_TAG, valueXml, offset);
         }
@@ -606,22 +621,21 @@ namespace XmlRpc {
 
   // In general, its preferable to generate the xml of each element
   // as it is needed rather than glomming up one big string.
-  std::string XmlRpcValue::structToXml() const
+  void XmlRpcValue::structToXml(std::string& xml) const
   {
-    std::string xml = "<value><struct>";
+    xml += "<value><struct>";
 
     ValueStruct::const_iterator it;
     for (it=_value.asStruct->begin(); it!=_value.asStruct->end(); ++it)
     {
       xml += "<member><name>";
-      xml += XmlRpcUtil::xmlEncode(it->first);
+      XmlRpcUtil::xmlEncode(it->first, xml);
       xml += "</name>";
-      xml += it->second.toXml();
+      it->second.toXml(xml);
       xml += "</member>";
     }
 
     xml += "</struct></value>";
-    return xml;
   }
 
 
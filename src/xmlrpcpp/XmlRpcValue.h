@@ -241,6 +241,10 @@ namespace XmlRpc {
     //! Encode the Value in xml
     std::string toXml() const;
 
+    //! Append the xml encoding of the Value to xml.  A buffer reused from
+    //! call to call stops allocating once it has grown to the response size.
+    void toXml(std::string& xml) const;
+
     //! Write the value (no xml encoding)
     std::ostream& write(std::ostream& os) const;
 
@@ -273,16 +277,16 @@ namespace XmlRpc {
     bool arrayFromXml(std::string const& valueXml, int* offset);
     bool structFromXml(std::string const& valueXml, int* offset);
 
-    // XML encoding
-    std::string nilToXml() const;
-    std::string boolToXml() const;
-    std::string intToXml() const;
-    std::string doubleToXml() const;
-    std::string stringToXml() const;
-    std::string timeToXml() const;
-    std::string binaryToXml() const;
-    std::string arrayToXml() const;
-    std::string structToXml() const;
+    // XML encoding, appended to xml
+    void nilToXml(std::string& xml) const;
+    void boolToXml(std::string& xml) const;
+    void intToXml(std::string& xml) const;
+    void doubleToXml(std::string& xml) const;
+    void stringToXml(std::string& xml) const;
+    void timeToXml(std::string& xml) const;
+    void binaryToXml(std::string& xml) const;
+    void arrayToXml(std::string& xml) const;
+    void structToXml(std::string& xml) const;
 
     // Format strings
     static std::string _doubleFormat;